@@ -52,6 +52,8 @@ ifeq ($(strip $(AUDIO_ENABLE)), yes)
             OPT_DEFS += -DAUDIO_DRIVER_DAC
         else ifeq ($(strip $(AUDIO_DRIVER)), dac_additive)
             OPT_DEFS += -DAUDIO_DRIVER_DAC
+        else ifeq ($(strip $(AUDIO_DRIVER)), dac_mixer)
+            OPT_DEFS += -DAUDIO_DRIVER_DAC
         ## stm32f2 and above have a usable DAC unit, f1 do not, and need to use pwm instead
         else ifeq ($(strip $(AUDIO_DRIVER)), pwm_software)
             OPT_DEFS += -DAUDIO_DRIVER_PWM
@@ -646,6 +648,10 @@ VALID_CUSTOM_MATRIX_TYPES:= yes lite no
 
 CUSTOM_MATRIX ?= no
 
+VALID_MATRIX_DRIVER_TYPES := gpio vendor
+
+MATRIX_DRIVER ?= gpio
+
 ifneq ($(strip $(CUSTOM_MATRIX)), yes)
     ifeq ($(filter $(CUSTOM_MATRIX),$(VALID_CUSTOM_MATRIX_TYPES)),)
         $(call CATASTROPHIC_ERROR,Invalid CUSTOM_MATRIX,CUSTOM_MATRIX="$(CUSTOM_MATRIX)" is not a valid custom matrix type)
@@ -658,6 +664,19 @@ ifneq ($(strip $(CUSTOM_MATRIX)), yes)
     ifneq ($(strip $(CUSTOM_MATRIX)), lite)
         # Include the standard or split matrix code if needed
         QUANTUM_SRC += $(QUANTUM_DIR)/matrix.c
+
+        ifeq ($(filter $(MATRIX_DRIVER),$(VALID_MATRIX_DRIVER_TYPES)),)
+            $(call CATASTROPHIC_ERROR,Invalid MATRIX_DRIVER,MATRIX_DRIVER="$(MATRIX_DRIVER)" is not a valid matrix driver)
+        endif
+
+        # Hardware assisted scanning provided by the platform
+        ifeq ($(strip $(MATRIX_DRIVER)), vendor)
+            ifneq ($(strip $(MCU_SERIES)), RP2040)
+                $(call CATASTROPHIC_ERROR,Invalid MATRIX_DRIVER,MATRIX_DRIVER="vendor" is only available on RP2040)
+            endif
+            OPT_DEFS += -DMATRIX_DRIVER_VENDOR
+            SRC += matrix_vendor.c
+        endif
     endif
 endif
 
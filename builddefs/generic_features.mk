@@ -28,6 +28,7 @@ GENERIC_FEATURES = \
     DYNAMIC_MACRO \
     GRAVE_ESC \
     HAPTIC \
+    KEY_JOURNAL \
     KEY_LOCK \
     KEY_OVERRIDE \
     LEADER \
@@ -40,6 +40,7 @@ OTHER_OPTION_NAMES = \
   AUTO_SHIFT_MODIFIERS \
   DYNAMIC_TAPPING_TERM_ENABLE \
   COMBO_ENABLE \
+  KEY_JOURNAL_ENABLE \
   KEY_LOCK_ENABLE \
   KEY_OVERRIDE_ENABLE \
   LEADER_ENABLE \
@@ -74,6 +75,7 @@ OTHER_OPTION_NAMES = \
   WATCHDOG_ENABLE \
   ERGOINU \
   NO_USB_STARTUP_CHECK \
+  USB_SOF_SYNC_ENABLE \
   DISABLE_PROMICRO_LEDs \
   MITOSIS_DATAGROK_BOTTOMSPACE \
   MITOSIS_DATAGROK_SLOWUART \
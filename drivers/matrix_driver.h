@@ -0,0 +1,21 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "gpio.h"
+
+/*
+ * Hardware assisted matrix scanning. The driver continuously drives the strobe
+ * lines (rows for COL2ROW, columns for ROW2COL) low one after another and
+ * samples the sense lines into a RAM snapshot in the background.
+ */
+
+// Initialises the hardware scanner, returns false if the pin configuration is not supported
+bool matrix_driver_init(const pin_t *strobe_pins, uint8_t strobe_count, const pin_t *sense_pins, uint8_t sense_count);
+
+// Copies the raw sense line levels of the latest completed scan, one word per strobe line. Strobe lines that have not
+// been sampled yet read as all sense lines high, i.e. released
+void matrix_driver_read(uint32_t sense_states[]);
@@ -0,0 +1,391 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "color.h"
+#include "qp_palette_surface.h"
+#include "qp_draw.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Common
+
+// Device definition
+typedef struct palette_surface_painter_device_t {
+    painter_driver_t base; // must be first, so it can be cast to/from the painter_device_t* type
+
+    // The target buffer, holding packed palette indices, LSb first pixel
+    uint8_t *buffer;
+
+    // The colors of the palette, `1 << native_bits_per_pixel` entries
+    const HSV *palette;
+
+    // Whether colors are thresholded on their value instead of mapped to the nearest palette entry
+    bool is_mono;
+
+    // Manually manage the viewport for streaming pixel data to the display
+    uint16_t viewport_l;
+    uint16_t viewport_t;
+    uint16_t viewport_r;
+    uint16_t viewport_b;
+
+    // Current write location to the display when streaming pixel data
+    uint16_t pixdata_x;
+    uint16_t pixdata_y;
+
+    // Maintain a dirty region so we can stream only what we need
+    bool     is_dirty;
+    uint16_t dirty_l;
+    uint16_t dirty_t;
+    uint16_t dirty_r;
+    uint16_t dirty_b;
+
+} palette_surface_painter_device_t;
+
+// Driver storage
+static palette_surface_painter_device_t palette_surface_drivers[PALETTE_SURFACE_NUM_DEVICES] = {0};
+
+// Palette used by mono surfaces
+static const HSV mono_surface_palette[2] = {{0, 0, 0}, {0, 0, 255}};
+
+#if QUANTUM_PAINTER_SUPPORTS_256_PALETTE
+#    define PALETTE_SURFACE_MAX_BPP 8
+#else
+#    define PALETTE_SURFACE_MAX_BPP 4
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Helpers
+
+static inline uint8_t get_packed_index(const uint8_t *buffer, uint32_t index, uint8_t bpp) {
+    uint32_t bit = index * bpp;
+    return (buffer[bit / 8] >> (bit % 8)) & ((1u << bpp) - 1);
+}
+
+static inline void set_packed_index(uint8_t *buffer, uint32_t index, uint8_t bpp, uint8_t value) {
+    uint32_t bit  = index * bpp;
+    uint8_t  mask = ((1u << bpp) - 1) << (bit % 8);
+    buffer[bit / 8] = (buffer[bit / 8] & ~mask) | ((value << (bit % 8)) & mask);
+}
+
+static inline void increment_pixdata_location(palette_surface_painter_device_t *surface) {
+    // Increment the X-position
+    surface->pixdata_x++;
+
+    // If the x-coord has gone past the right-side edge, loop it back around and increment the y-coord
+    if (surface->pixdata_x > surface->viewport_r) {
+        surface->pixdata_x = surface->viewport_l;
+        surface->pixdata_y++;
+    }
+
+    // If the y-coord has gone past the bottom, loop it back to the top
+    if (surface->pixdata_y > surface->viewport_b) {
+        surface->pixdata_y = surface->viewport_t;
+    }
+}
+
+static inline uint8_t getpixel(palette_surface_painter_device_t *surface, uint16_t x, uint16_t y) {
+    return get_packed_index(surface->buffer, (uint32_t)y * surface->base.panel_width + x, surface->base.native_bits_per_pixel);
+}
+
+static inline void setpixel(palette_surface_painter_device_t *surface, uint16_t x, uint16_t y, uint8_t palette_idx) {
+    // Skip messing with the dirty info if the original value already matches
+    if (getpixel(surface, x, y) != palette_idx) {
+        // Maintain dirty region
+        if (surface->dirty_l > x) {
+            surface->dirty_l = x;
+        }
+        if (surface->dirty_r < x) {
+            surface->dirty_r = x;
+        }
+        if (surface->dirty_t > y) {
+            surface->dirty_t = y;
+        }
+        if (surface->dirty_b < y) {
+            surface->dirty_b = y;
+        }
+
+        // Always dirty after a setpixel
+        surface->is_dirty = true;
+
+        // Update the pixel data in the buffer
+        set_packed_index(surface->buffer, (uint32_t)y * surface->base.panel_width + x, surface->base.native_bits_per_pixel, palette_idx);
+    }
+}
+
+static inline void stream_pixdata(palette_surface_painter_device_t *surface, const uint8_t *data, uint32_t native_pixel_count) {
+    uint8_t bpp = surface->base.native_bits_per_pixel;
+    for (uint32_t pixel_counter = 0; pixel_counter < native_pixel_count; ++pixel_counter) {
+        setpixel(surface, surface->pixdata_x, surface->pixdata_y, get_packed_index(data, pixel_counter, bpp));
+        increment_pixdata_location(surface);
+    }
+}
+
+// Finds the palette entry closest to the supplied color
+static uint8_t nearest_palette_index(palette_surface_painter_device_t *surface, HSV hsv) {
+    uint16_t palette_size = 1u << surface->base.native_bits_per_pixel;
+
+    // Colors taken from the palette itself are by far the most common, so look for an exact match first
+    for (uint16_t i = 0; i < palette_size; ++i) {
+        if (surface->palette[i].h == hsv.h && surface->palette[i].s == hsv.s && surface->palette[i].v == hsv.v) {
+            return i;
+        }
+    }
+
+    RGB      rgb           = hsv_to_rgb_nocie(hsv);
+    uint8_t  best_index    = 0;
+    uint32_t best_distance = UINT32_MAX;
+    for (uint16_t i = 0; i < palette_size; ++i) {
+        RGB      entry    = hsv_to_rgb_nocie(surface->palette[i]);
+        int32_t  dr       = (int32_t)entry.r - rgb.r;
+        int32_t  dg       = (int32_t)entry.g - rgb.g;
+        int32_t  db       = (int32_t)entry.b - rgb.b;
+        uint32_t distance = dr * dr + dg * dg + db * db;
+        if (distance < best_distance) {
+            best_distance = distance;
+            best_index    = i;
+        }
+    }
+    return best_index;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Driver vtable
+
+static bool qp_palette_surface_init(painter_device_t device, painter_rotation_t rotation) {
+    painter_driver_t *                driver  = (painter_driver_t *)device;
+    palette_surface_painter_device_t *surface = (palette_surface_painter_device_t *)driver;
+    memset(surface->buffer, 0, PALETTE_SURFACE_BUFFER_SIZE(driver->panel_width, driver->panel_height, driver->native_bits_per_pixel));
+
+    // The whole surface needs to be sent on the next draw
+    surface->dirty_l  = 0;
+    surface->dirty_t  = 0;
+    surface->dirty_r  = driver->panel_width - 1;
+    surface->dirty_b  = driver->panel_height - 1;
+    surface->is_dirty = true;
+    return true;
+}
+
+static bool qp_palette_surface_power(painter_device_t device, bool power_on) {
+    // No-op.
+    return true;
+}
+
+static bool qp_palette_surface_clear(painter_device_t device) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    driver->driver_vtable->init(device, driver->rotation); // Re-init the surface
+    return true;
+}
+
+static bool qp_palette_surface_flush(painter_device_t device) {
+    painter_driver_t *                driver  = (painter_driver_t *)device;
+    palette_surface_painter_device_t *surface = (palette_surface_painter_device_t *)driver;
+    surface->dirty_l = surface->dirty_t = UINT16_MAX;
+    surface->dirty_r = surface->dirty_b = 0;
+    surface->is_dirty                   = false;
+    return true;
+}
+
+static bool qp_palette_surface_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    painter_driver_t *                driver  = (painter_driver_t *)device;
+    palette_surface_painter_device_t *surface = (palette_surface_painter_device_t *)driver;
+
+    // Set the viewport locations
+    surface->viewport_l = left;
+    surface->viewport_t = top;
+    surface->viewport_r = right;
+    surface->viewport_b = bottom;
+
+    // Reset the write location to the top left
+    surface->pixdata_x = left;
+    surface->pixdata_y = top;
+    return true;
+}
+
+// Stream pixel data to the current write position in the buffer
+static bool qp_palette_surface_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+    painter_driver_t *                driver  = (painter_driver_t *)device;
+    palette_surface_painter_device_t *surface = (palette_surface_painter_device_t *)driver;
+    stream_pixdata(surface, (const uint8_t *)pixel_data, native_pixel_count);
+    return true;
+}
+
+// Pixel colour conversion, the native pixel of a surface is the index of the palette entry
+static bool qp_palette_surface_palette_convert(painter_device_t device, int16_t palette_size, qp_pixel_t *palette) {
+    painter_driver_t *                driver  = (painter_driver_t *)device;
+    palette_surface_painter_device_t *surface = (palette_surface_painter_device_t *)driver;
+    for (int16_t i = 0; i < palette_size; ++i) {
+        HSV hsv = {palette[i].hsv888.h, palette[i].hsv888.s, palette[i].hsv888.v};
+        if (surface->is_mono) {
+            palette[i].palette_idx = (hsv.v >= 128) ? 1 : 0;
+        } else {
+            palette[i].palette_idx = nearest_palette_index(surface, hsv);
+        }
+    }
+    return true;
+}
+
+// Append pixels to the target location, keyed by the pixel index
+static bool qp_palette_surface_append_pixels(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t *palette_indices) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    for (uint32_t i = 0; i < pixel_count; ++i) {
+        set_packed_index(target_buffer, pixel_offset + i, driver->native_bits_per_pixel, palette[palette_indices[i]].palette_idx);
+    }
+    return true;
+}
+
+// Append data to the target location
+static bool qp_palette_surface_append_pixdata(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte) {
+    target_buffer[pixdata_offset] = pixdata_byte;
+    return true;
+}
+
+const painter_driver_vtable_t palette_surface_driver_vtable = {
+    .init            = qp_palette_surface_init,
+    .power           = qp_palette_surface_power,
+    .clear           = qp_palette_surface_clear,
+    .flush           = qp_palette_surface_flush,
+    .pixdata         = qp_palette_surface_pixdata,
+    .viewport        = qp_palette_surface_viewport,
+    .palette_convert = qp_palette_surface_palette_convert,
+    .append_pixels   = qp_palette_surface_append_pixels,
+    .append_pixdata  = qp_palette_surface_append_pixdata,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Comms vtable
+
+static bool qp_palette_surface_comms_init(painter_device_t device) {
+    // No-op.
+    return true;
+}
+static bool qp_palette_surface_comms_start(painter_device_t device) {
+    // No-op.
+    return true;
+}
+static void qp_palette_surface_comms_stop(painter_device_t device) {
+    // No-op.
+}
+static uint32_t qp_palette_surface_comms_send(painter_device_t device, const void *data, uint32_t byte_count) {
+    // No-op.
+    return byte_count;
+}
+
+painter_comms_vtable_t palette_surface_driver_comms_vtable = {
+    // These are all effective no-op's because they're not actually needed.
+    .comms_init  = qp_palette_surface_comms_init,
+    .comms_start = qp_palette_surface_comms_start,
+    .comms_stop  = qp_palette_surface_comms_stop,
+    .comms_send  = qp_palette_surface_comms_send};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Factory functions for creating a handle to a palette surface
+
+static painter_device_t make_surface(uint16_t panel_width, uint16_t panel_height, uint8_t bpp, const HSV *palette, bool is_mono, void *buffer) {
+    if ((bpp != 1 && bpp != 2 && bpp != 4 && bpp != 8) || bpp > PALETTE_SURFACE_MAX_BPP || !palette || !buffer) {
+        qp_dprintf("qp_palette_make_surface: fail (unsupported bpp %d or missing palette/buffer)\n", (int)bpp);
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < PALETTE_SURFACE_NUM_DEVICES; ++i) {
+        palette_surface_painter_device_t *driver = &palette_surface_drivers[i];
+        if (!driver->base.driver_vtable) {
+            driver->base.driver_vtable         = &palette_surface_driver_vtable;
+            driver->base.comms_vtable          = &palette_surface_driver_comms_vtable;
+            driver->base.native_bits_per_pixel = bpp;
+            driver->base.panel_width           = panel_width;
+            driver->base.panel_height          = panel_height;
+            driver->base.rotation              = QP_ROTATION_0;
+            driver->base.offset_x              = 0;
+            driver->base.offset_y              = 0;
+            driver->buffer                     = (uint8_t *)buffer;
+            driver->palette                    = palette;
+            driver->is_mono                    = is_mono;
+            return (painter_device_t)driver;
+        }
+    }
+    return NULL;
+}
+
+painter_device_t qp_palette_make_surface(uint16_t panel_width, uint16_t panel_height, uint8_t bpp, const HSV *palette, void *buffer) {
+    return make_surface(panel_width, panel_height, bpp, palette, false, buffer);
+}
+
+painter_device_t qp_mono_make_surface(uint16_t panel_width, uint16_t panel_height, void *buffer) {
+    return make_surface(panel_width, panel_height, 1, mono_surface_palette, true, buffer);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Drawing routine to copy out the dirty region and send it to another device
+
+bool qp_palette_surface_draw(painter_device_t surface, painter_device_t display, uint16_t x, uint16_t y) {
+    painter_driver_t *                surface_driver = (painter_driver_t *)surface;
+    palette_surface_painter_device_t *surface_handle = (palette_surface_painter_device_t *)surface_driver;
+    painter_driver_t *                display_driver = (painter_driver_t *)display;
+
+    // If we're not dirty... we're done.
+    if (!surface_handle->is_dirty) {
+        return true;
+    }
+
+    // Convert the surface's palette to the display's native pixel format, once for the whole transfer. The global lookup
+    // table is reused for this, so it no longer holds a generated palette afterwards.
+    uint16_t palette_size = 1u << surface_driver->native_bits_per_pixel;
+    for (uint16_t i = 0; i < palette_size; ++i) {
+        qp_internal_global_pixel_lookup_table[i].hsv888.h = surface_handle->palette[i].h;
+        qp_internal_global_pixel_lookup_table[i].hsv888.s = surface_handle->palette[i].s;
+        qp_internal_global_pixel_lookup_table[i].hsv888.v = surface_handle->palette[i].v;
+    }
+    qp_internal_invalidate_palette();
+    if (!display_driver->driver_vtable->palette_convert(display, palette_size, qp_internal_global_pixel_lookup_table)) {
+        return false;
+    }
+
+    // Set the target drawing area
+    bool ok = qp_viewport(display, x + surface_handle->dirty_l, y + surface_handle->dirty_t, x + surface_handle->dirty_r, y + surface_handle->dirty_b);
+    if (!ok) {
+        return false;
+    }
+
+    // Housekeeping of the amount of pixels to transfer, palette indices are gathered in small batches before conversion
+    uint32_t total_pixel_count = qp_internal_num_pixels_in_buffer(display);
+    uint32_t pixel_counter     = 0;
+    uint8_t  palette_indices[32];
+    uint8_t  index_counter = 0;
+
+    // Fill the global pixdata area so that we can start transferring to the panel
+    for (uint16_t y = surface_handle->dirty_t; y <= surface_handle->dirty_b; ++y) {
+        for (uint16_t x = surface_handle->dirty_l; x <= surface_handle->dirty_r; ++x) {
+            palette_indices[index_counter++] = getpixel(surface_handle, x, y);
+
+            // Convert the batch into the target buffer once it's full, or once it fills the target buffer
+            if (index_counter == sizeof(palette_indices) || pixel_counter + index_counter == total_pixel_count) {
+                display_driver->driver_vtable->append_pixels(display, qp_internal_global_pixdata_buffer, qp_internal_global_pixel_lookup_table, pixel_counter, index_counter, palette_indices);
+                pixel_counter += index_counter;
+                index_counter = 0;
+            }
+
+            // If we've accumulated enough data, send it
+            if (pixel_counter == total_pixel_count) {
+                ok = qp_pixdata(display, qp_internal_global_pixdata_buffer, pixel_counter);
+                if (!ok) {
+                    return false;
+                }
+                // Reset the counter
+                pixel_counter = 0;
+            }
+        }
+    }
+
+    // If there's any leftover data, send it
+    if (index_counter > 0) {
+        display_driver->driver_vtable->append_pixels(display, qp_internal_global_pixdata_buffer, qp_internal_global_pixel_lookup_table, pixel_counter, index_counter, palette_indices);
+        pixel_counter += index_counter;
+    }
+    if (pixel_counter > 0) {
+        ok = qp_pixdata(display, qp_internal_global_pixdata_buffer, pixel_counter);
+        if (!ok) {
+            return false;
+        }
+    }
+
+    // Clear the dirty info for the surface
+    return qp_flush(surface);
+}
@@ -0,0 +1,69 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "color.h"
+#include "qp_internal.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter palette surface configurables (add to your keyboard's config.h)
+
+#ifndef PALETTE_SURFACE_NUM_DEVICES
+/**
+ * @def This controls the maximum number of palette and mono surface devices that Quantum Painter can use at any one time.
+ *      Increasing this number allows for multiple framebuffers to be used. Each requires its own RAM allocation.
+ */
+#    define PALETTE_SURFACE_NUM_DEVICES 1
+#endif
+
+/**
+ * @def The size in bytes of the buffer needed to hold the contents of a surface with the given bits per pixel.
+ */
+#define PALETTE_SURFACE_BUFFER_SIZE(panel_width, panel_height, bpp) ((((uint32_t)(panel_width)) * (panel_height) * (bpp) + 7) / 8)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Forward declarations
+
+#ifdef QUANTUM_PAINTER_PALETTE_SURFACE_ENABLE
+/**
+ * Factory method for a palette surface (aka framebuffer), which stores an index into a fixed palette for each pixel.
+ *
+ * Colors drawn to the surface are mapped to the nearest palette entry. They are only converted to the target display's
+ * native pixel format when the surface is drawn to it.
+ *
+ * @param panel_width[in] the width of the display panel
+ * @param panel_height[in] the height of the display panel
+ * @param bpp[in] the number of bits per pixel, one of 1, 2, 4 or 8 (8 requires QUANTUM_PAINTER_SUPPORTS_256_PALETTE)
+ * @param palette[in] the `1 << bpp` colors of the palette, which must remain valid for the lifetime of the surface
+ * @param buffer[in] pointer to a preallocated buffer of size `PALETTE_SURFACE_BUFFER_SIZE(panel_width, panel_height, bpp)`
+ * @return the device handle used with all drawing routines in Quantum Painter
+ */
+painter_device_t qp_palette_make_surface(uint16_t panel_width, uint16_t panel_height, uint8_t bpp, const HSV *palette, void *buffer);
+
+/**
+ * Factory method for a mono surface (aka framebuffer), a 1bpp black and white palette surface.
+ *
+ * Colors drawn to the surface are white if their value is at least 128, and black otherwise -- matching mono displays.
+ *
+ * @param panel_width[in] the width of the display panel
+ * @param panel_height[in] the height of the display panel
+ * @param buffer[in] pointer to a preallocated buffer of size `PALETTE_SURFACE_BUFFER_SIZE(panel_width, panel_height, 1)`
+ * @return the device handle used with all drawing routines in Quantum Painter
+ */
+painter_device_t qp_mono_make_surface(uint16_t panel_width, uint16_t panel_height, void *buffer);
+
+/**
+ * Helper method to draw the dirty contents of the framebuffer to the target device.
+ *
+ * The surface's palette is converted to the display's native pixel format once, then the dirty area is streamed out.
+ * After successful completion, the dirty area is reset.
+ *
+ * @param surface[in] the surface to copy from
+ * @param display[in] the display to copy into
+ * @param x[in] the x-location of the original position of the framebuffer
+ * @param y[in] the y-location of the original position of the framebuffer
+ * @return whether the draw operation completed successfully
+ */
+bool qp_palette_surface_draw(painter_device_t surface, painter_device_t display, uint16_t x, uint16_t y);
+#endif // QUANTUM_PAINTER_PALETTE_SURFACE_ENABLE
@@ -0,0 +1,389 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdio.h>
+
+#include "qp_virtual_display.h"
+#include "qp_comms.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Common
+
+// Command set mimicking the memory access commands of the usual MIPI DCS panels
+#define VIRTUAL_DISPLAY_CMD_SET_COLUMN_ADDR 0x2A
+#define VIRTUAL_DISPLAY_CMD_SET_ROW_ADDR 0x2B
+#define VIRTUAL_DISPLAY_CMD_WRITE_MEMORY 0x2C
+
+// Device definition
+typedef struct virtual_display_painter_device_t {
+    painter_driver_t base; // must be first, so it can be cast to/from the painter_device_t* type
+
+    qp_virtual_display_format_t format;
+
+    // The panel contents
+    RGB *buffer;
+
+    // Current viewport, in rotated coordinates
+    uint16_t viewport_l;
+    uint16_t viewport_t;
+    uint16_t viewport_r;
+    uint16_t viewport_b;
+
+    // Current write location when streaming pixel data
+    uint16_t pixdata_x;
+    uint16_t pixdata_y;
+
+    qp_virtual_display_stats_t stats;
+} virtual_display_painter_device_t;
+
+// Driver storage
+static virtual_display_painter_device_t virtual_display_drivers[VIRTUAL_DISPLAY_NUM_DEVICES] = {0};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Helpers
+
+static virtual_display_painter_device_t *get_virtual_display(painter_device_t device) {
+    for (uint32_t i = 0; i < VIRTUAL_DISPLAY_NUM_DEVICES; ++i) {
+        if (device == (painter_device_t)&virtual_display_drivers[i]) {
+            return &virtual_display_drivers[i];
+        }
+    }
+    return NULL;
+}
+
+static void setpixel(virtual_display_painter_device_t *display, uint16_t x, uint16_t y, RGB rgb) {
+    painter_driver_t *driver = &display->base;
+
+    // Map the rotated coordinates back onto the panel, as the panel's own scan direction settings would
+    uint16_t px, py;
+    switch (driver->rotation) {
+        default:
+        case QP_ROTATION_0:
+            px = x;
+            py = y;
+            break;
+        case QP_ROTATION_90:
+            px = driver->panel_width - 1 - y;
+            py = x;
+            break;
+        case QP_ROTATION_180:
+            px = driver->panel_width - 1 - x;
+            py = driver->panel_height - 1 - y;
+            break;
+        case QP_ROTATION_270:
+            px = y;
+            py = driver->panel_height - 1 - x;
+            break;
+    }
+
+    // Like real panels, anything outside the panel is silently dropped
+    if (px < driver->panel_width && py < driver->panel_height) {
+        display->buffer[py * driver->panel_width + px] = rgb;
+    }
+}
+
+static void append_pixel(virtual_display_painter_device_t *display, RGB rgb) {
+    setpixel(display, display->pixdata_x, display->pixdata_y, rgb);
+
+    // Advance the write location, wrapping within the viewport
+    if (++display->pixdata_x > display->viewport_r) {
+        display->pixdata_x = display->viewport_l;
+        if (++display->pixdata_y > display->viewport_b) {
+            display->pixdata_y = display->viewport_t;
+        }
+    }
+}
+
+static RGB decode_pixel(virtual_display_painter_device_t *display, const uint8_t *data, uint32_t index) {
+    switch (display->format) {
+        default:
+        case QP_VIRTUAL_DISPLAY_RGB565: {
+            uint16_t rgb565 = ((uint16_t)data[index * 2] << 8) | data[index * 2 + 1];
+            uint8_t  r      = (rgb565 >> 11) & 0x1F;
+            uint8_t  g      = (rgb565 >> 5) & 0x3F;
+            uint8_t  b      = rgb565 & 0x1F;
+            return (RGB){.r = (r << 3) | (r >> 2), .g = (g << 2) | (g >> 4), .b = (b << 3) | (b >> 2)};
+        }
+        case QP_VIRTUAL_DISPLAY_RGB888:
+            return (RGB){.r = data[index * 3], .g = data[index * 3 + 1], .b = data[index * 3 + 2]};
+        case QP_VIRTUAL_DISPLAY_MONO: {
+            uint8_t v = (data[index / 8] & (1 << (index % 8))) ? 255 : 0;
+            return (RGB){.r = v, .g = v, .b = v};
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Driver vtable
+
+static bool qp_virtual_display_init(painter_device_t device, painter_rotation_t rotation) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    memset(((virtual_display_painter_device_t *)driver)->buffer, 0, VIRTUAL_DISPLAY_BUFFER_SIZE(driver->panel_width, driver->panel_height));
+    return true;
+}
+
+static bool qp_virtual_display_power(painter_device_t device, bool power_on) {
+    // No-op.
+    return true;
+}
+
+static bool qp_virtual_display_clear(painter_device_t device) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    driver->driver_vtable->init(device, driver->rotation); // Re-init the panel
+    return true;
+}
+
+static bool qp_virtual_display_flush(painter_device_t device) {
+    virtual_display_painter_device_t *display = (virtual_display_painter_device_t *)device;
+    display->stats.flushes++;
+    return true;
+}
+
+static bool qp_virtual_display_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    painter_driver_t *                driver  = (painter_driver_t *)device;
+    virtual_display_painter_device_t *display = (virtual_display_painter_device_t *)driver;
+
+    // Fix up the drawing location if required
+    left += driver->offset_x;
+    right += driver->offset_x;
+    top += driver->offset_y;
+    bottom += driver->offset_y;
+
+    // Send the same traffic a panel would need to set its drawing area
+    uint8_t xbuf[4] = {left >> 8, left & 0xFF, right >> 8, right & 0xFF};
+    uint8_t ybuf[4] = {top >> 8, top & 0xFF, bottom >> 8, bottom & 0xFF};
+    qp_comms_command_databuf(device, VIRTUAL_DISPLAY_CMD_SET_COLUMN_ADDR, xbuf, sizeof(xbuf));
+    qp_comms_command_databuf(device, VIRTUAL_DISPLAY_CMD_SET_ROW_ADDR, ybuf, sizeof(ybuf));
+    qp_comms_command(device, VIRTUAL_DISPLAY_CMD_WRITE_MEMORY);
+
+    display->viewport_l = display->pixdata_x = left;
+    display->viewport_t = display->pixdata_y = top;
+    display->viewport_r                      = right;
+    display->viewport_b                      = bottom;
+    display->stats.viewports++;
+    return true;
+}
+
+// Stream pixel data to the current write position in the panel
+static bool qp_virtual_display_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+    painter_driver_t *                driver  = (painter_driver_t *)device;
+    virtual_display_painter_device_t *display = (virtual_display_painter_device_t *)driver;
+
+    qp_comms_send(device, pixel_data, (native_pixel_count * driver->native_bits_per_pixel + 7) / 8);
+    for (uint32_t i = 0; i < native_pixel_count; ++i) {
+        append_pixel(display, decode_pixel(display, (const uint8_t *)pixel_data, i));
+    }
+
+    display->stats.pixdata_calls++;
+    display->stats.pixels += native_pixel_count;
+    return true;
+}
+
+// Pixel colour conversion
+static bool qp_virtual_display_palette_convert(painter_device_t device, int16_t palette_size, qp_pixel_t *palette) {
+    virtual_display_painter_device_t *display = (virtual_display_painter_device_t *)device;
+    display->stats.conversions += palette_size;
+    for (int16_t i = 0; i < palette_size; ++i) {
+        RGB rgb = hsv_to_rgb_nocie((HSV){palette[i].hsv888.h, palette[i].hsv888.s, palette[i].hsv888.v});
+        switch (display->format) {
+            default:
+            case QP_VIRTUAL_DISPLAY_RGB565: {
+                uint16_t rgb565   = (((uint16_t)rgb.r) >> 3) << 11 | (((uint16_t)rgb.g) >> 2) << 5 | (((uint16_t)rgb.b) >> 3);
+                palette[i].rgb565 = __builtin_bswap16(rgb565);
+                break;
+            }
+            case QP_VIRTUAL_DISPLAY_RGB888:
+                palette[i].rgb888.r = rgb.r;
+                palette[i].rgb888.g = rgb.g;
+                palette[i].rgb888.b = rgb.b;
+                break;
+            case QP_VIRTUAL_DISPLAY_MONO:
+                palette[i].mono = (palette[i].hsv888.v >= 128) ? 1 : 0;
+                break;
+        }
+    }
+    return true;
+}
+
+// Append pixels to the target location, keyed by the pixel index
+static bool qp_virtual_display_append_pixels(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t *palette_indices) {
+    virtual_display_painter_device_t *display = (virtual_display_painter_device_t *)device;
+    for (uint32_t i = 0; i < pixel_count; ++i) {
+        uint32_t   index = pixel_offset + i;
+        qp_pixel_t pixel = palette[palette_indices[i]];
+        switch (display->format) {
+            default:
+            case QP_VIRTUAL_DISPLAY_RGB565:
+                ((uint16_t *)target_buffer)[index] = pixel.rgb565;
+                break;
+            case QP_VIRTUAL_DISPLAY_RGB888:
+                target_buffer[index * 3 + 0] = pixel.rgb888.r;
+                target_buffer[index * 3 + 1] = pixel.rgb888.g;
+                target_buffer[index * 3 + 2] = pixel.rgb888.b;
+                break;
+            case QP_VIRTUAL_DISPLAY_MONO:
+                if (pixel.mono) {
+                    target_buffer[index / 8] |= (1 << (index % 8));
+                } else {
+                    target_buffer[index / 8] &= ~(1 << (index % 8));
+                }
+                break;
+        }
+    }
+    return true;
+}
+
+// Append data to the target location
+static bool qp_virtual_display_append_pixdata(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte) {
+    target_buffer[pixdata_offset] = pixdata_byte;
+    return true;
+}
+
+const painter_driver_vtable_t virtual_display_driver_vtable = {
+    .init            = qp_virtual_display_init,
+    .power           = qp_virtual_display_power,
+    .clear           = qp_virtual_display_clear,
+    .flush           = qp_virtual_display_flush,
+    .pixdata         = qp_virtual_display_pixdata,
+    .viewport        = qp_virtual_display_viewport,
+    .palette_convert = qp_virtual_display_palette_convert,
+    .append_pixels   = qp_virtual_display_append_pixels,
+    .append_pixdata  = qp_virtual_display_append_pixdata,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Comms vtable
+
+static bool qp_virtual_display_comms_init(painter_device_t device) {
+    // No-op.
+    return true;
+}
+
+static bool qp_virtual_display_comms_start(painter_device_t device) {
+    // No-op.
+    return true;
+}
+
+static void qp_virtual_display_comms_stop(painter_device_t device) {
+    // No-op.
+}
+
+static uint32_t qp_virtual_display_comms_send(painter_device_t device, const void *data, uint32_t byte_count) {
+    virtual_display_painter_device_t *display = (virtual_display_painter_device_t *)device;
+    display->stats.comms_bytes += byte_count;
+    return byte_count;
+}
+
+static void qp_virtual_display_comms_send_command(painter_device_t device, uint8_t cmd) {
+    virtual_display_painter_device_t *display = (virtual_display_painter_device_t *)device;
+    display->stats.commands++;
+    display->stats.comms_bytes++;
+}
+
+static void qp_virtual_display_comms_bulk_command_sequence(painter_device_t device, const uint8_t *sequence, size_t sequence_len) {
+    // Same layout as the SPI D/C comms: command, delay, argument count, arguments
+    for (size_t i = 0; i < sequence_len;) {
+        uint8_t command   = sequence[i];
+        uint8_t num_bytes = sequence[i + 2];
+        qp_virtual_display_comms_send_command(device, command);
+        if (num_bytes > 0) {
+            qp_virtual_display_comms_send(device, &sequence[i + 3], num_bytes);
+        }
+        i += (3 + num_bytes);
+    }
+}
+
+const painter_comms_with_command_vtable_t virtual_display_comms_vtable = {
+    .base =
+        {
+            .comms_init  = qp_virtual_display_comms_init,
+            .comms_start = qp_virtual_display_comms_start,
+            .comms_stop  = qp_virtual_display_comms_stop,
+            .comms_send  = qp_virtual_display_comms_send,
+        },
+    .send_command          = qp_virtual_display_comms_send_command,
+    .bulk_command_sequence = qp_virtual_display_comms_bulk_command_sequence,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Factory function for creating a handle to a virtual display
+
+painter_device_t qp_virtual_display_make_device(uint16_t panel_width, uint16_t panel_height, qp_virtual_display_format_t format, void *buffer) {
+    for (uint32_t i = 0; i < VIRTUAL_DISPLAY_NUM_DEVICES; ++i) {
+        virtual_display_painter_device_t *driver = &virtual_display_drivers[i];
+        if (!driver->base.driver_vtable) {
+            driver->base.driver_vtable = &virtual_display_driver_vtable;
+            driver->base.comms_vtable  = (const painter_comms_vtable_t *)&virtual_display_comms_vtable;
+            switch (format) {
+                default:
+                case QP_VIRTUAL_DISPLAY_RGB565:
+                    driver->base.native_bits_per_pixel = 16;
+                    break;
+                case QP_VIRTUAL_DISPLAY_RGB888:
+                    driver->base.native_bits_per_pixel = 24;
+                    break;
+                case QP_VIRTUAL_DISPLAY_MONO:
+                    driver->base.native_bits_per_pixel = 1;
+                    break;
+            }
+            driver->base.panel_width  = panel_width;
+            driver->base.panel_height = panel_height;
+            driver->base.rotation     = QP_ROTATION_0;
+            driver->base.offset_x     = 0;
+            driver->base.offset_y     = 0;
+            driver->format            = format;
+            driver->buffer            = (RGB *)buffer;
+            memset(&driver->stats, 0, sizeof(driver->stats));
+            return (painter_device_t)driver;
+        }
+    }
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Inspection of the virtual display
+
+bool qp_virtual_display_get_stats(painter_device_t device, qp_virtual_display_stats_t *stats) {
+    virtual_display_painter_device_t *display = get_virtual_display(device);
+    if (!display) {
+        return false;
+    }
+    *stats = display->stats;
+    return true;
+}
+
+void qp_virtual_display_reset_stats(painter_device_t device) {
+    virtual_display_painter_device_t *display = get_virtual_display(device);
+    if (display) {
+        memset(&display->stats, 0, sizeof(display->stats));
+    }
+}
+
+RGB qp_virtual_display_get_pixel(painter_device_t device, uint16_t x, uint16_t y) {
+    virtual_display_painter_device_t *display = get_virtual_display(device);
+    if (!display || x >= display->base.panel_width || y >= display->base.panel_height) {
+        return (RGB){0};
+    }
+    return display->buffer[y * display->base.panel_width + x];
+}
+
+bool qp_virtual_display_save_ppm(painter_device_t device, const char *filename) {
+    virtual_display_painter_device_t *display = get_virtual_display(device);
+    if (!display) {
+        return false;
+    }
+
+    FILE *f = fopen(filename, "wb");
+    if (!f) {
+        return false;
+    }
+
+    bool     ok     = fprintf(f, "P6\n%u %u\n255\n", (unsigned)display->base.panel_width, (unsigned)display->base.panel_height) > 0;
+    uint32_t pixels = (uint32_t)display->base.panel_width * display->base.panel_height;
+    for (uint32_t i = 0; ok && i < pixels; ++i) {
+        // The member order of RGB follows WS2812_BYTE_ORDER, so write the components out explicitly
+        uint8_t rgb[3] = {display->buffer[i].r, display->buffer[i].g, display->buffer[i].b};
+        ok             = fwrite(rgb, sizeof(rgb), 1, f) == 1;
+    }
+    return (fclose(f) == 0) && ok;
+}
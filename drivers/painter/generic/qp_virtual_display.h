@@ -0,0 +1,94 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "color.h"
+#include "qp_internal.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter virtual display configurables (add to your keyboard's config.h)
+
+#ifndef VIRTUAL_DISPLAY_NUM_DEVICES
+/**
+ * @def This controls the maximum number of virtual displays that Quantum Painter can use at any one time.
+ */
+#    define VIRTUAL_DISPLAY_NUM_DEVICES 1
+#endif
+
+/**
+ * @def The size in bytes of the buffer needed to hold the contents of a virtual display, regardless of its native format.
+ */
+#define VIRTUAL_DISPLAY_BUFFER_SIZE(panel_width, panel_height) ((panel_width) * (panel_height) * sizeof(RGB))
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter virtual display types
+
+// The native pixel format the virtual display pretends to be driven with
+typedef enum qp_virtual_display_format_t {
+    QP_VIRTUAL_DISPLAY_RGB565, // 16bpp, big-endian like an SPI TFT panel
+    QP_VIRTUAL_DISPLAY_RGB888, // 24bpp
+    QP_VIRTUAL_DISPLAY_MONO,   // 1bpp, LSb first pixel
+} qp_virtual_display_format_t;
+
+// Counters of everything the virtual display has received since it was made, or since the last reset
+typedef struct qp_virtual_display_stats_t {
+    uint32_t commands;      // number of command bytes, ie. bytes sent with D/C low
+    uint32_t comms_bytes;   // total number of bytes sent, including commands
+    uint32_t viewports;     // number of viewport changes
+    uint32_t pixdata_calls; // number of pixel data transfers
+    uint32_t pixels;        // number of native pixels written
+    uint32_t flushes;       // number of flushes
+    uint32_t conversions;   // number of colors converted to native pixels
+} qp_virtual_display_stats_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Forward declarations
+
+#ifdef QUANTUM_PAINTER_VIRTUAL_DISPLAY_ENABLE
+/**
+ * Factory method for a virtual display, a panel which only exists in memory and records what is sent to it.
+ *
+ * @param panel_width[in] the width of the display panel
+ * @param panel_height[in] the height of the display panel
+ * @param format[in] the native pixel format of the display panel
+ * @param buffer[in] pointer to a preallocated buffer of size `VIRTUAL_DISPLAY_BUFFER_SIZE(panel_width, panel_height)`
+ * @return the device handle used with all drawing routines in Quantum Painter
+ */
+painter_device_t qp_virtual_display_make_device(uint16_t panel_width, uint16_t panel_height, qp_virtual_display_format_t format, void *buffer);
+
+/**
+ * Retrieves the counters of the virtual display.
+ *
+ * @param device[in] the virtual display
+ * @param stats[out] the counters
+ * @return whether the device is a virtual display
+ */
+bool qp_virtual_display_get_stats(painter_device_t device, qp_virtual_display_stats_t *stats);
+
+/**
+ * Resets the counters of the virtual display to zero.
+ *
+ * @param device[in] the virtual display
+ */
+void qp_virtual_display_reset_stats(painter_device_t device);
+
+/**
+ * Reads back a pixel of the virtual display, in panel coordinates.
+ *
+ * @param device[in] the virtual display
+ * @param x[in] the x-location of the pixel
+ * @param y[in] the y-location of the pixel
+ * @return the color of the pixel, black if out of bounds
+ */
+RGB qp_virtual_display_get_pixel(painter_device_t device, uint16_t x, uint16_t y);
+
+/**
+ * Writes the contents of the virtual display to a binary PPM file, in panel coordinates.
+ *
+ * @param device[in] the virtual display
+ * @param filename[in] the path of the file to write
+ * @return whether the file was written successfully
+ */
+bool qp_virtual_display_save_ppm(painter_device_t device, const char *filename);
+#endif // QUANTUM_PAINTER_VIRTUAL_DISPLAY_ENABLE
@@ -28,6 +28,11 @@ void soft_serial_target_init(void);
 
 bool soft_serial_transaction(int sstd_index);
 
+#ifdef SERIAL_ASYNC_ENABLE
+// starts a transaction in the background, collected by soft_serial_transaction()
+void soft_serial_transaction_start(int sstd_index);
+#endif
+
 #ifdef SERIAL_DEBUG
 #    include <debug.h>
 #    include <print.h>
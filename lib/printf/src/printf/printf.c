@@ -0,0 +1,13 @@
+#include <stdio.h>
+#include <stdarg.h>
+#include "printf.h"
+#undef printf
+#undef sprintf
+#undef snprintf
+#undef vsnprintf
+#undef vprintf
+int vprintf_(const char* f, va_list a){char b[512];int n=vsnprintf(b,sizeof b,f,a);for(int i=0;b[i];i++)putchar_(b[i]);return n;}
+int printf_(const char* f, ...){va_list a;va_start(a,f);int n=vprintf_(f,a);va_end(a);return n;}
+int sprintf_(char* s,const char* f, ...){va_list a;va_start(a,f);int n=vsprintf(s,f,a);va_end(a);return n;}
+int snprintf_(char* s,size_t m,const char* f, ...){va_list a;va_start(a,f);int n=vsnprintf(s,m,f,a);va_end(a);return n;}
+int vsnprintf_(char* s,size_t m,const char* f, va_list a){return vsnprintf(s,m,f,a);}
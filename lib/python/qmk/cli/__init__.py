@@ -57,6 +57,7 @@ subcommands = [
     'qmk.cli.generate.keyboard_h',
     'qmk.cli.generate.keycodes',
     'qmk.cli.generate.keycodes_tests',
+    'qmk.cli.generate.leader_data',
     'qmk.cli.generate.make_dependencies',
     'qmk.cli.generate.rgb_breathe_table',
     'qmk.cli.generate.rules_mk',
@@ -69,6 +70,7 @@ subcommands = [
     'qmk.cli.info',
     'qmk.cli.json2c',
     'qmk.cli.lint',
+    'qmk.cli.key_journal',
     'qmk.cli.kle2json',
     'qmk.cli.list.keyboards',
     'qmk.cli.list.keymaps',
@@ -0,0 +1,230 @@
+"""Generate leader_data.h, a trie of leader key sequences.
+
+Each line of the dictionary file defines one sequence and its action with the syntax
+"sequence -> action". Blank lines or lines starting with '#' are ignored.
+
+The sequence is a list of keys separated by spaces. Keys are either keycodes (`KC_SLSH`), or runs of the letters a-z and digits 0-9 which are split into one key per character. The action is one of:
+
+    KC_MUTE         A keycode to tap, any expression accepted by tap_code16()
+    "git status\\n" A string to send, using the send_string() syntax
+    @git_log        A name passed to leader_sequence_user() as LEADER_GIT_LOG
+
+Example:
+    gs        -> "git status\\n"
+    gl        -> @git_log
+    m u       -> KC_MUTE
+    KC_SLSH s -> C(KC_F)
+"""
+import re
+import textwrap
+
+from milc import cli
+
+from qmk.commands import dump_lines
+from qmk.constants import GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE
+from qmk.keyboard import keyboard_completer, keyboard_folder
+from qmk.keymap import keymap_completer, locate_keymap
+from qmk.path import normpath
+
+# Must match the size of leader_sequence in quantum/leader.c
+LEADER_SEQUENCE_MAX = 5
+
+ACTION_KEYCODE = 1
+ACTION_STRING = 2
+ACTION_USER = 3
+
+_KEYCODE = re.compile(r'^[A-Z][A-Z0-9_]*(\(.*\))?$')
+_CHARACTERS = re.compile(r'^[a-z0-9]+$')
+_USER_ACTION = re.compile(r'^@([A-Za-z_][A-Za-z0-9_]*)$')
+
+
+def _character_keycode(c):
+    """Keycode name of a character a-z or 0-9.
+    """
+    return f'KC_{c.upper()}'
+
+
+def parse_sequence(sequence):
+    """Splits the left hand side of a dictionary line into keycodes.
+    """
+    keycodes = []
+    for token in sequence.split():
+        if _KEYCODE.match(token):
+            keycodes.append(token)
+        elif _CHARACTERS.match(token):
+            keycodes.extend(_character_keycode(c) for c in token)
+        else:
+            raise ValueError(f'Invalid key "{token}", use keycodes or the characters a-z and 0-9')
+    return keycodes
+
+
+def parse_action(action):
+    """Parses the right hand side of a dictionary line into an (action type, value) tuple.
+    """
+    user = _USER_ACTION.match(action)
+    if user:
+        return ACTION_USER, user.group(1)
+    if len(action) >= 2 and action[0] == '"' and action[-1] == '"':
+        return ACTION_STRING, action[1:-1]
+    if _KEYCODE.match(action):
+        return ACTION_KEYCODE, action
+    raise ValueError(f'Invalid action "{action}", use a keycode, a "string" or an @name')
+
+
+def parse_file(file_name):
+    """Parses the leader dictionary into a list of (keycodes, action) tuples.
+    """
+    sequences = []
+    seen = {}
+
+    for line_number, line in enumerate(file_name.read_text(encoding='utf-8').splitlines(), 1):
+        line = line.strip()
+        if not line or line[0] == '#':
+            continue
+
+        tokens = [token.strip() for token in line.split('->', 1)]
+        if len(tokens) != 2 or not tokens[0] or not tokens[1]:
+            raise ValueError(f'{line_number}: Invalid syntax: "{line}"')
+
+        try:
+            keycodes = parse_sequence(tokens[0])
+            action = parse_action(tokens[1])
+        except ValueError as e:
+            raise ValueError(f'{line_number}: {e}')
+
+        if len(keycodes) > LEADER_SEQUENCE_MAX:
+            raise ValueError(f'{line_number}: Sequence is longer than {LEADER_SEQUENCE_MAX} keys: "{tokens[0]}"')
+        key = tuple(keycodes)
+        if key in seen:
+            raise ValueError(f'{line_number}: Sequence "{tokens[0]}" is already defined on line {seen[key]}')
+        seen[key] = line_number
+
+        sequences.append((keycodes, action))
+
+    if not sequences:
+        raise ValueError('No leader sequences defined')
+
+    return sequences
+
+
+def make_trie(sequences):
+    """Builds a dict of dicts trie, the action of a node is stored under the `None` key.
+    """
+    trie = {}
+    for keycodes, action in sequences:
+        node = trie
+        for keycode in keycodes:
+            node = node.setdefault(keycode, {})
+        node[None] = action
+    return trie
+
+
+def serialize_trie(trie, strings, user_actions):
+    """Serializes the trie into a list of C expressions for a uint16_t array.
+
+    Each node is a header word holding the action type in the top 4 bits and the
+    number of children in the lower 12, followed by the action value if there is
+    an action, then a (keycode, node offset) pair per child.
+    """
+    table = []
+
+    def traverse(node):
+        children = [keycode for keycode in node if keycode is not None]
+        entry = []
+        table.append(entry)
+        start = sum(len(e) for e in table[:-1])
+
+        action_type, value = node.get(None, (0, None))
+        entry.append(f'0x{(action_type << 12) | len(children):04X}')
+        if action_type == ACTION_KEYCODE:
+            entry.append(value)
+        elif action_type == ACTION_STRING:
+            entry.append(str(strings.index(value)))
+        elif action_type == ACTION_USER:
+            entry.append(user_actions[value])
+
+        links = []
+        for keycode in children:
+            entry.append(keycode)
+            links.append(len(entry))
+            entry.append(None)
+
+        # The entry has its final size now, so the offsets of the children are known
+        for keycode, link in zip(children, links):
+            entry[link] = str(traverse(node[keycode]))
+        return start
+
+    traverse(trie)
+    return [word for entry in table for word in entry]
+
+
+def c_string(value):
+    """Escapes double quotes that are not already escaped, other escapes are kept as written.
+    """
+    return re.sub(r'(?<!\\)"', r'\\"', value)
+
+
+@cli.argument('filename', type=normpath, help='The leader sequence dictionary file')
+@cli.argument('-kb', '--keyboard', type=keyboard_folder, completer=keyboard_completer, help='The keyboard to build a firmware for. Ignored when a configurator export is supplied.')
+@cli.argument('-km', '--keymap', completer=keymap_completer, help='The keymap to build a firmware for. Ignored when a configurator export is supplied.')
+@cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
+@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
+@cli.subcommand('Generate the leader sequence data file from a dictionary file.')
+def generate_leader_data(cli):
+    try:
+        sequences = parse_file(cli.args.filename)
+    except ValueError as e:
+        cli.log.error('{fg_red}Error:%s', e)
+        return False
+
+    current_keyboard = cli.args.keyboard or cli.config.user.keyboard or cli.config.generate_leader_data.keyboard
+    current_keymap = cli.args.keymap or cli.config.user.keymap or cli.config.generate_leader_data.keymap
+
+    if current_keyboard and current_keymap:
+        cli.args.output = locate_keymap(current_keyboard, current_keymap).parent / 'leader_data.h'
+
+    strings = []
+    user_actions = {}
+    for _, (action_type, value) in sequences:
+        if action_type == ACTION_STRING and value not in strings:
+            strings.append(value)
+        elif action_type == ACTION_USER and value not in user_actions:
+            user_actions[value] = f'LEADER_{value.upper()}'
+
+    data = serialize_trie(make_trie(sequences), strings, user_actions)
+
+    lines = [GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE, '#pragma once', '']
+
+    lines.append(f'// Leader sequences ({len(sequences)} entries):')
+    width = max(len(' '.join(keycodes)) for keycodes, _ in sequences)
+    for keycodes, (action_type, value) in sequences:
+        action = {ACTION_KEYCODE: value, ACTION_STRING: f'"{value}"', ACTION_USER: f'@{value}'}[action_type]
+        lines.append(f'//   {" ".join(keycodes):<{width}} -> {action}')
+
+    if user_actions:
+        lines.append('')
+        lines.append('enum leader_sequence_ids {')
+        lines.extend(f'    {name},' for name in user_actions.values())
+        lines.append('};')
+
+    lines.append('')
+    lines.append('#ifdef LEADER_DATA_IMPLEMENTATION')
+    lines.append(f'#    define LEADER_DATA_SIZE {len(data)}')
+    if strings:
+        lines.append(f'#    define LEADER_DATA_STRING_COUNT {len(strings)}')
+    lines.append('')
+    lines.append('static const uint16_t leader_data[LEADER_DATA_SIZE] PROGMEM = {')
+    lines.append(textwrap.fill('    %s' % ', '.join(data), width=100, subsequent_indent='    ', break_long_words=False, break_on_hyphens=False))
+    lines.append('};')
+
+    if strings:
+        lines.append('')
+        for i, value in enumerate(strings):
+            lines.append(f'static const char leader_string_{i}[] PROGMEM = "{c_string(value)}";')
+        lines.append('')
+        lines.append('static const char *const leader_strings[LEADER_DATA_STRING_COUNT] PROGMEM = {')
+        lines.append(textwrap.fill('    %s' % ', '.join(f'leader_string_{i}' for i in range(len(strings))), width=100, subsequent_indent='    '))
+        lines.append('};')
+    lines.append('#endif')
+
+    dump_lines(cli.args.output, lines, cli.args.quiet)
@@ -0,0 +1,54 @@
+"""Decode a captured key event journal into latency histograms.
+"""
+from milc import cli
+
+from qmk.path import normpath
+from qmk.key_journal import EVENT_NAMES, parse_journal, analyze_journal, percentile, histogram
+
+HISTOGRAM_WIDTH = 50
+
+
+def _print_stage(name, values, bucket_width):
+    values = sorted(values)
+    cli.echo(f'{name}: {len(values)} samples, min {values[0] / 1000:.2f} ms, p50 {percentile(values, 50) / 1000:.2f} ms, p90 {percentile(values, 90) / 1000:.2f} ms, p99 {percentile(values, 99) / 1000:.2f} ms, max {values[-1] / 1000:.2f} ms')
+
+    buckets = histogram(values, bucket_width)
+    peak = max(count for _, count in buckets)
+    for start, count in buckets:
+        bar = '#' * (count * HISTOGRAM_WIDTH // peak)
+        cli.echo(f'  {start / 1000:7.2f} ms {count:6d} {bar}')
+    cli.echo('')
+
+
+@cli.argument('-d', '--dump', arg_only=True, action='store_true', help='Print every decoded journal entry.')
+@cli.argument('-b', '--bucket', arg_only=True, type=float, default=0.5, help='Histogram bucket width in milliseconds. Default 0.5.')
+@cli.argument('filename', arg_only=True, help='Console capture, raw HID capture or binary dump of the key event journal.')
+@cli.subcommand('Decodes a key event journal into press-to-report latency histograms.')
+def key_journal(cli):
+    """Decode a key event journal recorded with KEY_JOURNAL_ENABLE.
+    """
+    filename = normpath(cli.args.filename)
+    if not filename.exists():
+        cli.log.error('File does not exist: %s', filename)
+        return False
+
+    try:
+        entries = parse_journal(filename.read_bytes())
+    except ValueError as e:
+        cli.log.error('Unable to decode %s: %s', filename, e)
+        return False
+
+    if cli.args.dump:
+        for entry in entries:
+            cli.echo(f'{entry.timestamp:10d} {EVENT_NAMES.get(entry.type, entry.type):10} 0x{entry.data8:02X} 0x{entry.data16:04X}')
+        cli.echo('')
+
+    latencies = analyze_journal(entries, cli.log)
+    if not latencies:
+        cli.log.error('No key presses with a matching report found in %s', filename)
+        return False
+
+    bucket_width = max(1, int(cli.args.bucket * 1000))
+    _print_stage('Key event to decision', [press.decision - press.event for press in latencies], bucket_width)
+    _print_stage('Decision to report', [press.report - press.decision for press in latencies], bucket_width)
+    _print_stage('Key event to report', [press.report - press.event for press in latencies], bucket_width)
@@ -3,8 +3,11 @@
 This will compile everything in parallel, for testing purposes.
 """
 import os
+import re
+import shutil
 from pathlib import Path
 from subprocess import DEVNULL
+from appdirs import user_cache_dir
 from milc import cli
 
 from qmk.constants import QMK_FIRMWARE
@@ -13,6 +16,45 @@ from qmk.keyboard import resolve_keyboard
 from qmk.search import search_keymap_targets
 
 
+# `ccache --print-stats` first appeared in ccache 4.3
+CCACHE_STATS_MIN_VERSION = (4, 3)
+
+
+def _ccache_version():
+    """Returns the installed ccache version as a tuple, or None if it can't be determined.
+    """
+    result = cli.run(['ccache', '--version'], stdin=DEVNULL)
+    if result.returncode != 0:
+        return None
+
+    match = re.match(r'ccache version (\d+)\.(\d+)', result.stdout)
+    if not match:
+        return None
+
+    return (int(match.group(1)), int(match.group(2)))
+
+
+def _ccache_stats(cachedir):
+    """Returns the hit and miss counters of the given ccache directory, or None if they can't be read.
+
+    Requires ccache 4.3 or newer for `--print-stats`.
+    """
+    result = cli.run(['ccache', '--print-stats'], env={**os.environ, 'CCACHE_DIR': cachedir}, stdin=DEVNULL)
+    if result.returncode != 0:
+        return None
+
+    stats = {}
+    for line in result.stdout.splitlines():
+        fields = line.split('\t')
+        if len(fields) == 2 and fields[1].isdigit():
+            stats[fields[0]] = int(fields[1])
+
+    return {
+        'hits': stats.get('direct_cache_hit', 0) + stats.get('preprocessed_cache_hit', 0),
+        'misses': stats.get('cache_miss', 0),
+    }
+
+
 @cli.argument('builds', nargs='*', arg_only=True, help="List of builds in form <keyboard>:<keymap> to compile in parallel. Specifying this overrides all other target search options.")
 @cli.argument('-t', '--no-temp', arg_only=True, action='store_true', help="Remove temporary files during build.")
 @cli.argument('-j', '--parallel', type=int, default=1, help="Set the number of parallel make jobs; 0 means unlimited.")
@@ -28,6 +70,7 @@ from qmk.search import search_keymap_targets
 )
 @cli.argument('-km', '--keymap', type=str, default='default', help="The keymap name to build. Default is 'default'.")
 @cli.argument('-e', '--env', arg_only=True, action='append', default=[], help="Set a variable to be passed to make. May be passed multiple times.")
+@cli.argument('--no-cache', arg_only=True, action='store_true', help="Do not cache compiled objects between runs of the same targets through ccache. Reporting the hit rate requires ccache 4.3 or newer.")
 @cli.subcommand('Compile QMK Firmware for all keyboards.', hidden=False if cli.config.user.developer else True)
 def mass_compile(cli):
     """Compile QMK Firmware against all keyboards.
@@ -48,7 +91,29 @@ def mass_compile(cli):
         return
 
     builddir.mkdir(parents=True, exist_ok=True)
+    cachedir = None
+    cache_stats = None
     with open(makefile, "w") as f:
+        env = list(cli.args.env)
+        if not cli.args.no_cache:
+            if shutil.which('ccache'):
+                # Every source is force-included with its keyboard's config.h, so objects are only reused by later runs
+                # of the same target -- keep the cache out of .build, otherwise `make clean` or `-c` throws it away
+                cachedir = os.environ.get('CCACHE_DIR', Path(user_cache_dir('qmk')).joinpath('ccache').as_posix())
+                f.write(f'export CCACHE_DIR := {cachedir}\n')
+                f.write(f'export CCACHE_BASEDIR := {QMK_FIRMWARE}\n')
+                f.write('export CCACHE_NOHASHDIR := true\n')
+                f.write('export CCACHE_COMPILERCHECK := content\n\n')
+                env.append('USE_CCACHE=yes')
+                cli.log.info('Caching compiled objects through ccache in {fg_cyan}%s', cachedir)
+                version = _ccache_version()
+                if version is not None and version >= CCACHE_STATS_MIN_VERSION:
+                    cache_stats = _ccache_stats(cachedir)
+                else:
+                    cli.log.info('The ccache hit rate is only reported by ccache %d.%d or newer.', *CCACHE_STATS_MIN_VERSION)
+            else:
+                cli.log.warning('ccache not found, every target will be compiled from scratch.')
+
         for target in sorted(targets):
             keyboard_name = target[0]
             keymap_name = target[1]
@@ -60,7 +125,7 @@ all: {keyboard_safe}_{keymap_name}_binary
 {keyboard_safe}_{keymap_name}_binary:
 	@rm -f "{QMK_FIRMWARE}/.build/failed.log.{keyboard_safe}.{keymap_name}" || true
 	@echo "Compiling QMK Firmware for target: '{keyboard_name}:{keymap_name}'..." >>"{QMK_FIRMWARE}/.build/build.log.{os.getpid()}.{keyboard_safe}"
-	+@$(MAKE) -C "{QMK_FIRMWARE}" -f "{QMK_FIRMWARE}/builddefs/build_keyboard.mk" KEYBOARD="{keyboard_name}" KEYMAP="{keymap_name}" COLOR=true SILENT=false {' '.join(cli.args.env)} \\
+	+@$(MAKE) -C "{QMK_FIRMWARE}" -f "{QMK_FIRMWARE}/builddefs/build_keyboard.mk" KEYBOARD="{keyboard_name}" KEYMAP="{keymap_name}" COLOR=true SILENT=false {' '.join(env)} \\
 		>>"{QMK_FIRMWARE}/.build/build.log.{os.getpid()}.{keyboard_safe}.{keymap_name}" 2>&1 \\
 		|| cp "{QMK_FIRMWARE}/.build/build.log.{os.getpid()}.{keyboard_safe}.{keymap_name}" "{QMK_FIRMWARE}/.build/failed.log.{os.getpid()}.{keyboard_safe}.{keymap_name}"
 	@{{ grep '\[ERRORS\]' "{QMK_FIRMWARE}/.build/build.log.{os.getpid()}.{keyboard_safe}.{keymap_name}" >/dev/null 2>&1 && printf "Build %-64s \e[1;31m[ERRORS]\e[0m\\n" "{keyboard_name}:{keymap_name}" ; }} \\
@@ -86,6 +151,15 @@ all: {keyboard_safe}_{keymap_name}_binary
 
     cli.run([make_cmd, *get_make_parallel_args(cli.args.parallel), '-f', makefile.as_posix(), 'all'], capture_output=False, stdin=DEVNULL)
 
+    # Report how much the cache actually saved during this run
+    if cache_stats is not None:
+        after = _ccache_stats(cachedir)
+        if after is not None:
+            hits = after['hits'] - cache_stats['hits']
+            misses = after['misses'] - cache_stats['misses']
+            if hits + misses > 0:
+                cli.log.info('ccache: %d hits, %d misses (%.1f%% hit rate)', hits, misses, 100.0 * hits / (hits + misses))
+
     # Check for failures
     failures = [f for f in builddir.glob(f'failed.log.{os.getpid()}.*')]
     if len(failures) > 0:
@@ -0,0 +1,82 @@
+"""Packs Quantum Painter images and fonts into a bundle for external flash.
+"""
+import re
+import datetime
+from qmk.path import normpath
+from qmk.painter import make_bundle, qp_asset_type
+from milc import cli
+
+bundle_header_template = """\
+// Copyright {year} QMK -- generated source code only, assets retain original copyright
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// This file was auto-generated by `{generator_command}`
+
+#pragma once
+
+#include <qp.h>
+
+#define {prefix}_BUNDLE_LENGTH {byte_count}
+
+// Asset indices, for use with qp_find_bundle_asset_flash()
+enum {sane_name}_assets {{
+{asset_lines}
+    {prefix}_ASSET_COUNT
+}};
+"""
+
+
+@cli.argument('-o', '--output', default='', help='Specify output directory. Defaults to same directory as the first input.')
+@cli.argument('-n', '--name', required=True, help='Specify the name of the bundle.')
+@cli.argument('inputs', nargs='+', arg_only=True, type=normpath, help='QGF and QFF files to bundle, as written by the --raw option of the conversion commands.')
+@cli.subcommand('Packs Quantum Painter images and fonts into a bundle for external flash')
+def painter_make_bundle(cli):
+    """Packs raw QGF and QFF files into a single QPB file, which can be written to external flash.
+
+    The bundle is written to `NAME.qpb`, along with `NAME.qpb.h` holding the index of each asset in the bundle.
+    """
+    assets = []
+    for input_file in cli.args.inputs:
+        if not input_file.exists():
+            cli.log.error('Input file %s does not exist!', input_file)
+            return False
+
+        data = input_file.read_bytes()
+        asset_type = qp_asset_type(data)
+        if asset_type is None:
+            cli.log.error('Input file %s is not a raw QGF or QFF file!', input_file)
+            return False
+        assets.append((input_file, asset_type, data))
+
+    # Work out the output directory
+    if len(cli.args.output) == 0:
+        cli.args.output = cli.args.inputs[0].parent
+    cli.args.output = normpath(cli.args.output)
+
+    out_bytes = make_bundle([data for _, _, data in assets])
+
+    bundle_file = cli.args.output / (cli.args.name + ".qpb")
+    with open(bundle_file, 'wb') as bundle:
+        print(f"Writing {bundle_file}...")
+        bundle.write(out_bytes)
+
+    # Render and write the header file holding the asset indices
+    sane_name = re.sub(r"[^a-zA-Z0-9]", "_", cli.args.name)
+    prefix = sane_name.upper()
+    asset_lines = []
+    for input_file, asset_type, data in assets:
+        asset_name = re.sub(r"[^a-zA-Z0-9]", "_", input_file.name.split('.')[0]).upper()
+        asset_lines.append(f'    {prefix}_{asset_name}, // {input_file.name}, {asset_type}, {len(data)} bytes')
+
+    header_text = bundle_header_template.format(
+        year=datetime.date.today().strftime("%Y"),
+        generator_command=f'qmk painter-make-bundle -n {cli.args.name} ' + ' '.join(input_file.name for input_file, _, _ in assets),
+        prefix=prefix,
+        sane_name=sane_name,
+        byte_count=len(out_bytes),
+        asset_lines='\n'.join(asset_lines),
+    )
+    header_file = cli.args.output / (cli.args.name + ".qpb.h")
+    with open(header_file, 'w') as header:
+        print(f"Writing {header_file}...")
+        header.write(header_text)
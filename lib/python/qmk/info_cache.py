@@ -0,0 +1,223 @@
+"""On-disk cache of the info.json data generated for keyboards and keymaps.
+
+Generating info.json data means parsing the info.json, config.h, rules.mk and C files of every folder of a keyboard, which
+adds up to minutes when done for every keyboard. The results are stored under `.build/info_cache`, along with the files
+of the folders they were generated from. An entry is reused for as long as the same files exist and have the same
+modification time and size, or failing that the same content. The warnings and errors logged while generating an entry
+are stored with it, and logged again whenever it is used.
+"""
+import hashlib
+import logging
+import os
+import pickle
+from functools import lru_cache
+from pathlib import Path
+
+from milc import cli
+
+from qmk.constants import QMK_FIRMWARE
+from qmk.info import info_json, keymap_json
+
+# Bump when the layout of a cache entry changes
+CACHE_VERSION = 2
+
+CACHE_DIR = Path(QMK_FIRMWARE) / '.build' / 'info_cache'
+
+# Changes to these affect the data generated for every keyboard
+GLOBAL_DEPENDENCIES = [
+    Path('data/mappings'),
+    Path('data/schemas'),
+    Path('lib/python/qmk'),
+]
+
+
+def _hash_file(path):
+    return hashlib.sha1(path.read_bytes()).hexdigest()
+
+
+def _scan_folder(folder):
+    """Returns the (modification time, size) of each file directly inside a folder.
+    """
+    files = {}
+    if folder.is_dir():
+        with os.scandir(folder) as entries:
+            for entry in entries:
+                if entry.is_file():
+                    stat = entry.stat()
+                    files[entry.name] = (stat.st_mtime_ns, stat.st_size)
+    return files
+
+
+def _scan_tree(folder):
+    """Returns the (modification time, size) of each file inside a folder and its subfolders.
+    """
+    files = {}
+    for root, dirs, names in os.walk(folder):
+        dirs[:] = [d for d in dirs if d != '__pycache__']
+        for name in names:
+            stat = os.stat(os.path.join(root, name))
+            files[Path(root, name).as_posix()] = (stat.st_mtime_ns, stat.st_size)
+    return files
+
+
+@lru_cache(maxsize=None)
+def _global_fingerprint():
+    """Fingerprint of the mappings, schemas and code used to generate info.json data.
+    """
+    fingerprint = hashlib.sha1(str(CACHE_VERSION).encode())
+    for folder in GLOBAL_DEPENDENCIES:
+        for name, stat in sorted(_scan_tree(folder).items()):
+            fingerprint.update(f'{name}:{stat[0]}:{stat[1]}\n'.encode())
+    return fingerprint.hexdigest()
+
+
+class _DiagnosticsHandler(logging.Handler):
+    """Collects the warnings and errors logged while generating a cache entry.
+    """
+    def __init__(self):
+        super().__init__(logging.WARNING)
+        self.diagnostics = []
+
+    def emit(self, record):
+        self.diagnostics.append((record.levelno, record.getMessage()))
+
+
+def _keyboard_folders(keyboard):
+    """Lists the folders of a keyboard, from keyboards/ down to the keyboard itself.
+    """
+    folders = []
+    current_path = Path('keyboards')
+    for directory in Path(keyboard).parts:
+        current_path = current_path / directory
+        folders.append(current_path)
+    return folders
+
+
+def _record_folders(folders):
+    """Records the files of the folders a cache entry depends on.
+    """
+    record = {}
+    for folder in folders:
+        record[str(folder)] = {name: (*stat, _hash_file(folder / name)) for name, stat in _scan_folder(folder).items()}
+    return record
+
+
+def _check_folders(record):
+    """Checks that the files recorded for a cache entry have not changed.
+
+    Returns a tuple of whether the entry is still valid, and whether the record was refreshed because files were touched
+    without their content changing.
+    """
+    refreshed = False
+    for folder, files in record.items():
+        current = _scan_folder(Path(folder))
+        if current.keys() != files.keys():
+            return False, False
+
+        for name, stat in current.items():
+            if files[name][:2] == stat:
+                continue
+
+            file_hash = _hash_file(Path(folder) / name)
+            if file_hash != files[name][2]:
+                return False, False
+            files[name] = (*stat, file_hash)
+            refreshed = True
+
+    return True, refreshed
+
+
+def _entry_path(key):
+    return CACHE_DIR / f'{hashlib.sha1(key.encode()).hexdigest()}.pickle'
+
+
+def _read_entry(key):
+    """Returns the cache entry for a key, or None if there is no valid entry.
+    """
+    entry_path = _entry_path(key)
+    try:
+        with entry_path.open('rb') as f:
+            entry = pickle.load(f)
+    except Exception:
+        return None
+
+    if entry.get('key') != key or entry.get('global') != _global_fingerprint():
+        return None
+
+    valid, refreshed = _check_folders(entry['folders'])
+    if not valid:
+        return None
+    if refreshed:
+        _write_entry(entry_path, entry)
+
+    return entry
+
+
+def _write_entry(entry_path, entry):
+    """Writes a cache entry, atomically so that concurrent readers never see a partial one.
+    """
+    try:
+        entry_path.parent.mkdir(parents=True, exist_ok=True)
+        temp_path = entry_path.with_suffix(f'.{os.getpid()}.tmp')
+        with temp_path.open('wb') as f:
+            pickle.dump(entry, f, protocol=pickle.HIGHEST_PROTOCOL)
+        os.replace(temp_path, entry_path)
+    except OSError:
+        pass
+
+
+def _cached(key, folders, generate):
+    # Diagnostics can only be collected while they are being logged, so an entry generated with logging turned off (as
+    # `qmk find` does) has none to replay, and is generated again when they are wanted
+    want_diagnostics = cli.log.isEnabledFor(logging.WARNING)
+
+    entry = _read_entry(key)
+    if entry is not None and (entry['diagnostics'] is not None or not want_diagnostics):
+        for level, message in entry['diagnostics'] or []:
+            cli.log.log(level, '%s', message)
+        return entry['data']
+
+    # Record the files before generating, so that changes made in the meantime invalidate the entry
+    record = _record_folders(folders)
+    handler = None
+    if want_diagnostics:
+        handler = _DiagnosticsHandler()
+        cli.log.addHandler(handler)
+    try:
+        data = generate()
+    finally:
+        if handler:
+            cli.log.removeHandler(handler)
+
+    # A keyboard with a DEFAULT_FOLDER is generated from the folders of the default one as well
+    resolved = data.get('keyboard_folder')
+    if resolved:
+        record.update(_record_folders(f for f in _keyboard_folders(resolved) if str(f) not in record))
+
+    diagnostics = handler.diagnostics if handler else None
+    _write_entry(_entry_path(key), {'key': key, 'global': _global_fingerprint(), 'folders': record, 'diagnostics': diagnostics, 'data': data})
+    return data
+
+
+def cached_info_json(keyboard):
+    """Returns the info.json data for a keyboard, generating it only if the keyboard's files have changed.
+    """
+    keyboard = str(keyboard)
+    return _cached(f'info:{keyboard}', _keyboard_folders(keyboard), lambda: info_json(keyboard))
+
+
+def cached_keymap_json(keyboard, keymap):
+    """Returns the info.json data for a keymap, generating it only if the keyboard's or keymap's files have changed.
+    """
+    # TODO: resolve keymap.py and info.py circular dependencies
+    from qmk.keymap import locate_keymap
+
+    keyboard = str(keyboard)
+    keymap_path = locate_keymap(keyboard, keymap)
+    if keymap_path is None:
+        return keymap_json(keyboard, keymap)
+
+    # The keymap folder is part of the key, so that a keymap found in a different place gets its own entry
+    keymap_folder = keymap_path.parent
+    folders = _keyboard_folders(keyboard) + [keymap_folder]
+    return _cached(f'keymap:{keyboard}:{keymap}:{keymap_folder}', folders, lambda: keymap_json(keyboard, keymap))
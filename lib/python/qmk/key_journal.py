@@ -0,0 +1,148 @@
+"""Decoding and analysis of the firmware key event journal (KEY_JOURNAL_ENABLE).
+"""
+import re
+import struct
+from collections import namedtuple
+
+KEY_JOURNAL_VERSION = 1
+
+META = 0
+KEY_EVENT = 1
+RECORD = 2
+KEYCODE = 3
+REPORT = 4
+
+EVENT_NAMES = {
+    META: 'meta',
+    KEY_EVENT: 'key_event',
+    RECORD: 'record',
+    KEYCODE: 'keycode',
+    REPORT: 'report',
+}
+
+JournalEntry = namedtuple('JournalEntry', ['timestamp', 'type', 'data8', 'data16'])
+PressLatency = namedtuple('PressLatency', ['row', 'col', 'keycode', 'event', 'decision', 'report'])
+
+_ENTRY_STRUCT = struct.Struct('<IBBH')
+_CONSOLE_LINE = re.compile(r'KJ:([0-9A-Fa-f]{8})([0-9A-Fa-f]{2})([0-9A-Fa-f]{2})([0-9A-Fa-f]{4})')
+
+
+def _parse_raw_hid(data):
+    """Parse a capture of the packets sent with KEY_JOURNAL_RAW_HID_DRAIN: "KJ", an entry count, the entries and zero padding.
+    """
+    entries = []
+    offset = 0
+    while offset < len(data):
+        # Skip the padding of the previous packet, and any report ID the host prepended
+        if data[offset] == 0:
+            offset += 1
+            continue
+
+        if data[offset:offset + 2] != b'KJ' or offset + 3 > len(data):
+            raise ValueError(f'Invalid raw HID packet at offset {offset}')
+
+        start = offset + 3
+        end = start + data[offset + 2] * _ENTRY_STRUCT.size
+        if end > len(data):
+            raise ValueError(f'Truncated raw HID packet at offset {offset}')
+
+        entries.extend(JournalEntry(*fields) for fields in _ENTRY_STRUCT.iter_unpack(data[start:end]))
+        offset = end
+
+    return entries
+
+
+def parse_journal(data):
+    """Parse a captured journal into a list of entries.
+
+    Accepts console output containing `KJ:` lines, a capture of the raw HID packets sent with KEY_JOURNAL_RAW_HID_DRAIN, or the raw little endian `key_journal_entry_t` structures as read through `key_journal_read()`.
+    """
+    if data.lstrip(b'\0').startswith(b'KJ') and not data.lstrip(b'\0').startswith(b'KJ:'):
+        return _parse_raw_hid(data)
+
+    if b'KJ:' in data:
+        entries = []
+        for match in _CONSOLE_LINE.finditer(data.decode('ascii', errors='replace')):
+            entries.append(JournalEntry(*(int(field, 16) for field in match.groups())))
+        return entries
+
+    if len(data) % _ENTRY_STRUCT.size:
+        raise ValueError(f'Binary journal length {len(data)} is not a multiple of {_ENTRY_STRUCT.size} bytes')
+
+    return [JournalEntry(*fields) for fields in _ENTRY_STRUCT.iter_unpack(data)]
+
+
+def analyze_journal(entries, log=None):
+    """Pair each key press with the report it produced.
+
+    Returns a list of `PressLatency`, with timestamps converted to microseconds. Presses that never resulted in a report (eg. layer keys) are dropped once their release is processed.
+    """
+    tick_rate = 1000
+    pending = []
+    last_record = None
+    latencies = []
+
+    for entry in entries:
+        if entry.type == META:
+            if entry.data8 != KEY_JOURNAL_VERSION and log:
+                log.warning('Journal format version %d is not supported, decoding may be wrong.', entry.data8)
+            if entry.data16 and log:
+                log.warning('%d journal entries were lost to overflow, consider increasing KEY_JOURNAL_SIZE.', entry.data16)
+            if entry.timestamp:
+                tick_rate = entry.timestamp
+            continue
+
+        timestamp = entry.timestamp * 1000000 // tick_rate
+        position = (entry.data16 >> 8, entry.data16 & 0xFF)
+
+        if entry.type == KEY_EVENT:
+            if entry.data8 & 1:
+                pending.append({'position': position, 'event': timestamp, 'decision': None, 'keycode': None})
+
+        elif entry.type == RECORD:
+            last_record = None
+            if entry.data8 & 1:
+                for press in pending:
+                    if press['position'] == position and press['decision'] is None:
+                        press['decision'] = timestamp
+                        last_record = press
+                        break
+            else:
+                pending = [press for press in pending if press['position'] != position or press['decision'] is None]
+
+        elif entry.type == KEYCODE:
+            if last_record is not None:
+                last_record['keycode'] = entry.data16
+
+        elif entry.type == REPORT:
+            still_pending = []
+            for press in pending:
+                if press['decision'] is None:
+                    still_pending.append(press)
+                else:
+                    row, col = press['position']
+                    latencies.append(PressLatency(row, col, press['keycode'], press['event'], press['decision'], timestamp))
+            pending = still_pending
+
+    return latencies
+
+
+def percentile(values, percent):
+    """Nearest rank percentile of a sorted list.
+    """
+    if not values:
+        return 0
+    rank = max(1, -(-len(values) * percent // 100))
+    return values[rank - 1]
+
+
+def histogram(values, bucket_width):
+    """Bucket values into a list of `(bucket start, count)` tuples, including empty buckets in between.
+    """
+    if not values:
+        return []
+    counts = {}
+    for value in values:
+        bucket = value // bucket_width
+        counts[bucket] = counts.get(bucket, 0) + 1
+    return [(bucket * bucket_width, counts.get(bucket, 0)) for bucket in range(min(counts), max(counts) + 1)]
@@ -239,6 +239,8 @@ def convert_image_bytes(im, format):
         # Export the palette
         palette = []
         pal = im.getpalette()
+        # Newer versions of Pillow only return the entries in use, pad it out to the full size
+        pal = pal + [0] * (ncolors * 3 - len(pal))
         for n in range(0, ncolors * 3, 3):
             palette.append((pal[n + 0], pal[n + 1], pal[n + 2]))
 
@@ -328,3 +330,98 @@ def compress_bytes_qmk_rle(bytearray):
                 temp = []
                 repeat = False
     return output
+
+
+def compress_bytes_qmk_lz(bytearray):
+    """Compresses bytes with QMK LZ: runs of literal bytes, and matches copying up to 130 bytes from up to 256 bytes back.
+    """
+    output = []
+    literals = []
+    positions = {}
+    length = len(bytearray)
+
+    def append_literals():
+        while len(literals) > 0:
+            run = literals[0:128]
+            del literals[0:128]
+            output.append(len(run) - 1)
+            output.extend(run)
+
+    n = 0
+    while n < length:
+        # Find the longest match starting at a previous occurrence of the next three bytes, most recent first
+        match_length = 0
+        match_distance = 0
+        for p in reversed(positions.get(bytes(bytearray[n:n + 3]), [])):
+            if n - p > 256:
+                break
+            l = 0
+            while l < 130 and n + l < length and bytearray[p + l] == bytearray[n + l]:
+                l += 1
+            if l > match_length:
+                match_length = l
+                match_distance = n - p
+            if l == 130:
+                break
+
+        if match_length >= 3:
+            append_literals()
+            output.append(128 + match_length - 3)
+            output.append(match_distance - 1)
+            step = match_length
+        else:
+            literals.append(bytearray[n])
+            step = 1
+
+        for i in range(n, min(n + step, length - 2)):
+            positions.setdefault(bytes(bytearray[i:i + 3]), []).append(i)
+        n += step
+
+    append_literals()
+    return output
+
+
+def compress_bytes(bytearray, use_rle=True, use_lz=False):
+    """Compresses bytes with each of the requested schemes, returning the smallest result as a (compression scheme, bytes) tuple.
+
+    The compression scheme values match painter_compression_t in qp_internal_formats.h. Uncompressed data is preferred if nothing is smaller.
+    """
+    candidates = [(0x00, bytearray)]
+    if use_rle:
+        candidates.append((0x01, compress_bytes_qmk_rle(bytearray)))
+    if use_lz:
+        candidates.append((0x02, compress_bytes_qmk_lz(bytearray)))
+    return min(candidates, key=lambda candidate: len(candidate[1]))
+
+
+def qp_asset_type(data):
+    """Identifies a QGF image or QFF font from its leading descriptor block, returning 'image', 'font', or None.
+    """
+    if len(data) < 17 or data[0] != 0x00 or data[1] != 0xFF:
+        return None
+    total_size = int.from_bytes(data[9:13], 'little')
+    if total_size != len(data):
+        return None
+    return {b'QGF': 'image', b'QFF': 'font'}.get(bytes(data[5:8]))
+
+
+def make_bundle(assets):
+    """Packs QGF/QFF files into a QPB bundle, so they can be written to external flash in one go.
+
+    The bundle starts with a descriptor block, followed by a table of the offset and length of each asset, then the assets themselves.
+    """
+    def block(type_id, blob):
+        return bytes([type_id, ~type_id & 0xFF]) + len(blob).to_bytes(3, 'little') + blob
+
+    descriptor_size = 5 + 14
+    table_size = 5 + 8 * len(assets)
+    total_size = descriptor_size + table_size + sum(len(asset) for asset in assets)
+
+    table = bytes()
+    offset = descriptor_size + table_size
+    for asset in assets:
+        table += offset.to_bytes(4, 'little') + len(asset).to_bytes(4, 'little')
+        offset += len(asset)
+
+    descriptor = b'QPB' + bytes([0x01]) + total_size.to_bytes(4, 'little') + (~total_size & 0xFFFFFFFF).to_bytes(4, 'little') + len(assets).to_bytes(2, 'little')
+    return block(0x00, descriptor) + block(0x01, table) + b''.join(bytes(asset) for asset in assets)
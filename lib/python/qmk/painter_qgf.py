@@ -160,25 +160,23 @@ class QGFFramePaletteDescriptorV1:
 
 class QGFFrameDeltaDescriptorV1:
     type_id = 0x04
-    length = 8
+    rect_length = 8
 
     def __init__(self):
         self.header = QGFBlockHeader()
         self.header.type_id = QGFFrameDeltaDescriptorV1.type_id
-        self.header.length = QGFFrameDeltaDescriptorV1.length
-        self.left = 0
-        self.top = 0
-        self.right = 0
-        self.bottom = 0
+        self.rects = []  # (left, top, right, bottom), inclusive
 
     def write(self, fp):
+        self.header.length = len(self.rects) * QGFFrameDeltaDescriptorV1.rect_length
         self.header.write(fp)
-        fp.write(b''  # start off with empty bytes...
-                 + o16(self.left)  # left
-                 + o16(self.top)  # top
-                 + o16(self.right)  # right
-                 + o16(self.bottom)  # bottom
-                 )
+        for rect in self.rects:
+            fp.write(b''  # start off with empty bytes...
+                     + o16(rect[0])  # left
+                     + o16(rect[1])  # top
+                     + o16(rect[2])  # right
+                     + o16(rect[3])  # bottom
+                     )
 
 
 ########################################################################################################################
@@ -221,6 +219,109 @@ def _accept(prefix):
     return False
 
 
+# Size of the tiles used to find the changed areas of a frame
+DELTA_TILE_SIZE = 8
+
+# Estimated cost in bytes of each extra rect in a delta frame: the rect itself, and setting the viewport on the display
+DELTA_RECT_OVERHEAD = QGFFrameDeltaDescriptorV1.rect_length + 16
+
+
+def _changed_rects(frame, last_frame, bpp):
+    """Finds a set of rects covering every pixel that changed since the last frame, as (left, top, right, bottom) boxes
+    with exclusive right and bottom edges.
+
+    Changed tiles are joined into rects, which are then shrunk to the pixels that actually changed. Rects are merged
+    whenever drawing their union is cheaper than drawing both, accounting for the overhead of each rect.
+    """
+    diff = ImageChops.difference(frame, last_frame)
+    if not diff.getbbox():
+        return []
+
+    # Collapse the channels so that any difference marks the pixel as changed
+    mask = diff.split()
+    changed = mask[0]
+    for channel in mask[1:]:
+        changed = ImageChops.lighter(changed, channel)
+
+    width, height = frame.size
+    tiles_x = (width + DELTA_TILE_SIZE - 1) // DELTA_TILE_SIZE
+    tiles_y = (height + DELTA_TILE_SIZE - 1) // DELTA_TILE_SIZE
+
+    # Join runs of changed tiles on each row, extending the rects of the row above when they span the same columns
+    rects = []
+    open_rects = {}
+    for ty in range(tiles_y):
+        runs = []
+        start = None
+        for tx in range(tiles_x + 1):
+            dirty = tx < tiles_x and changed.crop((tx * DELTA_TILE_SIZE, ty * DELTA_TILE_SIZE, min((tx + 1) * DELTA_TILE_SIZE, width), min((ty + 1) * DELTA_TILE_SIZE, height))).getbbox() is not None
+            if dirty and start is None:
+                start = tx
+            elif not dirty and start is not None:
+                runs.append((start, tx))
+                start = None
+
+        next_open = {}
+        for run in runs:
+            rect = open_rects.pop(run, None)
+            if rect is None:
+                rect = [run[0], ty, run[1], ty + 1]
+                rects.append(rect)
+            rect[3] = ty + 1
+            next_open[run] = rect
+        open_rects = next_open
+
+    # Convert from tiles to pixels, shrinking each rect to the pixels which changed within it
+    boxes = []
+    for rect in rects:
+        box = (rect[0] * DELTA_TILE_SIZE, rect[1] * DELTA_TILE_SIZE, min(rect[2] * DELTA_TILE_SIZE, width), min(rect[3] * DELTA_TILE_SIZE, height))
+        inner = changed.crop(box).getbbox()
+        boxes.append((box[0] + inner[0], box[1] + inner[1], box[0] + inner[2], box[1] + inner[3]))
+
+    def cost(box):
+        return (box[2] - box[0]) * (box[3] - box[1]) * bpp / 8 + DELTA_RECT_OVERHEAD
+
+    def union(a, b):
+        return (min(a[0], b[0]), min(a[1], b[1]), max(a[2], b[2]), max(a[3], b[3]))
+
+    # Merge the pair of rects that saves the most, until no merge saves anything
+    while len(boxes) > 1:
+        best = None
+        for i in range(len(boxes)):
+            for j in range(i + 1, len(boxes)):
+                saving = cost(boxes[i]) + cost(boxes[j]) - cost(union(boxes[i], boxes[j]))
+                if saving >= 0 and (best is None or saving > best[0]):
+                    best = (saving, i, j)
+        if best is None:
+            break
+        merged = union(boxes[best[1]], boxes[best[2]])
+        boxes = [box for n, box in enumerate(boxes) if n not in best[1:]] + [merged]
+
+    return sorted(boxes, key=lambda box: (box[1], box[0]))
+
+
+def _convert_rects(frame, rects, format):
+    """Converts the given rects of a frame to the requested format, sharing a single palette.
+
+    Returns the palette and the concatenated bytes of each rect, every rect starting on a byte boundary.
+    """
+    # Lay out all the pixels in a single strip so that the palette is generated from the changed pixels only
+    crops = [frame.crop(rect) for rect in rects]
+    strip = Image.frombytes('RGB', (sum(c.size[0] * c.size[1] for c in crops), 1), b''.join(c.tobytes() for c in crops))
+    converted = qmk.painter.convert_requested_format(strip, format)
+
+    palette = None
+    data = []
+    offset = 0
+    for crop in crops:
+        count = crop.size[0] * crop.size[1]
+        (palette, rect_data) = qmk.painter.convert_image_bytes(converted.crop((offset, 0, offset + count, 1)), format)
+        data.extend(rect_data)
+        offset += count
+
+    return (palette, data)
+
+
 def _save(im, fp, filename):
     """Helper method used by PIL to write to an output file.
     """
@@ -230,6 +331,7 @@ def _save(im, fp, filename):
     verbose = encoderinfo.get("verbose", False)
     use_deltas = encoderinfo.get("use_deltas", True)
     use_rle = encoderinfo.get("use_rle", True)
+    use_lz = encoderinfo.get("use_lz", False)
 
     # Helper for inline verbose prints
     def vprint(s):
@@ -278,66 +380,39 @@ def _save(im, fp, filename):
 
     # Helper function to save each frame to the output file
     def _write_frame(idx, frame, last_frame):
-        # If we replace the frame we're going to output with a delta, we can override it here
-        this_frame = frame
-        location = (0, 0)
-        size = frame.size
-
         # Work out the format we're going to use
         format = encoderinfo["qmk_format"]
 
         # Convert the original frame so we can do comparisons
-        converted = qmk.painter.convert_requested_format(this_frame, format)
+        converted = qmk.painter.convert_requested_format(frame, format)
         graphic_data = qmk.painter.convert_image_bytes(converted, format)
 
-        # Convert the raw data to RLE-encoded if requested
-        raw_data = graphic_data[1]
-        if use_rle:
-            rle_data = qmk.painter.compress_bytes_qmk_rle(graphic_data[1])
-        use_raw_this_frame = not use_rle or len(raw_data) <= len(rle_data)
-        image_data = raw_data if use_raw_this_frame else rle_data
+        # Compress the raw data if requested, keeping whichever is smallest
+        (compression, image_data) = qmk.painter.compress_bytes(graphic_data[1], use_rle, use_lz)
 
         # Work out if a delta frame is smaller than injecting it directly
         use_delta_this_frame = False
         if use_deltas and last_frame is not None:
-            # If we want to use deltas, then find the difference
-            diff = ImageChops.difference(frame, last_frame)
-
-            # Get the bounding box of those differences
-            bbox = diff.getbbox()
-
-            # If we have a valid bounding box...
-            if bbox:
-                # ...create the delta frame by cropping the original.
-                delta_frame = frame.crop(bbox)
-                delta_location = (bbox[0], bbox[1])
-                delta_size = (bbox[2] - bbox[0], bbox[3] - bbox[1])
+            # If we want to use deltas, then find the areas which changed
+            rects = _changed_rects(frame, last_frame, format['bpp'])
 
-                # Convert the delta frame to the requested format
-                delta_converted = qmk.painter.convert_requested_format(delta_frame, format)
-                delta_graphic_data = qmk.painter.convert_image_bytes(delta_converted, format)
+            # If anything changed...
+            if rects:
+                # ...convert the changed areas to the requested format
+                delta_graphic_data = _convert_rects(frame, rects, format)
 
                 # Work out how large the delta frame is going to be with compression etc.
-                delta_raw_data = delta_graphic_data[1]
-                if use_rle:
-                    delta_rle_data = qmk.painter.compress_bytes_qmk_rle(delta_graphic_data[1])
-                delta_use_raw_this_frame = not use_rle or len(delta_raw_data) <= len(delta_rle_data)
-                delta_image_data = delta_raw_data if delta_use_raw_this_frame else delta_rle_data
+                (delta_compression, delta_image_data) = qmk.painter.compress_bytes(delta_graphic_data[1], use_rle, use_lz)
 
                 # If the size of the delta frame (plus delta descriptor) is smaller than the original, use that instead
                 # This ensures that if a non-delta is overall smaller in size, we use that in preference due to flash
                 # sizing constraints.
-                if (len(delta_image_data) + QGFFrameDeltaDescriptorV1.length) < len(image_data):
+                if (len(delta_image_data) + len(rects) * QGFFrameDeltaDescriptorV1.rect_length) < len(image_data):
                     # Copy across all the delta equivalents so that the rest of the processing acts on those
-                    this_frame = delta_frame
-                    location = delta_location
-                    size = delta_size
-                    converted = delta_converted
                     graphic_data = delta_graphic_data
-                    raw_data = delta_raw_data
-                    rle_data = delta_rle_data
-                    use_raw_this_frame = delta_use_raw_this_frame
+                    compression = delta_compression
                     image_data = delta_image_data
+                    delta_rects = rects
                     use_delta_this_frame = True
 
         # Write out the frame descriptor
@@ -347,7 +422,7 @@ def _save(im, fp, filename):
         frame_descriptor.is_delta = use_delta_this_frame
         frame_descriptor.is_transparent = False
         frame_descriptor.format = format['image_format_byte']
-        frame_descriptor.compression = 0x00 if use_raw_this_frame else 0x01  # See qp.h, painter_compression_t
+        frame_descriptor.compression = compression  # See qp.h, painter_compression_t
         frame_descriptor.delay = frame.info['duration'] if 'duration' in frame.info else 1000  # If we're not an animation, just pretend we're delaying for 1000ms
         frame_descriptor.write(fp)
 
@@ -368,12 +443,9 @@ def _save(im, fp, filename):
 
         # Write out the delta info if required
         if use_delta_this_frame:
-            # Set up the rendering location of where the delta frame should be situated
+            # Set up the rendering locations of the changed areas, in the same order as their data
             delta_descriptor = QGFFrameDeltaDescriptorV1()
-            delta_descriptor.left = location[0]
-            delta_descriptor.top = location[1]
-            delta_descriptor.right = location[0] + size[0] - 1
-            delta_descriptor.bottom = location[1] + size[1] - 1
+            delta_descriptor.rects = [(rect[0], rect[1], rect[2] - 1, rect[3] - 1) for rect in delta_rects]
 
             # Write the delta frame to the output
             vprint(f'{f"Frame {idx:3d} delta":26s} {fp.tell():5d}d / {fp.tell():04X}h')
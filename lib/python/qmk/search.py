@@ -8,7 +8,7 @@ import re
 from dotty_dict import dotty
 from milc import cli
 
-from qmk.info import keymap_json
+from qmk.info_cache import cached_keymap_json
 import qmk.keyboard
 import qmk.keymap
 
@@ -42,7 +42,7 @@ def _keymap_exists(keyboard, keymap):
 
 def _load_keymap_info(keyboard, keymap):
     with ignore_logging():
-        return (keyboard, keymap, keymap_json(keyboard, keymap))
+        return (keyboard, keymap, cached_keymap_json(keyboard, keymap))
 
 
 def search_keymap_targets(keymap='default', filters=[], print_vals=[]):
@@ -61,6 +61,12 @@ def test_flash_bootloaders():
     check_returncode(result, [1])
 
 
+def test_key_journal():
+    result = check_subcommand('key-journal', 'lib/python/qmk/tests/key_journal.txt')
+    check_returncode(result)
+    assert 'Key event to report: 2 samples' in result.stdout
+
+
 def test_kle2json():
     result = check_subcommand('kle2json', 'lib/python/qmk/tests/kle.txt', '-f')
     check_returncode(result)
@@ -79,3 +79,10 @@ typedef uint8_t pin_t;
 #define readPin(pin) ((PORT->Group[SAMD_PORT(pin)].IN.reg & SAMD_PIN_MASK(pin)) != 0)
 
 #define togglePin(pin) (PORT->Group[SAMD_PORT(pin)].OUTTGL.reg = SAMD_PIN_MASK(pin))
+
+/* Whole port access, for reading several pins of the same port at once */
+typedef uint32_t port_data_t;
+
+#define readPort(pin) (PORT->Group[SAMD_PORT(pin)].IN.reg)
+#define getPortBit(pin) SAMD_PIN(pin)
+#define isSamePort(pin_a, pin_b) (SAMD_PORT(pin_a) == SAMD_PORT(pin_b))
@@ -36,3 +36,10 @@ typedef uint8_t pin_t;
 #define readPin(pin) ((bool)(PINx_ADDRESS(pin) & _BV((pin)&0xF)))
 
 #define togglePin(pin) (PORTx_ADDRESS(pin) ^= _BV((pin)&0xF))
+
+/* Whole port access, for reading several pins of the same port at once */
+typedef uint8_t port_data_t;
+
+#define readPort(pin) (PINx_ADDRESS(pin))
+#define getPortBit(pin) ((pin)&0xF)
+#define isSamePort(pin_a, pin_b) (((pin_a) >> PORT_SHIFTER) == ((pin_b) >> PORT_SHIFTER))
@@ -124,3 +124,9 @@
  *user overridable sample generation/processing
  */
 uint16_t dac_value_generate(void);
+
+/**
+ * user overridable waveform of the dac_mixer driver, returns a signed Q15 sample
+ * for a phase where one full period spans the whole uint32_t range
+ */
+int16_t dac_mixer_waveform_sample(uint32_t phase);
@@ -0,0 +1,350 @@
+/* Copyright 2023 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "audio.h"
+#include "luts.h"
+#include <ch.h>
+#include <hal.h>
+
+/*
+  Audio Driver: DAC mixer
+
+  renders all active tones as independent voices - each with its own fixed-point
+  phase accumulator and attack/release envelope - into blocks of samples, which
+  are streamed to the DAC through DMA from a double buffer
+
+  the DMA interrupt only hands the free half of the buffer over to a mixer thread,
+  so no sample computation happens in interrupt context
+*/
+
+#if !defined(AUDIO_PIN)
+#    error "Audio feature enabled, but no suitable pin selected as AUDIO_PIN - see docs/feature_audio under 'ARM (DAC mixer)' for available options."
+#endif
+#if defined(AUDIO_PIN_ALT) && !defined(AUDIO_PIN_ALT_AS_NEGATIVE)
+#    pragma message "Audio feature: AUDIO_PIN_ALT set, but not AUDIO_PIN_ALT_AS_NEGATIVE - pin will be left unused; audio might still work though."
+#endif
+
+#if !defined(AUDIO_PIN_ALT)
+// no ALT pin defined is valid, but the c-ifs below need some value set
+#    define AUDIO_PIN_ALT PAL_NOLINE
+#endif
+
+#if !defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE) && !defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE) && !defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE) && !defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
+#    define AUDIO_DAC_SAMPLE_WAVEFORM_SINE
+#endif
+
+/**
+ * Number of voices that are rendered at once, releasing voices keep their slot
+ * until they have faded out.
+ */
+#ifndef AUDIO_DAC_MIXER_VOICES
+#    define AUDIO_DAC_MIXER_VOICES AUDIO_MAX_SIMULTANEOUS_TONES
+#endif
+
+/**
+ * Envelope timings, short ramps avoid the clicks of hard tone on/offsets
+ */
+#ifndef AUDIO_DAC_MIXER_ATTACK_MS
+#    define AUDIO_DAC_MIXER_ATTACK_MS 2
+#endif
+#ifndef AUDIO_DAC_MIXER_RELEASE_MS
+#    define AUDIO_DAC_MIXER_RELEASE_MS 10
+#endif
+
+#ifndef AUDIO_DAC_MIXER_THREAD_PRIORITY
+#    define AUDIO_DAC_MIXER_THREAD_PRIORITY (NORMALPRIO + 1)
+#endif
+
+/* The DAC is triggered by TIM6 TRGO, which fires at 3/2 * AUDIO_DAC_SAMPLE_RATE
+ * with the timer configuration below - see the notes in audio_dac_additive.c */
+#define MIXER_SAMPLE_RATE (AUDIO_DAC_SAMPLE_RATE * 3 / 2)
+
+#define MIXER_LEVEL_MAX 0x7FFF
+#define MIXER_ATTACK_STEP (MAX(MIXER_LEVEL_MAX / MAX((MIXER_SAMPLE_RATE / 1000) * AUDIO_DAC_MIXER_ATTACK_MS, 1), 1))
+#define MIXER_RELEASE_STEP (MAX(MIXER_LEVEL_MAX / MAX((MIXER_SAMPLE_RATE / 1000) * AUDIO_DAC_MIXER_RELEASE_MS, 1), 1))
+// per sample slew of the mix gain, a full swing takes roughly one millisecond
+#define MIXER_GAIN_STEP (MAX(MIXER_LEVEL_MAX / (MIXER_SAMPLE_RATE / 1000), 1))
+
+typedef struct {
+    float    frequency; // unprocessed frequency, identifies the tone the voice plays
+    uint32_t phase;     // position in the waveform, one period = 2^32
+    uint32_t increment; // phase advance per sample
+    uint16_t level;     // envelope level, 0..MIXER_LEVEL_MAX
+    bool     sounding;  // false once the voice is releasing
+} mixer_voice_t;
+
+static mixer_voice_t voices[AUDIO_DAC_MIXER_VOICES];
+
+static dacsample_t dac_buffer[AUDIO_DAC_BUFFER_SIZE] = {[0 ... AUDIO_DAC_BUFFER_SIZE - 1] = AUDIO_DAC_OFF_VALUE};
+
+static volatile bool stop_requested   = false;
+static volatile bool update_requested = false;
+static volatile bool running          = false;
+static uint16_t      mix_gain         = MIXER_LEVEL_MAX;
+
+static binary_semaphore_t render_semaphore;
+static volatile uint8_t   render_half = 0;
+
+/**
+ * Returns one signed Q15 sample of the selected waveform at the given phase.
+ * Declared weak so users can provide their own wave-forms.
+ */
+__attribute__((weak)) int16_t dac_mixer_waveform_sample(uint32_t phase) {
+#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
+    return sine_lut[phase >> 24];
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
+    return (phase & 0x80000000) ? -MIXER_LEVEL_MAX : MIXER_LEVEL_MAX;
+#else
+    // fold the upper 17 bits of the phase into a 16 bit ramp up and down
+    int32_t triangle = (int32_t)(phase >> 15);
+    triangle         = (triangle < 0x10000 ? triangle : 0x1FFFF - triangle) - 0x8000;
+#    if defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
+    triangle *= 2;
+#    endif
+    return (int16_t)MAX(MIN(triangle, MIXER_LEVEL_MAX), -MIXER_LEVEL_MAX);
+#endif
+}
+
+static inline uint32_t frequency_to_increment(float frequency) {
+    return (uint32_t)((frequency / MIXER_SAMPLE_RATE) * 4294967296.0f);
+}
+
+/**
+ * Match the tones of the audio core against the voices: continuing tones keep
+ * their phase and envelope, new tones claim a free voice and tones that were
+ * stopped start releasing.
+ */
+static void mixer_update_voices(void) {
+    uint8_t active_tones = MIN(AUDIO_DAC_MIXER_VOICES, audio_get_number_of_active_tones());
+    bool    matched[AUDIO_DAC_MIXER_VOICES] = {false};
+
+    for (uint8_t t = 0; t < active_tones; t++) {
+        float frequency = audio_get_frequency(t);
+        float processed = audio_get_processed_frequency(t);
+        if (frequency <= 0.0f || processed <= 0.0f) {
+            // 'rest' notes carry no sound
+            continue;
+        }
+
+        int8_t slot = -1;
+        for (uint8_t v = 0; v < AUDIO_DAC_MIXER_VOICES; v++) {
+            if (!matched[v] && voices[v].frequency == frequency && (voices[v].sounding || voices[v].level > 0)) {
+                slot = v;
+                break;
+            }
+        }
+        if (slot < 0) {
+            // prefer a silent voice, steal the quietest releasing one otherwise
+            uint16_t quietest = UINT16_MAX;
+            for (uint8_t v = 0; v < AUDIO_DAC_MIXER_VOICES; v++) {
+                if (!matched[v] && !voices[v].sounding && voices[v].level < quietest) {
+                    quietest = voices[v].level;
+                    slot     = v;
+                }
+            }
+            if (slot < 0) {
+                continue;
+            }
+            voices[slot].frequency = frequency;
+            voices[slot].phase     = 0;
+        }
+
+        matched[slot]          = true;
+        voices[slot].sounding  = true;
+        voices[slot].increment = frequency_to_increment(processed);
+    }
+
+    for (uint8_t v = 0; v < AUDIO_DAC_MIXER_VOICES; v++) {
+        if (!matched[v]) {
+            voices[v].sounding = false;
+        }
+    }
+}
+
+static void mixer_render(dacsample_t *sample_p, uint16_t count) {
+    uint8_t audible = 0;
+    for (uint8_t v = 0; v < AUDIO_DAC_MIXER_VOICES; v++) {
+        if (voices[v].sounding || voices[v].level > 0) {
+            audible++;
+        }
+    }
+
+    // scale the mix so that all audible voices together can not clip
+    uint16_t target_gain = MIXER_LEVEL_MAX / MAX(audible, 1);
+
+    for (uint16_t s = 0; s < count; s++) {
+        int32_t mix = 0;
+
+        for (uint8_t v = 0; v < AUDIO_DAC_MIXER_VOICES; v++) {
+            mixer_voice_t *voice = &voices[v];
+
+            if (voice->sounding) {
+                voice->level = MIN(voice->level + MIXER_ATTACK_STEP, MIXER_LEVEL_MAX);
+            } else if (voice->level > 0) {
+                voice->level = voice->level > MIXER_RELEASE_STEP ? voice->level - MIXER_RELEASE_STEP : 0;
+            } else {
+                continue;
+            }
+
+            voice->phase += voice->increment;
+            mix += ((int32_t)dac_mixer_waveform_sample(voice->phase) * voice->level) >> 15;
+        }
+
+        if (mix_gain < target_gain) {
+            mix_gain = MIN(mix_gain + MIXER_GAIN_STEP, target_gain);
+        } else if (mix_gain > target_gain) {
+            mix_gain = MAX(mix_gain - MIXER_GAIN_STEP, target_gain);
+        }
+
+        mix = (mix * mix_gain) >> 15;
+
+        int32_t value = (int32_t)AUDIO_DAC_OFF_VALUE + ((mix * (int32_t)(AUDIO_DAC_SAMPLE_MAX / 2)) >> 15);
+        sample_p[s]   = (dacsample_t)MAX(MIN(value, (int32_t)AUDIO_DAC_SAMPLE_MAX), 0);
+    }
+}
+
+static bool mixer_is_silent(void) {
+    for (uint8_t v = 0; v < AUDIO_DAC_MIXER_VOICES; v++) {
+        if (voices[v].sounding || voices[v].level > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static THD_WORKING_AREA(waMixerThread, 256);
+static THD_FUNCTION(MixerThread, arg) {
+    (void)arg;
+    chRegSetThreadName("audio_mixer");
+
+    while (true) {
+        chBSemWait(&render_semaphore);
+
+        if (!running) {
+            continue;
+        }
+
+        // update audio internal state (note position, current_note, ...)
+        if (audio_update_state() || update_requested) {
+            update_requested = false;
+            mixer_update_voices();
+        }
+
+        if (stop_requested) {
+            for (uint8_t v = 0; v < AUDIO_DAC_MIXER_VOICES; v++) {
+                voices[v].sounding = false;
+            }
+        }
+
+        mixer_render(dac_buffer + (render_half ? AUDIO_DAC_BUFFER_SIZE / 2 : 0), AUDIO_DAC_BUFFER_SIZE / 2);
+
+        if (stop_requested && mixer_is_silent()) {
+            // all voices have faded out, park the output at the off value and
+            // stop the timer, which halts the DAC and its interrupts
+            for (uint16_t s = 0; s < AUDIO_DAC_BUFFER_SIZE; s++) {
+                dac_buffer[s] = AUDIO_DAC_OFF_VALUE;
+            }
+            chSysLock();
+            // a start request might have raced us
+            if (stop_requested) {
+                gptStopTimerI(&GPTD6);
+                running = false;
+            }
+            chSysUnlock();
+        }
+    }
+}
+
+/**
+ * DAC streaming callback, called on the 'half buffer event' and the 'full buffer
+ * event'. Hands the half of the buffer that was just played back to the mixer.
+ */
+static void dac_end(DACDriver *dacp) {
+    render_half = dacIsBufferComplete(dacp) ? 1 : 0;
+
+    osalSysLockFromISR();
+    chBSemSignalI(&render_semaphore);
+    osalSysUnlockFromISR();
+}
+
+static void dac_error(DACDriver *dacp, dacerror_t err) {
+    (void)dacp;
+    (void)err;
+
+    chSysHalt("DAC failure. halp");
+}
+
+static const GPTConfig gpt6cfg1 = {.frequency = AUDIO_DAC_SAMPLE_RATE * 3,
+                                   .callback  = NULL,
+                                   .cr2       = TIM_CR2_MMS_1, /* MMS = 010 = TRGO on Update Event.  */
+                                   .dier      = 0U};
+
+static const DACConfig dac_conf = {.init = AUDIO_DAC_OFF_VALUE, .datamode = DAC_DHRM_12BIT_RIGHT};
+
+static const DACConversionGroup dac_conv_cfg = {.num_channels = 1U, .end_cb = dac_end, .error_cb = dac_error, .trigger = DAC_TRG(0b000)};
+
+void audio_driver_initialize(void) {
+    chBSemObjectInit(&render_semaphore, true);
+
+    if ((AUDIO_PIN == A4) || (AUDIO_PIN_ALT == A4)) {
+        palSetLineMode(A4, PAL_MODE_INPUT_ANALOG);
+        dacStart(&DACD1, &dac_conf);
+    }
+    if ((AUDIO_PIN == A5) || (AUDIO_PIN_ALT == A5)) {
+        palSetLineMode(A5, PAL_MODE_INPUT_ANALOG);
+        dacStart(&DACD2, &dac_conf);
+    }
+
+    /* enable the output buffer, to directly drive external loads with no additional circuitry
+     * see the notes in audio_dac_additive.c
+     */
+    DACD1.params->dac->CR &= ~DAC_CR_BOFF1;
+    DACD2.params->dac->CR &= ~DAC_CR_BOFF2;
+
+    if (AUDIO_PIN == A4) {
+        dacStartConversion(&DACD1, &dac_conv_cfg, dac_buffer, AUDIO_DAC_BUFFER_SIZE);
+    } else if (AUDIO_PIN == A5) {
+        dacStartConversion(&DACD2, &dac_conv_cfg, dac_buffer, AUDIO_DAC_BUFFER_SIZE);
+    }
+
+#if defined(AUDIO_PIN_ALT_AS_NEGATIVE)
+    if (AUDIO_PIN_ALT == A4) {
+        dacPutChannelX(&DACD1, 0, AUDIO_DAC_OFF_VALUE);
+    } else if (AUDIO_PIN_ALT == A5) {
+        dacPutChannelX(&DACD2, 0, AUDIO_DAC_OFF_VALUE);
+    }
+#endif
+
+    chThdCreateStatic(waMixerThread, sizeof(waMixerThread), AUDIO_DAC_MIXER_THREAD_PRIORITY, MixerThread, NULL);
+
+    gptStart(&GPTD6, &gpt6cfg1);
+}
+
+void audio_driver_stop(void) {
+    stop_requested = true;
+}
+
+void audio_driver_start(void) {
+    chSysLock();
+    stop_requested   = false;
+    update_requested = true;
+
+    if (!running) {
+        running = true;
+        gptStartContinuousI(&GPTD6, 2U);
+    }
+    chSysUnlock();
+}
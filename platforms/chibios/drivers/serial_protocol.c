@@ -30,6 +30,34 @@ static THD_FUNCTION(SlaveThread, arg) {
     }
 }
 
+#ifdef SERIAL_ASYNC_ENABLE
+/* Index of the transaction started by soft_serial_transaction_start() that
+ * has not been collected yet, -1 if there is none. Only written by the main
+ * thread, the semaphores order the accesses with the master thread. */
+static int  async_index  = -1;
+static bool async_result = false;
+static BSEMAPHORE_DECL(async_request, true);
+static BSEMAPHORE_DECL(async_done, true);
+
+/**
+ * @brief This thread runs on the master and executes the transactions started
+ * by soft_serial_transaction_start(). It sleeps while the driver waits for the
+ * slave, so the main thread keeps scanning in the meantime.
+ */
+static THD_WORKING_AREA(waMasterThread, 1024);
+static THD_FUNCTION(MasterThread, arg) {
+    (void)arg;
+    chRegSetThreadName("split_protocol_async");
+
+    while (true) {
+        chBSemWait(&async_request);
+        serial_transport_driver_clear();
+        async_result = initiate_transaction((uint8_t)async_index);
+        chBSemSignal(&async_done);
+    }
+}
+#endif // SERIAL_ASYNC_ENABLE
+
 /**
  * @brief Slave specific initializations.
  */
@@ -45,6 +73,10 @@ void soft_serial_target_init(void) {
  */
 void soft_serial_initiator_init(void) {
     serial_transport_driver_master_init();
+
+#ifdef SERIAL_ASYNC_ENABLE
+    chThdCreateStatic(waMasterThread, sizeof(waMasterThread), HIGHPRIO, MasterThread, NULL);
+#endif
 }
 
 /**
@@ -102,6 +134,19 @@ static inline bool react_to_transaction(void) {
  * @return bool Indicates success of transaction.
  */
 bool soft_serial_transaction(int index) {
+#ifdef SERIAL_ASYNC_ENABLE
+    /* Wait for the transaction in flight, its result is ours if it is the same
+     * transaction, otherwise it is dropped and ours is started afresh. */
+    if (async_index >= 0) {
+        int started = async_index;
+        chBSemWait(&async_done);
+        async_index = -1;
+        if (started == index) {
+            return async_result;
+        }
+    }
+#endif
+
     /* Clear the receive queue, to start with a clean slate.
      * Parts of failed transactions or spurious bytes could still be in it. */
     serial_transport_driver_clear();
@@ -109,6 +154,25 @@ bool soft_serial_transaction(int index) {
     return initiate_transaction((uint8_t)index);
 }
 
+#ifdef SERIAL_ASYNC_ENABLE
+/**
+ * @brief Start transaction from the master half to the slave half in the
+ * background. The next soft_serial_transaction() call with the same index
+ * waits for it and returns its result, instead of starting a new one.
+ *
+ * @param index Transaction Table index of the transaction to start.
+ */
+void soft_serial_transaction_start(int index) {
+    /* Only one transaction can be in flight. */
+    if (async_index >= 0) {
+        return;
+    }
+
+    async_index = index;
+    chBSemSignal(&async_request);
+}
+#endif // SERIAL_ASYNC_ENABLE
+
 /**
  * @brief Initiate transaction to slave half.
  */
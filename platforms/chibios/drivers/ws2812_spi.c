@@ -84,7 +84,45 @@
 #define RESET_SIZE (1000 * WS2812_TRST_US / (2 * WS2812_TIMING))
 #define PREAMBLE_SIZE 4
 
-static uint8_t txbuf[PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
+// Asynchronous transfers encode the next frame into a second buffer while
+// the current one is sent, and chain it from the transfer complete callback.
+#if !defined(WS2812_SPI_USE_CIRCULAR_BUFFER) && !defined(WS2812_SPI_SYNC)
+#    define WS2812_SPI_DOUBLE_BUFFER
+#    define WS2812_SPI_BUFFER_COUNT 2
+#else
+#    define WS2812_SPI_BUFFER_COUNT 1
+#endif
+
+static uint8_t txbufs[WS2812_SPI_BUFFER_COUNT][PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
+static uint8_t* txbuf = txbufs[0];
+
+#ifdef WS2812_SPI_DOUBLE_BUFFER
+static volatile bool ws2812_busy    = false;
+static volatile bool ws2812_pending = false;
+
+__attribute__((weak)) void ws2812_transfer_complete_callback(void) {}
+
+static void ws2812_spi_complete_cb(SPIDriver* spip) {
+    osalSysLockFromISR();
+    if (ws2812_pending) {
+        // The HAL only returns the driver to ready once this callback returns
+        spip->state    = SPI_READY;
+        ws2812_pending = false;
+        spiStartSendI(spip, sizeof(txbufs[0]), txbuf);
+        txbuf = txbuf == txbufs[0] ? txbufs[1] : txbufs[0];
+    } else {
+        ws2812_busy = false;
+    }
+    osalSysUnlockFromISR();
+
+    if (!ws2812_busy) {
+        ws2812_transfer_complete_callback();
+    }
+}
+#    define WS2812_SPI_COMPLETE_CB ws2812_spi_complete_cb
+#else
+#    define WS2812_SPI_COMPLETE_CB NULL
+#endif
 
 /*
  * As the trick here is to use the SPI to send a huge pattern of 0 and 1 to
@@ -149,7 +187,7 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_CIRCULAR == TRUE
         WS2812_SPI_BUFFER_MODE,
 #    endif
-        NULL, // end_cb
+        WS2812_SPI_COMPLETE_CB, // end_cb
         PAL_PORT(WS2812_DI_PIN),
         PAL_PAD(WS2812_DI_PIN),
 #    if defined(WB32F3G71xx) || defined(WB32FQ95xx)
@@ -168,7 +206,7 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_SLAVE_MODE == TRUE
         false,
 #    endif
-        NULL, // data_cb
+        WS2812_SPI_COMPLETE_CB, // data_cb
         NULL, // error_cb
         PAL_PORT(WS2812_DI_PIN),
         PAL_PAD(WS2812_DI_PIN),
@@ -181,7 +219,7 @@ void ws2812_init(void) {
     spiStart(&WS2812_SPI, &spicfg); /* Setup transfer parameters.       */
     spiSelect(&WS2812_SPI);         /* Slave Select assertion.          */
 #ifdef WS2812_SPI_USE_CIRCULAR_BUFFER
-    spiStartSend(&WS2812_SPI, ARRAY_SIZE(txbuf), txbuf);
+    spiStartSend(&WS2812_SPI, sizeof(txbufs[0]), txbuf);
 #endif
 }
 
@@ -192,17 +230,32 @@ void ws2812_setleds(LED_TYPE* ledarray, uint16_t leds) {
         s_init = true;
     }
 
+#ifdef WS2812_SPI_DOUBLE_BUFFER
+    // A frame still waiting behind the current transfer is simply replaced
+    osalSysLock();
+    ws2812_pending = false;
+    osalSysUnlock();
+#endif
+
     for (uint8_t i = 0; i < leds; i++) {
         set_led_color_rgb(ledarray[i], i);
     }
 
-    // Send async - each led takes ~0.03ms, 50 leds ~1.5ms, animations flushing faster than send will cause issues.
-    // Instead spiSend can be used to send synchronously (or the thread logic can be added back).
+    // Send async - each led takes ~0.03ms, 50 leds ~1.5ms. Frames flushed faster than
+    // that are queued, only the newest one is sent once the current transfer completes.
 #ifndef WS2812_SPI_USE_CIRCULAR_BUFFER
 #    ifdef WS2812_SPI_SYNC
-    spiSend(&WS2812_SPI, ARRAY_SIZE(txbuf), txbuf);
+    spiSend(&WS2812_SPI, sizeof(txbufs[0]), txbuf);
 #    else
-    spiStartSend(&WS2812_SPI, ARRAY_SIZE(txbuf), txbuf);
+    osalSysLock();
+    if (ws2812_busy) {
+        ws2812_pending = true;
+    } else {
+        ws2812_busy = true;
+        spiStartSendI(&WS2812_SPI, sizeof(txbufs[0]), txbuf);
+        txbuf = txbuf == txbufs[0] ? txbufs[1] : txbufs[0];
+    }
+    osalSysUnlock();
 #    endif
 #endif
 }
@@ -43,3 +43,10 @@ typedef ioline_t pin_t;
 #define readPin(pin) palReadLine(pin)
 
 #define togglePin(pin) palToggleLine(pin)
+
+/* Whole port access, for reading several pins of the same port at once */
+typedef ioportmask_t port_data_t;
+
+#define readPort(pin) palReadPort(PAL_PORT(pin))
+#define getPortBit(pin) PAL_PAD(pin)
+#define isSamePort(pin_a, pin_b) (PAL_PORT(pin_a) == PAL_PORT(pin_b))
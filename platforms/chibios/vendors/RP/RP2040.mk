@@ -7,6 +7,10 @@ ifeq ($(strip $(WS2812_DRIVER)), vendor)
     OPT_DEFS += -DRP_DMA_REQUIRED=TRUE
 endif
 
+ifeq ($(strip $(MATRIX_DRIVER)), vendor)
+    OPT_DEFS += -DRP_DMA_REQUIRED=TRUE
+endif
+
 #
 # Raspberry Pi Pico SDK Support
 ##############################################################################
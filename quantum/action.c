@@ -76,6 +76,9 @@ void action_exec(keyevent_t event) {
         ac_dprintf("EVENT: ");
         debug_event(event);
         ac_dprintf("\n");
+#ifdef KEY_JOURNAL_ENABLE
+        key_journal_record_key_event(&event);
+#endif
 #if defined(RETRO_TAPPING) || defined(RETRO_TAPPING_PER_KEY) || (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT))
         retro_tapping_counter++;
 #endif
@@ -271,6 +274,10 @@ void process_record(keyrecord_t *record) {
         return;
     }
 
+#ifdef KEY_JOURNAL_ENABLE
+    key_journal_record_record(record);
+#endif
+
     if (!process_record_quantum(record)) {
 #ifndef NO_ACTION_ONESHOT
         if (is_oneshot_layer_active() && record->event.pressed && keymap_config.oneshot_enable) {
@@ -5,6 +5,7 @@
 #include "action_layer.h"
 #include "action_tapping.h"
 #include "keycode.h"
+#include "matrix.h"
 #include "timer.h"
 
 #ifndef NO_ACTION_TAPPING
@@ -64,21 +65,47 @@ static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE] = {};
 static uint8_t     waiting_buffer_head                 = 0;
 static uint8_t     waiting_buffer_tail                 = 0;
 
+/* Matrix positions with a press in the waiting buffer, so that releases can be
+ * matched without scanning it. Only once a key is pressed twice while waiting,
+ * or for keys outside the matrix, waiting_buffer_typed() falls back to a scan
+ * until the buffer has drained.
+ */
+static matrix_row_t waiting_buffer_presses[MATRIX_ROWS] = {};
+static bool         waiting_buffer_repeated             = false;
+
 static bool process_tapping(keyrecord_t *record);
+static void waiting_buffer_process(void);
 static bool waiting_buffer_enq(keyrecord_t record);
 static void waiting_buffer_clear(void);
 static bool waiting_buffer_typed(keyevent_t event);
+static void waiting_buffer_track(keyevent_t event);
+static void waiting_buffer_untrack(keyevent_t event);
 static bool waiting_buffer_has_anykey_pressed(void);
 static void waiting_buffer_scan_tap(void);
 static void debug_tapping_key(void);
 static void debug_waiting_buffer(void);
 
+/** \brief Whether the tapping decision differs from an earlier copy of it
+ */
+static bool tapping_key_changed(const keyrecord_t *previous) {
+    return !KEYEQ(previous->event.key, tapping_key.event.key) || previous->event.pressed != tapping_key.event.pressed || previous->event.time != tapping_key.event.time || previous->event.type != tapping_key.event.type || previous->tap.count != tapping_key.tap.count || previous->tap.interrupted != tapping_key.tap.interrupted
+#    if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+           || previous->keycode != tapping_key.keycode
+#    endif
+        ;
+}
+
 /** \brief Action Tapping Process
  *
- * FIXME: Needs doc
+ * Hands a key event, or a tick, to the tapping state machine. Events that have
+ * to wait for the tapping key to be decided are queued in the waiting buffer,
+ * which is worked through again once the decision changes.
  */
 void action_tapping_process(keyrecord_t record) {
-    if (process_tapping(&record)) {
+    const keyrecord_t previous  = tapping_key;
+    bool              processed = process_tapping(&record);
+
+    if (processed) {
         if (IS_EVENT(record.event)) {
             ac_dprintf("processed: ");
             debug_record(record);
@@ -86,32 +113,61 @@ void action_tapping_process(keyrecord_t record) {
         }
     } else {
         if (!waiting_buffer_enq(record)) {
-            // clear all in case of overflow.
-            ac_dprintf("OVERFLOW: CLEAR ALL STATES\n");
-            clear_keyboard();
-            waiting_buffer_clear();
-            tapping_key = (keyrecord_t){0};
+            if (tapping_key.event.pressed && tapping_key.tap.count == 0) {
+                // Enough keys were typed while the tapping key is down to call
+                // it a hold. Settle it, which lets the waiting events through.
+                ac_dprintf("Tapping: End. No tap. Waiting buffer is full\n");
+                process_record(&tapping_key);
+                tapping_key = (keyrecord_t){0};
+                debug_tapping_key();
+            }
+            waiting_buffer_process();
+            if (!waiting_buffer_enq(record)) {
+                // clear all in case of overflow.
+                ac_dprintf("OVERFLOW: CLEAR ALL STATES\n");
+                clear_keyboard();
+                waiting_buffer_clear();
+                tapping_key = (keyrecord_t){0};
+            }
         }
     }
 
+    // The oldest waiting event was left waiting for the tapping decision, so it
+    // only needs another look once the decision or the keyboard state changed
+    if (!tapping_key_changed(&previous) && !(processed && IS_EVENT(record.event))) {
+        return;
+    }
+
     // process waiting_buffer
     if (IS_EVENT(record.event) && waiting_buffer_head != waiting_buffer_tail) {
         ac_dprintf("---- action_exec: process waiting_buffer -----\n");
     }
-    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
-        if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
-            ac_dprintf("processed: waiting_buffer[%u] =", waiting_buffer_tail);
-            debug_record(waiting_buffer[waiting_buffer_tail]);
-            ac_dprintf("\n\n");
-        } else {
-            break;
-        }
-    }
+    waiting_buffer_process();
     if (IS_EVENT(record.event)) {
         ac_dprintf("\n");
     }
 }
 
+/** \brief Process waiting buffer
+ *
+ * Hands the waiting events to process_tapping() in order, until one of them
+ * has to wait for a tapping decision again.
+ */
+static void waiting_buffer_process(void) {
+    while (waiting_buffer_tail != waiting_buffer_head) {
+        if (!process_tapping(&waiting_buffer[waiting_buffer_tail])) {
+            return;
+        }
+        ac_dprintf("processed: waiting_buffer[%u] =", waiting_buffer_tail);
+        debug_record(waiting_buffer[waiting_buffer_tail]);
+        ac_dprintf("\n\n");
+
+        waiting_buffer_untrack(waiting_buffer[waiting_buffer_tail].event);
+        waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE;
+    }
+    waiting_buffer_clear();
+}
+
 /* Some conditionally defined helper macros to keep process_tapping more
  * readable. The conditional definition of tapping_keycode and all the
  * conditional uses of it are hidden inside macros named TAP_...
@@ -455,6 +511,7 @@ bool waiting_buffer_enq(keyrecord_t record) {
 
     waiting_buffer[waiting_buffer_head] = record;
     waiting_buffer_head                 = (waiting_buffer_head + 1) % WAITING_BUFFER_SIZE;
+    waiting_buffer_track(record.event);
 
     ac_dprintf("waiting_buffer_enq: ");
     debug_waiting_buffer();
@@ -463,18 +520,58 @@ bool waiting_buffer_enq(keyrecord_t record) {
 
 /** \brief Waiting buffer clear
  *
- * FIXME: Needs docs
+ * Empties the waiting buffer, along with the presses tracked for it.
  */
 void waiting_buffer_clear(void) {
     waiting_buffer_head = 0;
     waiting_buffer_tail = 0;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        waiting_buffer_presses[row] = 0;
+    }
+    waiting_buffer_repeated = false;
+}
+
+static inline bool waiting_buffer_trackable(keyevent_t event) {
+    return event.key.row < MATRIX_ROWS && event.key.col < MATRIX_COLS;
+}
+
+/** \brief Waiting buffer track
+ *
+ * Notes the press of a newly queued event.
+ */
+void waiting_buffer_track(keyevent_t event) {
+    if (!event.pressed || !waiting_buffer_trackable(event)) {
+        return;
+    }
+
+    matrix_row_t bit = (matrix_row_t)1 << event.key.col;
+    if (waiting_buffer_presses[event.key.row] & bit) {
+        waiting_buffer_repeated = true;
+    }
+    waiting_buffer_presses[event.key.row] |= bit;
+}
+
+/** \brief Waiting buffer untrack
+ *
+ * Forgets the press of an event leaving the buffer. Once a key was pressed
+ * twice, its bit has to stay set as another press may still be waiting.
+ */
+void waiting_buffer_untrack(keyevent_t event) {
+    if (event.pressed && !waiting_buffer_repeated && waiting_buffer_trackable(event)) {
+        waiting_buffer_presses[event.key.row] &= ~((matrix_row_t)1 << event.key.col);
+    }
 }
 
 /** \brief Waiting buffer typed
  *
- * FIXME: Needs docs
+ * Returns whether the press matching this release is still waiting in the
+ * buffer. Constant time, unless a key was pressed twice while waiting.
  */
 bool waiting_buffer_typed(keyevent_t event) {
+    if (!event.pressed && !waiting_buffer_repeated && waiting_buffer_trackable(event)) {
+        return (waiting_buffer_presses[event.key.row] & ((matrix_row_t)1 << event.key.col)) != 0;
+    }
+
     for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
         if (KEYEQ(event.key, waiting_buffer[i].event.key) && event.pressed != waiting_buffer[i].event.pressed) {
             return true;
@@ -496,7 +593,9 @@ __attribute__((unused)) bool waiting_buffer_has_anykey_pressed(void) {
 
 /** \brief Scan buffer for tapping
  *
- * FIXME: Needs docs
+ * Looks for the release of a newly started tapping key among the events that
+ * were queued behind it, and settles it as a tap if found. Only called when a
+ * tapping key starts, not for every event.
  */
 void waiting_buffer_scan_tap(void) {
     // early return if:
@@ -23,6 +23,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "keycode_config.h"
 #include <string.h>
 
+#ifdef KEY_JOURNAL_ENABLE
+#    include "key_journal.h"
+#endif
+
 extern keymap_config_t keymap_config;
 
 static uint8_t real_mods = 0;
@@ -283,6 +287,9 @@ void send_keyboard_report(void) {
 #endif
 
 #ifdef PROTOCOL_VUSB
+#    ifdef KEY_JOURNAL_ENABLE
+    key_journal_record_report(keyboard_report);
+#    endif
     host_keyboard_send(keyboard_report);
 #else
     static report_keyboard_t last_report;
@@ -290,6 +297,9 @@ void send_keyboard_report(void) {
     /* Only send the report if there are changes to propagate to the host. */
     if (memcmp(keyboard_report, &last_report, sizeof(report_keyboard_t)) != 0) {
         memcpy(&last_report, keyboard_report, sizeof(report_keyboard_t));
+#    ifdef KEY_JOURNAL_ENABLE
+        key_journal_record_report(keyboard_report);
+#    endif
         host_keyboard_send(keyboard_report);
     }
 #endif
@@ -0,0 +1,139 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "key_journal.h"
+#include <string.h>
+#include "timer.h"
+#include "print.h"
+#ifdef KEY_JOURNAL_RAW_HID_DRAIN
+#    include "raw_hid.h"
+#endif
+
+/* The journal is a ring of fixed size entries which overwrites its oldest
+ * entries when full. Recording only stores a timestamp and two data fields,
+ * all formatting is left to the host, and entries are only drained once the
+ * keyboard has been idle for KEY_JOURNAL_DRAIN_IDLE milliseconds so that
+ * draining does not skew the timings being measured.
+ */
+static key_journal_entry_t journal[KEY_JOURNAL_SIZE];
+static uint16_t            journal_head    = 0;
+static uint16_t            journal_count   = 0;
+static uint16_t            journal_dropped = 0;
+static bool                journal_meta    = true;
+static uint32_t            last_record     = 0;
+
+__attribute__((weak)) uint32_t key_journal_timestamp(void) {
+    return timer_read32();
+}
+
+void key_journal_record(key_journal_event_t type, uint8_t data8, uint16_t data16) {
+    key_journal_entry_t *entry = &journal[journal_head];
+
+    entry->timestamp = key_journal_timestamp();
+    entry->type      = type;
+    entry->data8     = data8;
+    entry->data16    = data16;
+
+    journal_head = (journal_head + 1) & (KEY_JOURNAL_SIZE - 1);
+    if (journal_count < KEY_JOURNAL_SIZE) {
+        journal_count++;
+    } else if (journal_dropped < UINT16_MAX) {
+        journal_dropped++;
+    }
+    last_record = timer_read32();
+}
+
+void key_journal_record_key_event(keyevent_t *event) {
+    key_journal_record(KEY_JOURNAL_KEY_EVENT, event->pressed, (uint16_t)event->key.row << 8 | event->key.col);
+}
+
+void key_journal_record_record(keyrecord_t *record) {
+    uint8_t data8 = record->event.pressed;
+#ifndef NO_ACTION_TAPPING
+    data8 |= (record->tap.count & 0x0F) << 1;
+    data8 |= record->tap.interrupted << 7;
+#endif
+    key_journal_record(KEY_JOURNAL_RECORD, data8, (uint16_t)record->event.key.row << 8 | record->event.key.col);
+}
+
+void key_journal_record_report(report_keyboard_t *report) {
+    key_journal_record(KEY_JOURNAL_REPORT, report->mods, has_anykey(report));
+}
+
+uint8_t key_journal_read(key_journal_entry_t *entries, uint8_t count) {
+    uint8_t read = 0;
+
+    if (journal_count == 0) {
+        return 0;
+    }
+
+    if (journal_meta && count > 0) {
+        entries[read].timestamp = KEY_JOURNAL_TICK_RATE;
+        entries[read].type      = KEY_JOURNAL_META;
+        entries[read].data8     = KEY_JOURNAL_VERSION;
+        entries[read].data16    = journal_dropped;
+        read++;
+        journal_meta    = false;
+        journal_dropped = 0;
+    }
+
+    uint16_t tail = (journal_head - journal_count) & (KEY_JOURNAL_SIZE - 1);
+    while (read < count && journal_count > 0) {
+        entries[read++] = journal[tail];
+        tail            = (tail + 1) & (KEY_JOURNAL_SIZE - 1);
+        journal_count--;
+    }
+
+    // Whatever is recorded after a complete drain is introduced by a new
+    // meta entry, so the host can pick up a capture at any point.
+    if (journal_count == 0) {
+        journal_meta = true;
+    }
+    return read;
+}
+
+uint16_t key_journal_count(void) {
+    return journal_count;
+}
+
+void key_journal_clear(void) {
+    journal_head    = 0;
+    journal_count   = 0;
+    journal_dropped = 0;
+    journal_meta    = true;
+}
+
+#ifdef KEY_JOURNAL_RAW_HID_DRAIN
+// Raw HID reports are always 32 bytes
+#    define KEY_JOURNAL_RAW_HID_SIZE 32
+
+/* Each packet starts with "KJ" and the number of entries it carries, followed
+ * by the raw entries and zero padding.
+ */
+static void key_journal_drain_raw_hid(void) {
+    uint8_t             packet[KEY_JOURNAL_RAW_HID_SIZE] = {'K', 'J'};
+    key_journal_entry_t entries[(KEY_JOURNAL_RAW_HID_SIZE - 3) / sizeof(key_journal_entry_t)];
+
+    packet[2] = key_journal_read(entries, sizeof(entries) / sizeof(entries[0]));
+    memcpy(&packet[3], entries, packet[2] * sizeof(key_journal_entry_t));
+    raw_hid_send(packet, sizeof(packet));
+}
+#endif
+
+void key_journal_task(void) {
+#if !defined(KEY_JOURNAL_MANUAL_DRAIN) && (defined(KEY_JOURNAL_RAW_HID_DRAIN) || defined(CONSOLE_ENABLE))
+    if (journal_count == 0 || timer_elapsed32(last_record) < KEY_JOURNAL_DRAIN_IDLE) {
+        return;
+    }
+
+#    ifdef KEY_JOURNAL_RAW_HID_DRAIN
+    key_journal_drain_raw_hid();
+#    else
+    key_journal_entry_t entries[KEY_JOURNAL_DRAIN_BATCH];
+    uint8_t             count = key_journal_read(entries, KEY_JOURNAL_DRAIN_BATCH);
+    for (uint8_t i = 0; i < count; i++) {
+        uprintf("KJ:%08lX%02X%02X%04X\n", (unsigned long)entries[i].timestamp, entries[i].type, entries[i].data8, entries[i].data16);
+    }
+#    endif
+#endif
+}
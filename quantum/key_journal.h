@@ -0,0 +1,86 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "action.h"
+#include "report.h"
+
+#ifndef KEY_JOURNAL_SIZE
+#    define KEY_JOURNAL_SIZE 128
+#endif
+
+#ifndef KEY_JOURNAL_TICK_RATE
+#    define KEY_JOURNAL_TICK_RATE 1000
+#endif
+
+#ifndef KEY_JOURNAL_DRAIN_IDLE
+#    define KEY_JOURNAL_DRAIN_IDLE 500
+#endif
+
+#ifndef KEY_JOURNAL_DRAIN_BATCH
+#    define KEY_JOURNAL_DRAIN_BATCH 4
+#endif
+
+#if (KEY_JOURNAL_SIZE & (KEY_JOURNAL_SIZE - 1)) != 0 || KEY_JOURNAL_SIZE > 32768
+#    error "KEY_JOURNAL_SIZE must be a power of two no larger than 32768"
+#endif
+
+#if defined(KEY_JOURNAL_RAW_HID_DRAIN) && !defined(RAW_ENABLE)
+#    error "KEY_JOURNAL_RAW_HID_DRAIN requires RAW_ENABLE = yes"
+#endif
+
+#define KEY_JOURNAL_VERSION 1
+
+/**
+ * @brief The kinds of entry recorded in the journal.
+ */
+typedef enum {
+    /** Start of a drain. timestamp: tick rate in Hz, data8: format version, data16: entries lost to overflow */
+    KEY_JOURNAL_META = 0,
+    /** action_exec() received a key event. data8: pressed, data16: row << 8 | col */
+    KEY_JOURNAL_KEY_EVENT,
+    /** The event left the tapping logic and was handed to process_record(). data8: pressed | tap count << 1 | interrupted << 7, data16: row << 8 | col */
+    KEY_JOURNAL_RECORD,
+    /** process_record_quantum() resolved the keycode. data8: pressed, data16: keycode */
+    KEY_JOURNAL_KEYCODE,
+    /** A keyboard report was handed to the host driver. data8: mods, data16: number of keys held */
+    KEY_JOURNAL_REPORT,
+} key_journal_event_t;
+
+typedef struct {
+    uint32_t timestamp;
+    uint8_t  type;
+    uint8_t  data8;
+    uint16_t data16;
+} key_journal_entry_t;
+
+/**
+ * @brief Timestamp source for the journal, in ticks of KEY_JOURNAL_TICK_RATE.
+ *
+ * Defaults to timer_read32(). Keyboards with a finer grained counter can
+ * override this, along with KEY_JOURNAL_TICK_RATE, to resolve sub-millisecond
+ * latencies.
+ */
+uint32_t key_journal_timestamp(void);
+
+void key_journal_record(key_journal_event_t type, uint8_t data8, uint16_t data16);
+void key_journal_record_key_event(keyevent_t *event);
+void key_journal_record_record(keyrecord_t *record);
+void key_journal_record_report(report_keyboard_t *report);
+
+/**
+ * @brief Removes up to `count` of the oldest entries from the journal.
+ *
+ * A drain starts with a KEY_JOURNAL_META entry, so the first call after new
+ * events were recorded returns one entry more than the journal holds.
+ *
+ * @return the number of entries written to `entries`
+ */
+uint8_t key_journal_read(key_journal_entry_t *entries, uint8_t count);
+
+uint16_t key_journal_count(void);
+void     key_journal_clear(void);
+void     key_journal_task(void);
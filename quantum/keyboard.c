@@ -96,6 +96,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef SLEEP_LED_ENABLE
 #    include "sleep_led.h"
 #endif
+#ifdef USB_SOF_SYNC_ENABLE
+#    include "usb_main.h"
+#endif
 #ifdef SPLIT_KEYBOARD
 #    include "split_util.h"
 #endif
@@ -496,6 +499,10 @@ static bool matrix_task(void) {
         return matrix_changed;
     }
 
+#ifdef USB_SOF_SYNC_ENABLE
+    usb_sof_sync_matrix_changed();
+#endif
+
     if (debug_config.matrix) {
         matrix_print();
     }
@@ -583,10 +590,18 @@ void quantum_task(void) {
     leader_task();
 #endif
 
+#if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_ASYNC_ENABLE)
+    send_string_async_task();
+#endif
+
 #ifdef WPM_ENABLE
     decay_wpm();
 #endif
 
+#ifdef KEY_JOURNAL_ENABLE
+    key_journal_task();
+#endif
+
 #ifdef HAPTIC_ENABLE
     haptic_task();
 #endif
@@ -7,6 +7,13 @@
 
 #include <string.h>
 
+#if __has_include("leader_data.h")
+#    include "quantum.h"
+#    define LEADER_DATA_IMPLEMENTATION
+#    include "leader_data.h"
+#    define LEADER_DATA_ENABLE
+#endif
+
 #ifndef LEADER_TIMEOUT
 #    define LEADER_TIMEOUT 300
 #endif
@@ -21,6 +28,67 @@ __attribute__((weak)) void leader_start_user(void) {}
 
 __attribute__((weak)) void leader_end_user(void) {}
 
+#ifdef LEADER_DATA_ENABLE
+enum {
+    LEADER_ACTION_NONE,
+    LEADER_ACTION_KEYCODE,
+    LEADER_ACTION_STRING,
+    LEADER_ACTION_USER,
+};
+
+#    define LEADER_NODE_ACTION(header) ((header) >> 12)
+#    define LEADER_NODE_CHILDREN(header) ((header)&0x0FFF)
+#    define LEADER_NODE_INVALID UINT16_MAX
+
+// Offset in leader_data of the node matching the keys typed so far
+static uint16_t leader_node = 0;
+
+__attribute__((weak)) void leader_sequence_user(uint16_t id) {}
+
+static void leader_node_run(uint16_t node) {
+    uint16_t header = pgm_read_word(&leader_data[node]);
+    uint16_t value  = pgm_read_word(&leader_data[node + 1]);
+
+    switch (LEADER_NODE_ACTION(header)) {
+        case LEADER_ACTION_KEYCODE:
+            tap_code16(value);
+            break;
+#    ifdef LEADER_DATA_STRING_COUNT
+        case LEADER_ACTION_STRING:
+            send_string_P((const char *)pgm_read_ptr(&leader_strings[value]));
+            break;
+#    endif
+        case LEADER_ACTION_USER:
+            leader_sequence_user(value);
+            break;
+    }
+}
+
+/* Follows the child of the current node for the keycode. Returns true once a
+ * sequence matched that is not the prefix of a longer one. Keys that leave the
+ * trie are still collected until the timeout, as they may form a sequence that
+ * leader_end_user() matches. */
+static bool leader_node_advance(uint16_t keycode) {
+    if (leader_node == LEADER_NODE_INVALID) {
+        return false;
+    }
+
+    uint16_t header   = pgm_read_word(&leader_data[leader_node]);
+    uint16_t children = LEADER_NODE_CHILDREN(header);
+    uint16_t link     = leader_node + 1 + (LEADER_NODE_ACTION(header) != LEADER_ACTION_NONE);
+
+    for (; children > 0; children--, link += 2) {
+        if (pgm_read_word(&leader_data[link]) == keycode) {
+            leader_node = pgm_read_word(&leader_data[link + 1]);
+            return LEADER_NODE_CHILDREN(pgm_read_word(&leader_data[leader_node])) == 0;
+        }
+    }
+
+    leader_node = LEADER_NODE_INVALID;
+    return false;
+}
+#endif
+
 void leader_start(void) {
     if (leading) {
         return;
@@ -30,10 +98,19 @@ void leader_start(void) {
     leader_time          = timer_read();
     leader_sequence_size = 0;
     memset(leader_sequence, 0, sizeof(leader_sequence));
+#ifdef LEADER_DATA_ENABLE
+    leader_node = 0;
+#endif
 }
 
 void leader_end(void) {
     leading = false;
+#ifdef LEADER_DATA_ENABLE
+    if (leader_node != LEADER_NODE_INVALID) {
+        leader_node_run(leader_node);
+    }
+    leader_node = LEADER_NODE_INVALID;
+#endif
     leader_end_user();
 }
 
@@ -61,6 +138,12 @@ bool leader_sequence_add(uint16_t keycode) {
     leader_sequence[leader_sequence_size] = keycode;
     leader_sequence_size++;
 
+#ifdef LEADER_DATA_ENABLE
+    if (leader_node_advance(keycode)) {
+        leader_end();
+    }
+#endif
+
     return true;
 }
 
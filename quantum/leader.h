@@ -21,6 +21,13 @@ void leader_start_user(void);
  */
 void leader_end_user(void);
 
+/**
+ * \brief User callback, invoked when a sequence of `leader_data.h` with an `@name` action is typed.
+ *
+ * \param id The `LEADER_<NAME>` value of the action.
+ */
+void leader_sequence_user(uint16_t id);
+
 /**
  * Begin the leader sequence, resetting the buffer and timer.
  */
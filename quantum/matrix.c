@@ -21,6 +21,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "matrix.h"
 #include "debounce.h"
 #include "quantum.h"
+#ifdef MATRIX_DRIVER_VENDOR
+#    include "matrix_driver.h"
+#endif
 #ifdef SPLIT_KEYBOARD
 #    include "split_common/split_util.h"
 #    include "split_common/transactions.h"
@@ -105,6 +108,58 @@ static inline uint8_t readMatrixPin(pin_t pin) {
 
 // matrix code
 
+#if defined(MATRIX_DRIVER_VENDOR) && !defined(DIRECT_PINS)
+#    if !defined(MATRIX_ROW_PINS) || !defined(MATRIX_COL_PINS)
+#        error MATRIX_DRIVER = vendor requires MATRIX_ROW_PINS and MATRIX_COL_PINS!
+#    endif
+#    if MATRIX_INPUT_PRESSED_STATE != 0
+#        error MATRIX_DRIVER = vendor only supports active low inputs!
+#    endif
+#    if (DIODE_DIRECTION != COL2ROW) && (DIODE_DIRECTION != ROW2COL)
+#        error DIODE_DIRECTION must be one of COL2ROW or ROW2COL!
+#    endif
+
+// Whether the hardware scanner accepted the pins, otherwise the matrix is scanned with GPIO
+static bool matrix_driver_active = false;
+
+static bool matrix_driver_start(void) {
+#    if (DIODE_DIRECTION == COL2ROW)
+    matrix_driver_active = matrix_driver_init(row_pins, ROWS_PER_HAND, col_pins, MATRIX_COLS);
+#    else
+    matrix_driver_active = matrix_driver_init(col_pins, MATRIX_COLS, row_pins, ROWS_PER_HAND);
+#    endif
+    if (!matrix_driver_active) {
+        dprintln("matrix: pins not supported by MATRIX_DRIVER = vendor, falling back to GPIO scanning");
+    }
+    return matrix_driver_active;
+}
+
+static void matrix_read_driver(matrix_row_t current_matrix[]) {
+#    if (DIODE_DIRECTION == COL2ROW)
+    uint32_t sense_states[ROWS_PER_HAND] = {0};
+    matrix_driver_read(sense_states);
+
+    for (uint8_t row_index = 0; row_index < ROWS_PER_HAND; row_index++) {
+        // Pin LO means pressed
+        current_matrix[row_index] = (matrix_row_t)(~sense_states[row_index] & ((1ULL << MATRIX_COLS) - 1));
+    }
+#    else
+    uint32_t sense_states[MATRIX_COLS] = {0};
+    matrix_driver_read(sense_states);
+
+    // Transpose the per column samples into rows
+    matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
+    for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++, row_shifter <<= 1) {
+        for (uint8_t row_index = 0; row_index < ROWS_PER_HAND; row_index++) {
+            if ((sense_states[col_index] & (1UL << row_index)) == 0) {
+                current_matrix[row_index] |= row_shifter;
+            }
+        }
+    }
+#    endif
+}
+#endif
+
 #ifdef DIRECT_PINS
 
 __attribute__((weak)) void matrix_init_pins(void) {
@@ -136,6 +191,78 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
 #    if defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS)
 #        if (DIODE_DIRECTION == COL2ROW)
 
+// Read the column pins a whole GPIO port at a time, if the platform supports it
+#            if defined(readPort) && !defined(MATRIX_DISABLE_PORT_READS)
+#                define MATRIX_READ_PORTS
+
+// A run of column pins on consecutive bits of the same port, mapped to consecutive columns
+typedef struct {
+    uint8_t     port_index; // index of the port in col_ports
+    uint8_t     port_bit;   // bit of the port holding the first column of the run
+    uint8_t     col_index;  // first column of the run
+    uint8_t     length;     // number of columns in the run
+    port_data_t mask;       // bits of the run, once the port is shifted down to the first column
+} matrix_col_run_t;
+
+static pin_t            col_ports[MATRIX_COLS]; // a column pin of each port, used to read the whole port
+static uint8_t          col_port_count = 0;
+static matrix_col_run_t col_runs[MATRIX_COLS];
+static uint8_t          col_run_count = 0;
+
+// Groups the column pins by port, so that reading a row takes one access per port rather than one per column
+static void matrix_plan_col_reads(void) {
+    col_port_count = 0;
+    col_run_count  = 0;
+    for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++) {
+        pin_t pin = col_pins[col_index];
+        if (pin == NO_PIN) {
+            continue; // never reads as pressed
+        }
+
+        uint8_t port_index = 0;
+        while (port_index < col_port_count && !isSamePort(col_ports[port_index], pin)) {
+            port_index++;
+        }
+        if (port_index == col_port_count) {
+            col_ports[col_port_count++] = pin;
+        }
+
+        // Extend the previous run if the pin is the next bit of the same port, otherwise start a new one
+        matrix_col_run_t *run = col_run_count ? &col_runs[col_run_count - 1] : NULL;
+        if (run && run->port_index == port_index && run->col_index + run->length == col_index && run->port_bit + run->length == getPortBit(pin)) {
+            run->mask = (run->mask << 1) | 1;
+            run->length++;
+        } else {
+            run             = &col_runs[col_run_count++];
+            run->port_index = port_index;
+            run->port_bit   = getPortBit(pin);
+            run->col_index  = col_index;
+            run->length     = 1;
+            run->mask       = 1;
+        }
+    }
+}
+
+// Reads the columns of the selected row
+static matrix_row_t matrix_read_cols(void) {
+    port_data_t port_values[MATRIX_COLS];
+    for (uint8_t port_index = 0; port_index < col_port_count; port_index++) {
+#                if MATRIX_INPUT_PRESSED_STATE == 0
+        port_values[port_index] = ~readPort(col_ports[port_index]);
+#                else
+        port_values[port_index] = readPort(col_ports[port_index]);
+#                endif
+    }
+
+    matrix_row_t row_value = 0;
+    for (uint8_t run_index = 0; run_index < col_run_count; run_index++) {
+        const matrix_col_run_t *run = &col_runs[run_index];
+        row_value |= (matrix_row_t)((port_values[run->port_index] >> run->port_bit) & run->mask) << run->col_index;
+    }
+    return row_value;
+}
+#            endif
+
 static bool select_row(uint8_t row) {
     pin_t pin = row_pins[row];
     if (pin != NO_PIN) {
@@ -163,6 +290,11 @@ static void unselect_rows(void) {
 }
 
 __attribute__((weak)) void matrix_init_pins(void) {
+#            ifdef MATRIX_DRIVER_VENDOR
+    if (matrix_driver_start()) {
+        return;
+    }
+#            endif
     unselect_rows();
     for (uint8_t x = 0; x < MATRIX_COLS; x++) {
         if (col_pins[x] != NO_PIN) {
@@ -180,6 +312,9 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     }
     matrix_output_select_delay();
 
+#            ifdef MATRIX_READ_PORTS
+    current_row_value = matrix_read_cols();
+#            else
     // For each col...
     matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
     for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++, row_shifter <<= 1) {
@@ -188,6 +323,7 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
         // Populate the matrix row with the state of the col pin
         current_row_value |= pin_state ? 0 : row_shifter;
     }
+#            endif
 
     // Unselect row
     unselect_row(current_row);
@@ -226,6 +362,11 @@ static void unselect_cols(void) {
 }
 
 __attribute__((weak)) void matrix_init_pins(void) {
+#            ifdef MATRIX_DRIVER_VENDOR
+    if (matrix_driver_start()) {
+        return;
+    }
+#            endif
     unselect_cols();
     for (uint8_t x = 0; x < ROWS_PER_HAND; x++) {
         if (row_pins[x] != NO_PIN) {
@@ -301,6 +442,9 @@ void matrix_init(void) {
 
     // initialize key pins
     matrix_init_pins();
+#ifdef MATRIX_READ_PORTS
+    matrix_plan_col_reads();
+#endif
 
     // initialize matrix state: all keys off
     memset(matrix, 0, sizeof(matrix));
@@ -322,18 +466,26 @@ __attribute__((weak)) bool transport_master_if_connected(matrix_row_t master_mat
 uint8_t matrix_scan(void) {
     matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
 
+#if defined(MATRIX_DRIVER_VENDOR) && !defined(DIRECT_PINS)
+    if (matrix_driver_active) {
+        // Read the latest snapshot of the hardware scanner
+        matrix_read_driver(curr_matrix);
+    } else
+#endif
+    {
 #if defined(DIRECT_PINS) || (DIODE_DIRECTION == COL2ROW)
-    // Set row, read cols
-    for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
-        matrix_read_cols_on_row(curr_matrix, current_row);
-    }
+        // Set row, read cols
+        for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
+            matrix_read_cols_on_row(curr_matrix, current_row);
+        }
 #elif (DIODE_DIRECTION == ROW2COL)
-    // Set col, read rows
-    matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
-    for (uint8_t current_col = 0; current_col < MATRIX_COLS; current_col++, row_shifter <<= 1) {
-        matrix_read_rows_on_col(curr_matrix, current_col, row_shifter);
-    }
+        // Set col, read rows
+        matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
+        for (uint8_t current_col = 0; current_col < MATRIX_COLS; current_col++, row_shifter <<= 1) {
+            matrix_read_rows_on_col(curr_matrix, current_col, row_shifter);
+        }
 #endif
+    }
 
     bool changed = memcmp(raw_matrix, curr_matrix, sizeof(curr_matrix)) != 0;
     if (changed) memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
@@ -7,14 +7,8 @@
 #include "deferred_exec.h"
 #include "lvgl.h"
 
-typedef struct lvgl_state_t {
-    uint8_t        fnc_id; // Ideally this should be the pointer of the function to run
-    uint16_t       delay_ms;
-    deferred_token defer_token;
-} lvgl_state_t;
-
-static deferred_executor_t lvgl_executors[2] = {0}; // For lv_tick_inc and lv_task_handler
-static lvgl_state_t        lvgl_states[2]    = {0}; // For lv_tick_inc and lv_task_handler
+static deferred_executor_t lvgl_executor    = {0}; // For lv_tick_inc and lv_timer_handler
+static deferred_token      lvgl_defer_token = INVALID_DEFERRED_TOKEN;
 
 painter_device_t selected_display = NULL;
 void *           color_buffer     = NULL;
@@ -32,25 +26,40 @@ void qp_lvgl_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color
     }
 }
 
-static uint32_t tick_task_callback(uint32_t trigger_time, void *cb_arg) {
-    lvgl_state_t *  state     = (lvgl_state_t *)cb_arg;
+static uint32_t lvgl_task_callback(uint32_t trigger_time, void *cb_arg) {
     static uint32_t last_tick = 0;
-    switch (state->fnc_id) {
-        case 0: {
-            uint32_t now = timer_read32();
-            lv_tick_inc(TIMER_DIFF_32(now, last_tick));
-            last_tick = now;
-        } break;
-        case 1:
-            lv_task_handler();
-            break;
-
-        default:
-            break;
+
+    uint32_t now = timer_read32();
+    lv_tick_inc(TIMER_DIFF_32(now, last_tick));
+    last_tick = now;
+
+    // LVGL reports how long until one of its timers is next due. It pauses its display refresh timer once every
+    // invalidated area has been drawn, and its animation timer once no animations are left.
+    uint32_t delay_ms = lv_timer_handler();
+
+    // Nothing left to do -- stop until an invalidation resumes a timer, see qp_lvgl_internal_tick
+    if (delay_ms == LV_NO_TIMER_READY) {
+        lvgl_defer_token = INVALID_DEFERRED_TOKEN;
+        return 0;
     }
 
-    // The tasks should run indefinitely
-    return state->delay_ms;
+    // Sleep until LVGL has something to do, but no longer than a refresh period while other timers are running
+    if (delay_ms < 1) {
+        return 1;
+    }
+    if (delay_ms > LV_DISP_DEF_REFR_PERIOD) {
+        return LV_DISP_DEF_REFR_PERIOD;
+    }
+    return delay_ms;
+}
+
+static bool lvgl_timers_running(void) {
+    for (lv_timer_t *timer = lv_timer_get_next(NULL); timer; timer = lv_timer_get_next(timer)) {
+        if (!timer->paused) {
+            return true;
+        }
+    }
+    return false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -67,24 +76,9 @@ bool qp_lvgl_attach(painter_device_t device) {
         return false;
     }
 
-    // Setting up the tasks
-    lvgl_state_t *lv_tick_inc_state = &lvgl_states[0];
-    lv_tick_inc_state->fnc_id       = 0;
-    lv_tick_inc_state->delay_ms     = 1;
-    lv_tick_inc_state->defer_token  = defer_exec_advanced(lvgl_executors, 2, 1, tick_task_callback, lv_tick_inc_state);
-
-    if (lv_tick_inc_state->defer_token == INVALID_DEFERRED_TOKEN) {
-        qp_dprintf("qp_lvgl_attach: fail (could not set up qp_lvgl executor)\n");
-        qp_lvgl_detach();
-        return false;
-    }
-
-    lvgl_state_t *lv_task_handler_state = &lvgl_states[1];
-    lv_task_handler_state->fnc_id       = 1;
-    lv_task_handler_state->delay_ms     = 5;
-    lv_task_handler_state->defer_token  = defer_exec_advanced(lvgl_executors, 2, 5, tick_task_callback, lv_task_handler_state);
-
-    if (lv_task_handler_state->defer_token == INVALID_DEFERRED_TOKEN) {
+    // Setting up the task
+    lvgl_defer_token = defer_exec_advanced(&lvgl_executor, 1, 1, lvgl_task_callback, NULL);
+    if (lvgl_defer_token == INVALID_DEFERRED_TOKEN) {
         qp_dprintf("qp_lvgl_attach: fail (could not set up qp_lvgl executor)\n");
         qp_lvgl_detach();
         return false;
@@ -95,8 +89,8 @@ bool qp_lvgl_attach(painter_device_t device) {
 
     // Set up lvgl display buffer
     static lv_disp_draw_buf_t draw_buf;
-    // Allocate a buffer for 1/10 screen size
-    const size_t count_required = driver->panel_width * driver->panel_height / 10;
+    // Allocate a buffer for a fraction of the screen size
+    const size_t count_required = driver->panel_width * driver->panel_height / QUANTUM_PAINTER_LVGL_BUFFER_DIVISOR;
     color_buffer                = color_buffer ? realloc(color_buffer, sizeof(lv_color_t) * count_required) : malloc(sizeof(lv_color_t) * count_required);
     if (!color_buffer) {
         qp_dprintf("qp_lvgl_attach: fail (could not set up memory buffer)\n");
@@ -128,9 +122,9 @@ bool qp_lvgl_attach(painter_device_t device) {
 // Quantum Painter LVGL Integration API: qp_lvgl_detach
 
 void qp_lvgl_detach(void) {
-    for (int i = 0; i < 2; ++i) {
-        cancel_deferred_exec_advanced(lvgl_executors, 2, lvgl_states[i].defer_token);
-    }
+    cancel_deferred_exec_advanced(&lvgl_executor, 1, lvgl_defer_token);
+    lvgl_defer_token = INVALID_DEFERRED_TOKEN;
+
     if (color_buffer) {
         free(color_buffer);
         color_buffer = NULL;
@@ -143,5 +137,11 @@ void qp_lvgl_detach(void) {
 
 void qp_lvgl_internal_tick(void) {
     static uint32_t last_lvgl_exec = 0;
-    deferred_exec_advanced_task(lvgl_executors, 2, &last_lvgl_exec);
+
+    // Invalidating an area resumes the display refresh timer, so restart the task if it stopped
+    if (selected_display && lvgl_defer_token == INVALID_DEFERRED_TOKEN && lvgl_timers_running()) {
+        lvgl_defer_token = defer_exec_advanced(&lvgl_executor, 1, 1, lvgl_task_callback, NULL);
+    }
+
+    deferred_exec_advanced_task(&lvgl_executor, 1, &last_lvgl_exec);
 }
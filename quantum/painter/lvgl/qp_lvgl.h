@@ -7,6 +7,16 @@
 #include "qp.h"
 #include "lvgl.h"
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter - LVGL configurables (add to your keyboard's config.h)
+
+#ifndef QUANTUM_PAINTER_LVGL_BUFFER_DIVISOR
+/**
+ * @def This controls the size of the LVGL draw buffer, as a fraction of the screen size.
+ */
+#    define QUANTUM_PAINTER_LVGL_BUFFER_DIVISOR 10
+#endif // QUANTUM_PAINTER_LVGL_BUFFER_DIVISOR
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter - LVGL External API
 
@@ -219,11 +219,17 @@ bool qgf_validate_delta_descriptor(qp_stream_t *stream, uint16_t frame_number) {
         return false;
     }
 
-    // Make sure this block is valid
-    if (!qgf_validate_block_header(&delta_descriptor.header, QGF_FRAME_DELTA_DESCRIPTOR_TYPEID, (sizeof(qgf_delta_v1_t) - sizeof(qgf_block_header_v1_t)))) {
+    // Make sure this block is valid, and holds at least one whole rect
+    if (!qgf_validate_block_header(&delta_descriptor.header, QGF_FRAME_DELTA_DESCRIPTOR_TYPEID, -1)) {
+        return false;
+    }
+    if (delta_descriptor.header.length == 0 || (delta_descriptor.header.length % sizeof(qgf_delta_rect_v1_t)) != 0) {
+        qp_dprintf("Invalid delta_descriptor length, %d is not a multiple of %d\n", (int)delta_descriptor.header.length, (int)sizeof(qgf_delta_rect_v1_t));
         return false;
     }
 
+    // Move forward in the stream to the next block
+    qp_stream_seek(stream, delta_descriptor.header.length, SEEK_CUR);
     return true;
 }
 
@@ -102,15 +102,21 @@ _Static_assert(sizeof(qgf_palette_v1_t) == sizeof(qgf_block_header_v1_t), "qgf_p
 
 #define QGF_FRAME_DELTA_DESCRIPTOR_TYPEID 0x04
 
+typedef struct QP_PACKED qgf_delta_rect_v1_t {
+    uint16_t left;   // The left pixel location to draw the delta image
+    uint16_t top;    // The top pixel location to draw the delta image
+    uint16_t right;  // The right pixel location to to draw the delta image
+    uint16_t bottom; // The bottom pixel location to to draw the delta image
+} qgf_delta_rect_v1_t;
+
+_Static_assert(sizeof(qgf_delta_rect_v1_t) == 8, "qgf_delta_rect_v1_t must be 8 bytes in v1 of QGF");
+
 typedef struct QP_PACKED qgf_delta_v1_t {
-    qgf_block_header_v1_t header; // = { .type_id = 0x04, .neg_type_id = (~0x04), .length = 8 }
-    uint16_t              left;   // The left pixel location to draw the delta image
-    uint16_t              top;    // The top pixel location to draw the delta image
-    uint16_t              right;  // The right pixel location to to draw the delta image
-    uint16_t              bottom; // The bottom pixel location to to draw the delta image
+    qgf_block_header_v1_t header;  // = { .type_id = 0x04, .neg_type_id = (~0x04), .length = (N * 8) }
+    qgf_delta_rect_v1_t   rect[0]; // N * rect, where N is the number of changed areas in the frame
 } qgf_delta_v1_t;
 
-_Static_assert(sizeof(qgf_delta_v1_t) == (sizeof(qgf_block_header_v1_t) + 8), "qgf_delta_v1_t must be 13 bytes in v1 of QGF");
+_Static_assert(sizeof(qgf_delta_v1_t) == sizeof(qgf_block_header_v1_t), "qgf_delta_v1_t must only contain qgf_block_header_v1_t in v1 of QGF");
 
 /////////////////////////////////////////
 // Frame data descriptor
@@ -80,6 +80,15 @@
 #    define QUANTUM_PAINTER_SUPPORTS_256_PALETTE FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_PALETTE_CACHE_SIZE
+/**
+ * @def The number of recently used foreground/background palettes kept converted to each display's native pixel format,
+ *      so that recolored text and images drawn repeatedly with the same colors skip the color conversion. Each entry
+ *      takes around 80 bytes of RAM. Palettes of more than 16 colors are not cached. Set to 0 to disable.
+ */
+#    define QUANTUM_PAINTER_PALETTE_CACHE_SIZE 4
+#endif
+
 #ifndef QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS
 /**
  * @def This controls whether the native color range is supported. This avoids the use of palettes but each image
@@ -88,6 +97,23 @@
 #    define QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_SUPPORTS_LZ
+/**
+ * @def This controls whether images and fonts compressed with QMK LZ are supported. Decoding requires a 256-byte
+ *      window of previously decoded data in RAM.
+ */
+#    define QUANTUM_PAINTER_SUPPORTS_LZ FALSE
+#endif
+
+#ifndef QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE
+/**
+ * @def The number of bytes read ahead in one transfer by each image or font loaded from external flash. Every image
+ *      and font slot holds a cache of this size when external flash is enabled, so larger values trade RAM for fewer
+ *      SPI transactions.
+ */
+#    define QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE 64
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter types
 
@@ -228,6 +254,25 @@ bool qp_setpixel(painter_device_t device, uint16_t x, uint16_t y, uint8_t hue, u
  */
 bool qp_line(painter_device_t device, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint8_t hue, uint8_t sat, uint8_t val);
 
+/**
+ * Draws an anti-aliased line, blending the pixels it partially covers between the foreground and background colors.
+ *
+ * @param device[in] the handle of the device to control
+ * @param x0[in] the device's x-position to start
+ * @param y0[in] the device's y-position to start
+ * @param x1[in] the device's x-position to finish
+ * @param y1[in] the device's y-position to finish
+ * @param hue_fg[in] the foreground hue to use, with 0-360 mapped to 0-255
+ * @param sat_fg[in] the foreground saturation to use, with 0-100% mapped to 0-255
+ * @param val_fg[in] the foreground value to use, with 0-100% mapped to 0-255
+ * @param hue_bg[in] the background hue to use, with 0-360 mapped to 0-255
+ * @param sat_bg[in] the background saturation to use, with 0-100% mapped to 0-255
+ * @param val_bg[in] the background value to use, with 0-100% mapped to 0-255
+ * @return true if drawing the line succeeded
+ * @return false if drawing the line failed
+ */
+bool qp_line_aa(painter_device_t device, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg);
+
 /**
  * Draws a rectangle using the specified color, optionally filled.
  *
@@ -261,6 +306,24 @@ bool qp_rect(painter_device_t device, uint16_t left, uint16_t top, uint16_t righ
  */
 bool qp_circle(painter_device_t device, uint16_t x, uint16_t y, uint16_t radius, uint8_t hue, uint8_t sat, uint8_t val, bool filled);
 
+/**
+ * Draws the outline of an anti-aliased circle, blending the pixels it partially covers between the foreground and background colors.
+ *
+ * @param device[in] the handle of the device to control
+ * @param x[in] the x-position of the centre of the circle to draw onto the device
+ * @param y[in] the y-position of the centre of the circle to draw onto the device
+ * @param radius[in] the radius of the circle to draw, below 4096
+ * @param hue_fg[in] the foreground hue to use, with 0-360 mapped to 0-255
+ * @param sat_fg[in] the foreground saturation to use, with 0-100% mapped to 0-255
+ * @param val_fg[in] the foreground value to use, with 0-100% mapped to 0-255
+ * @param hue_bg[in] the background hue to use, with 0-360 mapped to 0-255
+ * @param sat_bg[in] the background saturation to use, with 0-100% mapped to 0-255
+ * @param val_bg[in] the background value to use, with 0-100% mapped to 0-255
+ * @return true if drawing the circle succeeded
+ * @return false if drawing the circle failed
+ */
+bool qp_circle_aa(painter_device_t device, uint16_t x, uint16_t y, uint16_t radius, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg);
+
 /**
  * Draws a ellipse using the specified color, optionally filled.
  *
@@ -318,6 +381,21 @@ bool qp_pixdata(painter_device_t device, const void *pixel_data, uint32_t native
  */
 painter_image_handle_t qp_load_image_mem(const void *buffer);
 
+#ifdef FLASH_ENABLE
+/**
+ * Loads an image stored in external flash.
+ *
+ * @note Images can be unloaded by calling \ref qp_close_image. Only the image metadata is held in RAM, the image
+ *       data is read from flash when drawing.
+ *
+ * @param address[in] the address of the image data in external flash
+ * @return an image handle usable with \ref qp_drawimage, \ref qp_drawimage_recolor, \ref qp_animate, and
+ *         \ref qp_animate_recolor.
+ * @return NULL if loading the image failed
+ */
+painter_image_handle_t qp_load_image_flash(uint32_t address);
+#endif // FLASH_ENABLE
+
 /**
  * Closes an image handle when no longer in use.
  *
@@ -405,6 +483,32 @@ void qp_stop_animation(deferred_token anim_token);
  */
 painter_font_handle_t qp_load_font_mem(const void *buffer);
 
+#ifdef FLASH_ENABLE
+/**
+ * Loads a font stored in external flash.
+ *
+ * @note Fonts can be unloaded by calling \ref qp_close_font. The font data is read from flash when drawing, unless
+ *       \ref QUANTUM_PAINTER_LOAD_FONTS_TO_RAM is set to TRUE.
+ *
+ * @param address[in] the address of the font data in external flash
+ * @return an image handle usable with \ref qp_textwidth, \ref qp_drawtext, and \ref qp_drawtext_recolor.
+ * @return NULL if loading the font failed
+ */
+painter_font_handle_t qp_load_font_flash(uint32_t address);
+
+/**
+ * Looks up an asset in a bundle stored in external flash, as written by `qmk painter-make-bundle`.
+ *
+ * @param bundle_address[in] the address of the bundle in external flash
+ * @param index[in] the index of the asset within the bundle
+ * @param address[out] the address of the asset in external flash, usable with \ref qp_load_image_flash or
+ *                     \ref qp_load_font_flash
+ * @return true if the bundle is valid and contains the asset
+ * @return false if the bundle is invalid, or the index is out of range
+ */
+bool qp_find_bundle_asset_flash(uint32_t bundle_address, uint16_t index, uint32_t *address);
+#endif // FLASH_ENABLE
+
 /**
  * Closes a font handle when no longer in use.
  *
@@ -462,6 +566,18 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
 #    define RGB565_SURFACE_NUM_DEVICES 0
 #endif // QUANTUM_PAINTER_RGB565_SURFACE_ENABLE
 
+#ifdef QUANTUM_PAINTER_PALETTE_SURFACE_ENABLE
+#    include "qp_palette_surface.h"
+#else // QUANTUM_PAINTER_PALETTE_SURFACE_ENABLE
+#    define PALETTE_SURFACE_NUM_DEVICES 0
+#endif // QUANTUM_PAINTER_PALETTE_SURFACE_ENABLE
+
+#ifdef QUANTUM_PAINTER_VIRTUAL_DISPLAY_ENABLE
+#    include "qp_virtual_display.h"
+#else // QUANTUM_PAINTER_VIRTUAL_DISPLAY_ENABLE
+#    define VIRTUAL_DISPLAY_NUM_DEVICES 0
+#endif // QUANTUM_PAINTER_VIRTUAL_DISPLAY_ENABLE
+
 #ifdef QUANTUM_PAINTER_ILI9163_ENABLE
 #    include "qp_ili9163.h"
 #else // QUANTUM_PAINTER_ILI9163_ENABLE
@@ -27,6 +27,25 @@ bool qp_internal_setpixel_impl(painter_device_t device, uint16_t x, uint16_t y);
 // qp_rect internal implementation, but uses the global pixdata buffer with pre-converted native pixels.
 bool qp_internal_fillrect_helper_impl(painter_device_t device, uint16_t l, uint16_t t, uint16_t r, uint16_t b);
 
+// Accumulates pixels into horizontal or vertical runs, so that each run is sent with a single viewport and pixdata call.
+// Runs use the global pixdata buffer with pre-converted native pixels, which needs to hold enough pixels for the longest run.
+typedef struct qp_internal_span_t {
+    int16_t l, t, r, b;
+    bool    active;
+} qp_internal_span_t;
+
+// Adds a pixel to the span, sending the span first if the pixel does not extend it.
+bool qp_internal_span_pixel(painter_device_t device, qp_internal_span_t* span, int16_t x, int16_t y);
+
+// Adds a horizontal line to the span, merging it with the span if it is on the same row, otherwise sending the span first.
+bool qp_internal_span_hline(painter_device_t device, qp_internal_span_t* span, int16_t x0, int16_t x1, int16_t y);
+
+// Sends the span, if there is one.
+bool qp_internal_span_flush(painter_device_t device, qp_internal_span_t* span);
+
+// Sets a pixel to the given entry of the global pixel lookup table, which needs to have been converted to native pixels.
+bool qp_internal_setpixel_palette_impl(painter_device_t device, uint16_t x, uint16_t y, uint8_t palette_idx);
+
 // Convert from input pixel data + palette to equivalent pixels
 typedef int16_t (*qp_internal_byte_input_callback)(void* cb_arg);
 typedef bool (*qp_internal_pixel_output_callback)(qp_pixel_t* palette, uint8_t index, void* cb_arg);
@@ -44,11 +63,17 @@ extern qp_pixel_t qp_internal_global_pixel_lookup_table[16];
 #endif
 
 // Generates a color-interpolated lookup table based off the number of items, from foreground to background, for use with monochrome image rendering.
-// Returns true if a palette was created, false if the palette is reused.
-// As this uses a global, this may present a problem if using the same parameters but a different screen converts pixels -- use qp_internal_invalidate_palette() below to reset.
-bool qp_internal_interpolate_palette(qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, int16_t steps);
+// The lookup table is converted to the device's native pixels. Recently used palettes are cached already converted -- see QUANTUM_PAINTER_PALETTE_CACHE_SIZE.
+// Returns false if the conversion failed.
+bool qp_internal_interpolate_palette(painter_device_t device, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, int16_t steps);
 
-// Resets the global palette so that it can be regenerated. Only needed if the colors are identical, but a different display is used with a different internal pixel format.
+// Number of coverage levels used by the anti-aliased primitives, the lookup table always has room for 16 entries.
+#define QP_ANTIALIAS_LEVELS 16
+
+// Sets up the global lookup table with QP_ANTIALIAS_LEVELS entries from background to foreground, converted to native pixels.
+bool qp_internal_antialias_palette(painter_device_t device, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg);
+
+// Resets the global palette so that it can be regenerated. Needed whenever the lookup table is overwritten with anything other than an interpolated palette.
 void qp_internal_invalidate_palette(void);
 
 // Helper shared between image and font rendering -- sets up the global palette to match the palette block specified in the asset. Expects the stream to be positioned at the start of the block header.
@@ -63,6 +88,12 @@ enum qp_internal_rle_mode_t {
     NON_REPEATING_RUN,
 };
 
+enum qp_internal_lz_mode_t {
+    LZ_MARKER_BYTE,
+    LZ_LITERAL_RUN,
+    LZ_MATCH_RUN,
+};
+
 typedef struct qp_internal_byte_input_state_t {
     painter_device_t device;
     qp_stream_t*     src_stream;
@@ -73,6 +104,13 @@ typedef struct qp_internal_byte_input_state_t {
             enum qp_internal_rle_mode_t mode;
             uint8_t                     remain; // number of bytes remaining in the current mode
         } rle;
+        // LZ-specific
+        struct {
+            enum qp_internal_lz_mode_t mode;
+            uint8_t                    remain;   // number of bytes remaining in the current mode
+            uint16_t                   distance; // how far back in the window the current match copies from
+            uint8_t                    pos;      // write position in the window
+        } lz;
     };
 } qp_internal_byte_input_state_t;
 
@@ -8,22 +8,25 @@
 #include "qp_draw.h"
 
 // Utilize 8-way symmetry to draw circles
-static bool qp_circle_helper_impl(painter_device_t device, uint16_t centerx, uint16_t centery, uint16_t offsetx, uint16_t offsety, bool filled) {
+static bool qp_circle_helper_impl(painter_device_t device, qp_internal_span_t *spans, uint16_t centerx, uint16_t centery, uint16_t offsetx, uint16_t offsety, bool filled) {
     /*
     Circles have the property of 8-way symmetry, so eight pixels can be drawn
     for each computed [offsetx,offsety] given the center coordinates
     represented by [centerx,centery].
 
+    Each of the symmetrical points is accumulated into its own span, so that
+    consecutive points are sent as a single run: near the top and bottom of
+    the circle the runs are horizontal, near the sides they are vertical.
+
     For filled circles, we can draw horizontal lines between each pair of
-    pixels with the same final value of y.
+    pixels with the same final value of y. Lines on the same row as the
+    previous one are merged, so that each row is only sent once.
 
     Two special cases exist and have been optimized:
     1) offsetx == offsety (the final point), makes half the coordinates
     equivalent, so we can omit them (and the corresponding fill lines)
-    2) offsetx == 0 (the starting point) means that some horizontal lines
-    would be a single pixel in length, so we write individual pixels instead.
-    This also makes half the symmetrical points identical to their twins,
-    so we only need four points or two points and one line
+    2) offsetx == 0 (the starting point) makes half the symmetrical points
+    identical to their twins, so we only need four points or three lines
     */
 
     int16_t xpx = ((int16_t)centerx) + ((int16_t)offsetx);
@@ -35,87 +38,33 @@ static bool qp_circle_helper_impl(painter_device_t device, uint16_t centerx, uin
     int16_t ypy = ((int16_t)centery) + ((int16_t)offsety);
     int16_t ymy = ((int16_t)centery) - ((int16_t)offsety);
 
-    if (offsetx == 0) {
-        if (!qp_internal_setpixel_impl(device, centerx, ypy)) {
-            return false;
-        }
-        if (!qp_internal_setpixel_impl(device, centerx, ymy)) {
+    if (filled) {
+        if (!qp_internal_span_hline(device, &spans[0], xpx, xmx, ypy) || !qp_internal_span_hline(device, &spans[1], xpx, xmx, ymy)) {
             return false;
         }
-        if (filled) {
-            if (!qp_internal_fillrect_helper_impl(device, xpy, centery, xmy, centery)) {
-                return false;
-            }
-        } else {
-            if (!qp_internal_setpixel_impl(device, xpy, centery)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmy, centery)) {
-                return false;
-            }
-        }
-    } else if (offsetx == offsety) {
-        if (filled) {
-            if (!qp_internal_fillrect_helper_impl(device, xpy, ypy, xmy, ypy)) {
-                return false;
-            }
-            if (!qp_internal_fillrect_helper_impl(device, xpy, ymy, xmy, ymy)) {
+        if (offsetx != offsety) {
+            if (!qp_internal_span_hline(device, &spans[2], xpy, xmy, ypx)) {
                 return false;
             }
-        } else {
-            if (!qp_internal_setpixel_impl(device, xpy, ypy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmy, ypy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xpy, ymy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmy, ymy)) {
+            if (offsetx != 0 && !qp_internal_span_hline(device, &spans[3], xpy, xmy, ymx)) {
                 return false;
             }
         }
+        return true;
+    }
 
-    } else {
-        if (filled) {
-            if (!qp_internal_fillrect_helper_impl(device, xpx, ypy, xmx, ypy)) {
-                return false;
-            }
-            if (!qp_internal_fillrect_helper_impl(device, xpx, ymy, xmx, ymy)) {
-                return false;
-            }
-            if (!qp_internal_fillrect_helper_impl(device, xpy, ypx, xmy, ypx)) {
-                return false;
-            }
-            if (!qp_internal_fillrect_helper_impl(device, xpy, ymx, xmy, ymx)) {
-                return false;
-            }
-        } else {
-            if (!qp_internal_setpixel_impl(device, xpx, ypy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmx, ypy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xpx, ymy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmx, ymy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xpy, ypx)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmy, ypx)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xpy, ymx)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmy, ymx)) {
-                return false;
-            }
+    if (!qp_internal_span_pixel(device, &spans[0], xpx, ypy) || !qp_internal_span_pixel(device, &spans[1], xpx, ymy)) {
+        return false;
+    }
+    if (offsetx != 0 && (!qp_internal_span_pixel(device, &spans[2], xmx, ypy) || !qp_internal_span_pixel(device, &spans[3], xmx, ymy))) {
+        return false;
+    }
+    if (offsetx != offsety) {
+        if (!qp_internal_span_pixel(device, &spans[4], xpy, ypx) || !qp_internal_span_pixel(device, &spans[5], xmy, ypx)) {
+            return false;
+        }
+        if (offsetx != 0 && (!qp_internal_span_pixel(device, &spans[6], xpy, ymx) || !qp_internal_span_pixel(device, &spans[7], xmy, ymx))) {
+            return false;
         }
     }
 
@@ -145,8 +94,10 @@ bool qp_circle(painter_device_t device, uint16_t x, uint16_t y, uint16_t radius,
         return false;
     }
 
+    qp_internal_span_t spans[8] = {0};
+
     bool ret = true;
-    if (!qp_circle_helper_impl(device, x, y, xcalc, ycalc, filled)) {
+    if (!qp_circle_helper_impl(device, spans, x, y, xcalc, ycalc, filled)) {
         ret = false;
     }
 
@@ -159,14 +110,107 @@ bool qp_circle(painter_device_t device, uint16_t x, uint16_t y, uint16_t radius,
                 ycalc--;
                 err += ((xcalc - ycalc) << 1) + 1;
             }
-            if (!qp_circle_helper_impl(device, x, y, xcalc, ycalc, filled)) {
+            if (!qp_circle_helper_impl(device, spans, x, y, xcalc, ycalc, filled)) {
                 ret = false;
                 break;
             }
         }
     }
 
+    for (uint8_t i = 0; ret && i < 8; ++i) {
+        if (!qp_internal_span_flush(device, &spans[i])) {
+            ret = false;
+        }
+    }
+
     qp_dprintf("qp_circle: %s\n", ret ? "ok" : "fail");
     qp_comms_stop(device);
     return ret;
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_circle_aa
+
+static uint32_t qp_isqrt(uint32_t value) {
+    uint32_t root = 0;
+    uint32_t bit  = 1ul << 30;
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+// Utilize 8-way symmetry to draw the pixels of an anti-aliased circle with the given palette level
+static bool qp_circle_aa_helper_impl(painter_device_t device, uint16_t centerx, uint16_t centery, uint16_t offsetx, uint16_t offsety, uint8_t level) {
+    if (level == 0) {
+        // Background, leave the pixels as-is
+        return true;
+    }
+
+    int16_t xpx = ((int16_t)centerx) + ((int16_t)offsetx);
+    int16_t xmx = ((int16_t)centerx) - ((int16_t)offsetx);
+    int16_t xpy = ((int16_t)centerx) + ((int16_t)offsety);
+    int16_t xmy = ((int16_t)centerx) - ((int16_t)offsety);
+    int16_t ypx = ((int16_t)centery) + ((int16_t)offsetx);
+    int16_t ymx = ((int16_t)centery) - ((int16_t)offsetx);
+    int16_t ypy = ((int16_t)centery) + ((int16_t)offsety);
+    int16_t ymy = ((int16_t)centery) - ((int16_t)offsety);
+
+    return qp_internal_setpixel_palette_impl(device, xpx, ypy, level) && qp_internal_setpixel_palette_impl(device, xmx, ypy, level) && qp_internal_setpixel_palette_impl(device, xpx, ymy, level) && qp_internal_setpixel_palette_impl(device, xmx, ymy, level) && qp_internal_setpixel_palette_impl(device, xpy, ypx, level) && qp_internal_setpixel_palette_impl(device, xmy, ypx, level) && qp_internal_setpixel_palette_impl(device, xpy, ymx, level) && qp_internal_setpixel_palette_impl(device, xmy, ymx, level);
+}
+
+bool qp_circle_aa(painter_device_t device, uint16_t x, uint16_t y, uint16_t radius, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg) {
+    qp_dprintf("qp_circle_aa: entry\n");
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver->validate_ok) {
+        qp_dprintf("qp_circle_aa: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    // The squared radius is computed with 4 fractional bits, which needs to fit in 32 bits
+    if (radius >= 4096) {
+        qp_dprintf("qp_circle_aa: fail (radius too large)\n");
+        return false;
+    }
+
+    if (!qp_comms_start(device)) {
+        qp_dprintf("qp_circle_aa: fail (could not start comms)\n");
+        return false;
+    }
+
+    if (!qp_internal_antialias_palette(device, hue_fg, sat_fg, val_fg, hue_bg, sat_bg, val_bg)) {
+        qp_dprintf("qp_circle_aa: fail (could not convert pixels to native)\n");
+        qp_comms_stop(device);
+        return false;
+    }
+
+    // Walk the first octant, the coverage of the two pixels straddling the circle is its distance to them.
+    // The octant ends before the radius, except for a radius of 0, where the bound stops rr - offsetx^2 underflowing.
+    bool     ret = true;
+    uint32_t rr  = ((uint32_t)radius) * radius;
+    for (uint16_t offsetx = 0; ((uint32_t)offsetx) * offsetx <= rr; ++offsetx) {
+        uint32_t exact   = qp_isqrt((rr - ((uint32_t)offsetx) * offsetx) << 8);
+        uint16_t offsety = exact >> 4;
+        uint8_t  frac    = exact & 0x0F;
+        if (offsetx > offsety) {
+            break;
+        }
+        if (!qp_circle_aa_helper_impl(device, x, y, offsetx, offsety, (QP_ANTIALIAS_LEVELS - 1) - frac) || !qp_circle_aa_helper_impl(device, x, y, offsetx, offsety + 1, frac)) {
+            ret = false;
+            break;
+        }
+    }
+
+    qp_dprintf("qp_circle_aa: %s\n", ret ? "ok" : "fail");
+    qp_comms_stop(device);
+    return ret;
+}
@@ -54,12 +54,9 @@ bool qp_internal_decode_grayscale(painter_device_t device, uint32_t pixel_count,
 }
 
 bool qp_internal_decode_recolor(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, qp_internal_pixel_output_callback output_callback, void* output_arg) {
-    painter_driver_t* driver = (painter_driver_t*)device;
-    int16_t           steps  = 1 << bits_per_pixel; // number of items we need to interpolate
-    if (qp_internal_interpolate_palette(fg_hsv888, bg_hsv888, steps)) {
-        if (!driver->driver_vtable->palette_convert(device, steps, qp_internal_global_pixel_lookup_table)) {
-            return false;
-        }
+    int16_t steps = 1 << bits_per_pixel; // number of items we need to interpolate
+    if (!qp_internal_interpolate_palette(device, fg_hsv888, bg_hsv888, steps)) {
+        return false;
     }
 
     return qp_internal_decode_palette(device, pixel_count, bits_per_pixel, input_callback, input_arg, qp_internal_global_pixel_lookup_table, output_callback, output_arg);
@@ -125,6 +122,53 @@ static inline int16_t qp_drawimage_byte_rle_decoder(void* cb_arg) {
     return c;
 }
 
+#if QUANTUM_PAINTER_SUPPORTS_LZ
+// Previously decoded bytes, referenced by matches. Decoding is never nested, so a single window is shared.
+static uint8_t qp_internal_lz_window[256];
+
+static inline int16_t qp_drawimage_byte_lz_decoder(void* cb_arg) {
+    qp_internal_byte_input_state_t* state = (qp_internal_byte_input_state_t*)cb_arg;
+
+    // Work out if we're parsing the marker byte, and the match distance if it's a match
+    if (state->lz.mode == LZ_MARKER_BYTE) {
+        int16_t c = qp_stream_get(state->src_stream);
+        if (c < 0) {
+            return c;
+        }
+        if (c < 128) {
+            state->lz.mode   = LZ_LITERAL_RUN;
+            state->lz.remain = c + 1;
+        } else {
+            int16_t d = qp_stream_get(state->src_stream);
+            if (d < 0) {
+                return d;
+            }
+            state->lz.mode     = LZ_MATCH_RUN;
+            state->lz.remain   = c - 125;
+            state->lz.distance = d + 1;
+        }
+    }
+
+    // Literals come from the stream, matches from the window -- a match may overlap the bytes it produces
+    if (state->lz.mode == LZ_LITERAL_RUN) {
+        state->curr = qp_stream_get(state->src_stream);
+        if (state->curr < 0) {
+            return state->curr;
+        }
+    } else {
+        state->curr = qp_internal_lz_window[(uint8_t)(state->lz.pos - state->lz.distance)];
+    }
+    qp_internal_lz_window[state->lz.pos++] = state->curr;
+
+    // Swap back to querying the marker byte once the run is done
+    if (--state->lz.remain == 0) {
+        state->lz.mode = LZ_MARKER_BYTE;
+    }
+
+    return state->curr;
+}
+#endif // QUANTUM_PAINTER_SUPPORTS_LZ
+
 bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg) {
     qp_internal_pixel_output_state_t* state  = (qp_internal_pixel_output_state_t*)cb_arg;
     painter_driver_t*                 driver = (painter_driver_t*)state->device;
@@ -172,6 +216,13 @@ qp_internal_byte_input_callback qp_internal_prepare_input_state(qp_internal_byte
             input_state->rle.mode   = MARKER_BYTE;
             input_state->rle.remain = 0;
             return qp_drawimage_byte_rle_decoder;
+#if QUANTUM_PAINTER_SUPPORTS_LZ
+        case IMAGE_COMPRESSED_LZ:
+            input_state->lz.mode   = LZ_MARKER_BYTE;
+            input_state->lz.remain = 0;
+            input_state->lz.pos    = 0;
+            return qp_drawimage_byte_lz_decoder;
+#endif // QUANTUM_PAINTER_SUPPORTS_LZ
         default:
             return NULL;
     }
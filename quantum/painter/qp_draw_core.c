@@ -22,11 +22,27 @@ _Static_assert((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE > 0) && (QUANTUM_PAINTER_PIX
 // Buffer used for transmitting native pixel data to the downstream device.
 __attribute__((__aligned__(4))) uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
 
-// Static buffer to contain a generated color palette
+// Identifies the interpolated palette currently held in the global pixel lookup table, and the device it was converted for
 static bool                                       generated_palette = false;
+static painter_device_t                           generated_device  = NULL;
 static int16_t                                    generated_steps   = -1;
 __attribute__((__aligned__(4))) static qp_pixel_t interpolated_fg_hsv888;
 __attribute__((__aligned__(4))) static qp_pixel_t interpolated_bg_hsv888;
+
+#if QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
+// Recently used interpolated palettes, already converted to native pixels. Only palettes of up to 16 entries are cached.
+typedef struct qp_palette_cache_entry_t {
+    painter_device_t device;
+    qp_pixel_t       fg_hsv888;
+    qp_pixel_t       bg_hsv888;
+    int16_t          steps;
+    uint32_t         last_used; // zero if unused
+    qp_pixel_t       native[16];
+} qp_palette_cache_entry_t;
+
+static qp_palette_cache_entry_t palette_cache[QUANTUM_PAINTER_PALETTE_CACHE_SIZE];
+static uint32_t                 palette_cache_clock = 0;
+#endif // QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
 #if QUANTUM_PAINTER_SUPPORTS_256_PALETTE
 __attribute__((__aligned__(4))) qp_pixel_t qp_internal_global_pixel_lookup_table[256];
 #else
@@ -47,6 +63,74 @@ bool qp_internal_setpixel_impl(painter_device_t device, uint16_t x, uint16_t y)
     return driver->driver_vtable->viewport(device, x, y, x, y) && driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, 1);
 }
 
+// qp_setpixel internal implementation, using the supplied entry of the global pixel lookup table. Expects the lookup table to be converted to native pixels.
+bool qp_internal_setpixel_palette_impl(painter_device_t device, uint16_t x, uint16_t y, uint8_t palette_idx) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    driver->driver_vtable->append_pixels(device, qp_internal_global_pixdata_buffer, qp_internal_global_pixel_lookup_table, 0, 1, &palette_idx);
+    return qp_internal_setpixel_impl(device, x, y);
+}
+
+// Sends the accumulated run of pixels, if any
+bool qp_internal_span_flush(painter_device_t device, qp_internal_span_t *span) {
+    if (!span->active) {
+        return true;
+    }
+    span->active = false;
+    return qp_internal_fillrect_helper_impl(device, span->l, span->t, span->r, span->b);
+}
+
+// Extends the run of pixels if the pixel is adjacent to either end of it, otherwise sends the run and starts a new one
+bool qp_internal_span_pixel(painter_device_t device, qp_internal_span_t *span, int16_t x, int16_t y) {
+    if (span->active) {
+        if (x >= span->l && x <= span->r && y >= span->t && y <= span->b) {
+            // Already part of the run
+            return true;
+        }
+        if (span->t == span->b && y == span->t && (x == span->l - 1 || x == span->r + 1)) {
+            span->l = QP_MIN(span->l, x);
+            span->r = QP_MAX(span->r, x);
+            return true;
+        }
+        if (span->l == span->r && x == span->l && (y == span->t - 1 || y == span->b + 1)) {
+            span->t = QP_MIN(span->t, y);
+            span->b = QP_MAX(span->b, y);
+            return true;
+        }
+        if (!qp_internal_span_flush(device, span)) {
+            return false;
+        }
+    }
+
+    span->l      = x;
+    span->r      = x;
+    span->t      = y;
+    span->b      = y;
+    span->active = true;
+    return true;
+}
+
+// Merges the line with the run if both are on the same row and overlap or touch, otherwise sends the run and starts a new one
+bool qp_internal_span_hline(painter_device_t device, qp_internal_span_t *span, int16_t x0, int16_t x1, int16_t y) {
+    int16_t l = QP_MIN(x0, x1);
+    int16_t r = QP_MAX(x0, x1);
+    if (span->active && span->t == y && span->b == y && l <= span->r + 1 && r >= span->l - 1) {
+        span->l = QP_MIN(span->l, l);
+        span->r = QP_MAX(span->r, r);
+        return true;
+    }
+
+    if (!qp_internal_span_flush(device, span)) {
+        return false;
+    }
+
+    span->l      = l;
+    span->r      = r;
+    span->t      = y;
+    span->b      = y;
+    span->active = true;
+    return true;
+}
+
 // Fills the global native pixel buffer with equivalent pixels matching the supplied HSV
 void qp_internal_fill_pixdata(painter_device_t device, uint32_t num_pixels, uint8_t hue, uint8_t sat, uint8_t val) {
     painter_driver_t *driver            = (painter_driver_t *)device;
@@ -64,27 +148,26 @@ void qp_internal_fill_pixdata(painter_device_t device, uint32_t num_pixels, uint
     }
 }
 
-// Resets the global palette so that it can be regenerated. Only needed if the colors are identical, but a different display is used with a different internal pixel format.
+// Sets up the global pixel lookup table with 16 levels of coverage from background to foreground, converted to native pixels
+bool qp_internal_antialias_palette(painter_device_t device, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg) {
+    qp_pixel_t fg = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
+    qp_pixel_t bg = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
+    return qp_internal_interpolate_palette(device, fg, bg, QP_ANTIALIAS_LEVELS);
+}
+
+// Marks the global lookup table as no longer holding an interpolated palette, for when it has been overwritten with other colors. Cached conversions are unaffected.
 void qp_internal_invalidate_palette(void) {
     generated_palette = false;
+    generated_device  = NULL;
     generated_steps   = -1;
 }
 
-// Interpolates between two colors to generate a palette
-bool qp_internal_interpolate_palette(qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, int16_t steps) {
-    // Check if we need to generate a new palette -- if the input parameters match then assume the palette can stay unchanged.
-    // This may present a problem if using the same parameters but a different screen converts pixels -- use qp_internal_invalidate_palette() to reset.
-    if (generated_palette == true && generated_steps == steps && memcmp(&interpolated_fg_hsv888, &fg_hsv888, sizeof(fg_hsv888)) == 0 && memcmp(&interpolated_bg_hsv888, &bg_hsv888, sizeof(bg_hsv888)) == 0) {
-        // We already have the correct palette, no point regenerating it.
-        return false;
-    }
-
-    // Save the parameters so we know whether we can skip generation
-    generated_palette      = true;
-    generated_steps        = steps;
-    interpolated_fg_hsv888 = fg_hsv888;
-    interpolated_bg_hsv888 = bg_hsv888;
+static inline bool same_hsv888(qp_pixel_t a, qp_pixel_t b) {
+    return a.hsv888.h == b.hsv888.h && a.hsv888.s == b.hsv888.s && a.hsv888.v == b.hsv888.v;
+}
 
+// Interpolates between two colors into the global lookup table, without converting them
+static void interpolate_hsv888(qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, int16_t steps) {
     int16_t hue_fg = fg_hsv888.hsv888.h;
     int16_t hue_bg = bg_hsv888.hsv888.h;
 
@@ -103,7 +186,72 @@ bool qp_internal_interpolate_palette(qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888,
 
         qp_dprintf("qp_internal_interpolate_palette: %3d of %d -- H: %3d, S: %3d, V: %3d\n", (int)(i + 1), (int)steps, (int)qp_internal_global_pixel_lookup_table[i].hsv888.h, (int)qp_internal_global_pixel_lookup_table[i].hsv888.s, (int)qp_internal_global_pixel_lookup_table[i].hsv888.v);
     }
+}
+
+// Records which palette the global lookup table holds, so that drawing again with the same colors skips generation
+static void remember_palette(painter_device_t device, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, int16_t steps) {
+    generated_palette      = true;
+    generated_device       = device;
+    generated_steps        = steps;
+    interpolated_fg_hsv888 = fg_hsv888;
+    interpolated_bg_hsv888 = bg_hsv888;
+}
+
+#if QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
+// Copies a cached conversion of the palette into the global lookup table if there is one. Otherwise, supplies the least recently used entry to store the conversion in.
+static bool palette_cache_lookup(painter_device_t device, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, int16_t steps, qp_palette_cache_entry_t **victim) {
+    ++palette_cache_clock;
+    *victim = &palette_cache[0];
+    for (uint8_t i = 0; i < QUANTUM_PAINTER_PALETTE_CACHE_SIZE; ++i) {
+        qp_palette_cache_entry_t *entry = &palette_cache[i];
+        if (entry->last_used && entry->device == device && entry->steps == steps && same_hsv888(entry->fg_hsv888, fg_hsv888) && same_hsv888(entry->bg_hsv888, bg_hsv888)) {
+            entry->last_used = palette_cache_clock;
+            memcpy(qp_internal_global_pixel_lookup_table, entry->native, steps * sizeof(qp_pixel_t));
+            return true;
+        }
+        if (entry->last_used < (*victim)->last_used) {
+            *victim = entry;
+        }
+    }
+    return false;
+}
+#endif // QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
 
+// Interpolates between two colors to generate a palette, converted to native pixels for the device
+bool qp_internal_interpolate_palette(painter_device_t device, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, int16_t steps) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+
+    // If the lookup table already holds this palette for this device, there's nothing to do
+    if (generated_palette && generated_device == device && generated_steps == steps && same_hsv888(interpolated_fg_hsv888, fg_hsv888) && same_hsv888(interpolated_bg_hsv888, bg_hsv888)) {
+        return true;
+    }
+
+#if QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
+    qp_palette_cache_entry_t *entry = NULL;
+    if (steps <= 16 && palette_cache_lookup(device, fg_hsv888, bg_hsv888, steps, &entry)) {
+        remember_palette(device, fg_hsv888, bg_hsv888, steps);
+        return true;
+    }
+#endif // QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
+
+    interpolate_hsv888(fg_hsv888, bg_hsv888, steps);
+    if (!driver->driver_vtable->palette_convert(device, steps, qp_internal_global_pixel_lookup_table)) {
+        qp_internal_invalidate_palette();
+        return false;
+    }
+
+#if QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
+    if (entry) {
+        entry->device    = device;
+        entry->fg_hsv888 = fg_hsv888;
+        entry->bg_hsv888 = bg_hsv888;
+        entry->steps     = steps;
+        entry->last_used = palette_cache_clock;
+        memcpy(entry->native, qp_internal_global_pixel_lookup_table, steps * sizeof(qp_pixel_t));
+    }
+#endif // QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
+
+    remember_palette(device, fg_hsv888, bg_hsv888, steps);
     return true;
 }
 
@@ -185,8 +333,6 @@ bool qp_line(painter_device_t device, uint16_t x0, uint16_t y0, uint16_t x1, uin
         return false;
     }
 
-    qp_internal_fill_pixdata(device, 1, hue, sat, val);
-
     // draw angled line using Bresenham's algo
     int16_t x      = ((int16_t)x0);
     int16_t y      = ((int16_t)y0);
@@ -198,9 +344,13 @@ bool qp_line(painter_device_t device, uint16_t x0, uint16_t y0, uint16_t x1, uin
     int16_t e  = dx + dy;
     int16_t e2 = 2 * e;
 
+    // Consecutive pixels along the major axis are merged into runs, the longest of which is the whole line
+    qp_internal_fill_pixdata(device, QP_MAX(dx, -dy) + 1, hue, sat, val);
+    qp_internal_span_t span = {0};
+
     bool ret = true;
     while (x != x1 || y != y1) {
-        if (!qp_internal_setpixel_impl(device, x, y)) {
+        if (!qp_internal_span_pixel(device, &span, x, y)) {
             ret = false;
             break;
         }
@@ -215,7 +365,7 @@ bool qp_line(painter_device_t device, uint16_t x0, uint16_t y0, uint16_t x1, uin
         }
     }
     // draw the last pixel
-    if (!qp_internal_setpixel_impl(device, x, y)) {
+    if (ret && (!qp_internal_span_pixel(device, &span, x, y) || !qp_internal_span_flush(device, &span))) {
         ret = false;
     }
 
@@ -224,6 +374,75 @@ bool qp_line(painter_device_t device, uint16_t x0, uint16_t y0, uint16_t x1, uin
     return ret;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_line_aa
+
+static inline bool qp_line_aa_plot(painter_device_t device, bool steep, int16_t major, int16_t minor, uint8_t level) {
+    if (level == 0) {
+        // Background, leave the pixel as-is
+        return true;
+    }
+    return steep ? qp_internal_setpixel_palette_impl(device, minor, major, level) : qp_internal_setpixel_palette_impl(device, major, minor, level);
+}
+
+bool qp_line_aa(painter_device_t device, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg) {
+    if (x0 == x1 || y0 == y1) {
+        qp_dprintf("qp_line_aa(%d, %d, %d, %d): entry (deferring to qp_rect)\n", (int)x0, (int)y0, (int)x1, (int)y1);
+        bool ret = qp_rect(device, x0, y0, x1, y1, hue_fg, sat_fg, val_fg, true);
+        qp_dprintf("qp_line_aa(%d, %d, %d, %d): %s (deferred to qp_rect)\n", (int)x0, (int)y0, (int)x1, (int)y1, ret ? "ok" : "fail");
+        return ret;
+    }
+
+    qp_dprintf("qp_line_aa(%d, %d, %d, %d): entry\n", (int)x0, (int)y0, (int)x1, (int)y1);
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver->validate_ok) {
+        qp_dprintf("qp_line_aa: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    if (!qp_comms_start(device)) {
+        qp_dprintf("Failed to start comms in qp_line_aa\n");
+        return false;
+    }
+
+    if (!qp_internal_antialias_palette(device, hue_fg, sat_fg, val_fg, hue_bg, sat_bg, val_bg)) {
+        qp_dprintf("qp_line_aa: fail (could not convert pixels to native)\n");
+        qp_comms_stop(device);
+        return false;
+    }
+
+    // draw the line using Wu's algo, stepping along the major axis with the minor axis in 16.16 fixed point
+    int16_t dx     = ((int16_t)x1) - ((int16_t)x0);
+    int16_t dy     = ((int16_t)y1) - ((int16_t)y0);
+    bool    steep  = abs(dy) > abs(dx);
+    int16_t major  = steep ? ((int16_t)y0) : ((int16_t)x0);
+    int16_t end    = steep ? ((int16_t)y1) : ((int16_t)x1);
+    int16_t dmajor = steep ? dy : dx;
+    int32_t minor  = ((int32_t)(steep ? x0 : y0)) << 16;
+    int32_t slope  = (((int32_t)(steep ? dx : dy)) << 16) / abs(dmajor);
+    int16_t step   = dmajor > 0 ? 1 : -1;
+
+    bool ret = true;
+    while (true) {
+        // The coverage of the two pixels straddling the line is its distance to them, quantised to the palette levels
+        int16_t pos  = (int16_t)(minor >> 16);
+        uint8_t frac = (uint8_t)((minor >> 12) & 0x0F);
+        if (!qp_line_aa_plot(device, steep, major, pos, (QP_ANTIALIAS_LEVELS - 1) - frac) || !qp_line_aa_plot(device, steep, major, pos + 1, frac)) {
+            ret = false;
+            break;
+        }
+        if (major == end) {
+            break;
+        }
+        major += step;
+        minor += slope;
+    }
+
+    qp_comms_stop(device);
+    qp_dprintf("qp_line_aa(%d, %d, %d, %d): %s\n", (int)x0, (int)y0, (int)x1, (int)y1, ret ? "ok" : "fail");
+    return ret;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_rect
 
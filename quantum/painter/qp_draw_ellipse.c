@@ -7,16 +7,20 @@
 #include "qp_draw.h"
 
 // Utilize 4-way symmetry to draw an ellipse
-static bool qp_ellipse_helper_impl(painter_device_t device, uint16_t centerx, uint16_t centery, uint16_t offsetx, uint16_t offsety, bool filled) {
+static bool qp_ellipse_helper_impl(painter_device_t device, qp_internal_span_t *spans, uint16_t centerx, uint16_t centery, uint16_t offsetx, uint16_t offsety, bool filled) {
     /*
     Ellipses have the property of 4-way symmetry, so four pixels can be drawn
     for each computed [offsetx,offsety] given the center coordinates
     represented by [centerx,centery].
 
+    Each of the symmetrical points is accumulated into its own span, so that
+    consecutive points are sent as a single run.
+
     For filled ellipses, we can draw horizontal lines between each pair of
-    pixels with the same final value of y.
+    pixels with the same final value of y. Lines on the same row as the
+    previous one are merged, so that each row is only sent once.
 
-    When offsetx == 0 only two pixels can be drawn for filled or unfilled ellipses
+    When offsetx == 0 or offsety == 0 only two pixels can be drawn for unfilled ellipses
     */
 
     int16_t xpx = ((int16_t)centerx) + ((int16_t)offsetx);
@@ -24,31 +28,27 @@ static bool qp_ellipse_helper_impl(painter_device_t device, uint16_t centerx, ui
     int16_t ypy = ((int16_t)centery) + ((int16_t)offsety);
     int16_t ymy = ((int16_t)centery) - ((int16_t)offsety);
 
-    if (offsetx == 0) {
-        if (!qp_internal_setpixel_impl(device, xpx, ypy)) {
-            return false;
-        }
-        if (!qp_internal_setpixel_impl(device, xpx, ymy)) {
-            return false;
-        }
-    } else if (filled) {
-        if (!qp_internal_fillrect_helper_impl(device, xpx, ypy, xmx, ypy)) {
+    if (filled) {
+        if (!qp_internal_span_hline(device, &spans[0], xpx, xmx, ypy)) {
             return false;
         }
-        if (offsety > 0 && !qp_internal_fillrect_helper_impl(device, xpx, ymy, xmx, ymy)) {
+        if (offsety > 0 && !qp_internal_span_hline(device, &spans[1], xpx, xmx, ymy)) {
             return false;
         }
-    } else {
-        if (!qp_internal_setpixel_impl(device, xpx, ypy)) {
-            return false;
-        }
-        if (!qp_internal_setpixel_impl(device, xpx, ymy)) {
-            return false;
-        }
-        if (!qp_internal_setpixel_impl(device, xmx, ypy)) {
+        return true;
+    }
+
+    if (!qp_internal_span_pixel(device, &spans[0], xpx, ypy)) {
+        return false;
+    }
+    if (offsety > 0 && !qp_internal_span_pixel(device, &spans[1], xpx, ymy)) {
+        return false;
+    }
+    if (offsetx > 0) {
+        if (!qp_internal_span_pixel(device, &spans[2], xmx, ypy)) {
             return false;
         }
-        if (!qp_internal_setpixel_impl(device, xmx, ymy)) {
+        if (offsety > 0 && !qp_internal_span_pixel(device, &spans[3], xmx, ymy)) {
             return false;
         }
     }
@@ -67,24 +67,28 @@ bool qp_ellipse(painter_device_t device, uint16_t x, uint16_t y, uint16_t sizex,
         return false;
     }
 
-    int16_t aa = ((int16_t)sizex) * ((int16_t)sizex);
-    int16_t bb = ((int16_t)sizey) * ((int16_t)sizey);
-    int16_t fa = 4 * ((int16_t)aa);
-    int16_t fb = 4 * ((int16_t)bb);
+    // The error terms grow with the cube of the radii, so they need more than 16 bits
+    int32_t aa = ((int32_t)sizex) * ((int32_t)sizex);
+    int32_t bb = ((int32_t)sizey) * ((int32_t)sizey);
+    int32_t fa = 4 * aa;
+    int32_t fb = 4 * bb;
 
     int16_t dx = 0;
     int16_t dy = ((int16_t)sizey);
 
-    qp_internal_fill_pixdata(device, QP_MAX(sizex, sizey), hue, sat, val);
+    // Filled rows span the whole width of the ellipse
+    qp_internal_fill_pixdata(device, (QP_MAX(sizex, sizey) * 2) + 1, hue, sat, val);
 
     if (!qp_comms_start(device)) {
         qp_dprintf("qp_ellipse: fail (could not start comms)\n");
         return false;
     }
 
+    qp_internal_span_t spans[4] = {0};
+
     bool ret = true;
-    for (int16_t delta = (2 * bb) + (aa * (1 - (2 * sizey))); bb * dx <= aa * dy; dx++) {
-        if (!qp_ellipse_helper_impl(device, x, y, dx, dy, filled)) {
+    for (int32_t delta = (2 * bb) + (aa * (1 - (2 * sizey))); bb * dx <= aa * dy; dx++) {
+        if (!qp_ellipse_helper_impl(device, spans, x, y, dx, dy, filled)) {
             ret = false;
             break;
         }
@@ -98,8 +102,8 @@ bool qp_ellipse(painter_device_t device, uint16_t x, uint16_t y, uint16_t sizex,
     dx = sizex;
     dy = 0;
 
-    for (int16_t delta = (2 * aa) + (bb * (1 - (2 * sizex))); aa * dy <= bb * dx; dy++) {
-        if (!qp_ellipse_helper_impl(device, x, y, dx, dy, filled)) {
+    for (int32_t delta = (2 * aa) + (bb * (1 - (2 * sizex))); aa * dy <= bb * dx; dy++) {
+        if (!qp_ellipse_helper_impl(device, spans, x, y, dx, dy, filled)) {
             ret = false;
             break;
         }
@@ -110,6 +114,12 @@ bool qp_ellipse(painter_device_t device, uint16_t x, uint16_t y, uint16_t sizex,
         delta += aa * (4 * dy + 6);
     }
 
+    for (uint8_t i = 0; ret && i < 4; ++i) {
+        if (!qp_internal_span_flush(device, &spans[i])) {
+            ret = false;
+        }
+    }
+
     qp_dprintf("qp_ellipse: %s\n", ret ? "ok" : "fail");
     qp_comms_stop(device);
     return ret;
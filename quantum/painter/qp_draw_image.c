@@ -16,6 +16,9 @@ typedef struct qgf_image_handle_t {
     union {
         qp_stream_t        stream;
         qp_memory_stream_t mem_stream;
+#ifdef FLASH_ENABLE
+        qp_flash_stream_t flash_stream;
+#endif // FLASH_ENABLE
 #ifdef QP_STREAM_HAS_FILE_IO
         qp_file_stream_t file_stream;
 #endif // QP_STREAM_HAS_FILE_IO
@@ -85,6 +88,30 @@ painter_image_handle_t qp_load_image_mem(const void *buffer) {
     return qp_load_image_internal(image_mem_stream_factory, (void *)buffer);
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_load_image_flash
+
+#ifdef FLASH_ENABLE
+
+static inline bool image_flash_stream_factory(qgf_image_handle_t *image, void *arg) {
+    uint32_t address = *(uint32_t *)arg;
+
+    // Assume we can read the graphics descriptor
+    image->flash_stream = qp_make_flash_stream(address, sizeof(qgf_graphics_descriptor_v1_t));
+
+    // Update the length of the stream to match, and rewind to the start
+    image->flash_stream.length   = qgf_get_total_size(&image->stream);
+    image->flash_stream.position = 0;
+
+    return true;
+}
+
+painter_image_handle_t qp_load_image_flash(uint32_t address) {
+    return qp_load_image_internal(image_flash_stream_factory, &address);
+}
+
+#endif // FLASH_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_close_image
 
@@ -116,10 +143,8 @@ typedef struct qgf_frame_info_t {
     uint8_t               bpp;
     bool                  has_palette;
     bool                  is_delta;
-    uint16_t              left;
-    uint16_t              top;
-    uint16_t              right;
-    uint16_t              bottom;
+    uint16_t              delta_rect_count;  // number of changed areas drawn by a delta frame
+    uint32_t              delta_rect_offset; // stream position of the first of those areas
     uint16_t              delay;
 } qgf_frame_info_t;
 
@@ -147,9 +172,6 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
         return false;
     }
 
-    // Ensure we aren't reusing any palette
-    qp_internal_invalidate_palette();
-
     if (!qp_internal_bpp_capable(info->bpp)) {
         qp_dprintf("qp_drawimage_recolor: fail (image bpp too high (%d), check QUANTUM_PAINTER_SUPPORTS_256_PALETTE or QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS)\n", (int)info->bpp);
         qp_comms_stop(device);
@@ -157,32 +179,28 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
     }
 
     // Handle palette if needed
-    const uint16_t palette_entries  = 1u << info->bpp;
-    bool           needs_pixconvert = false;
+    const uint16_t palette_entries = 1u << info->bpp;
+    bool           converted       = true;
     if (info->has_palette) {
         // Load the palette from the stream
         if (!qp_internal_load_qgf_palette((qp_stream_t *)&qgf_image->stream, info->bpp)) {
             return false;
         }
 
-        needs_pixconvert = true;
-    } else {
-        if (info->bpp <= 8) {
-            // Interpolate from fg/bg
-            needs_pixconvert = qp_internal_interpolate_palette(fg_hsv888, bg_hsv888, palette_entries);
-        }
+        // Convert the palette to native format
+        converted = driver->driver_vtable->palette_convert(device, palette_entries, qp_internal_global_pixel_lookup_table);
+    } else if (info->bpp <= 8) {
+        // Interpolate from fg/bg, already converted to native format
+        converted = qp_internal_interpolate_palette(device, fg_hsv888, bg_hsv888, palette_entries);
     }
 
-    if (needs_pixconvert) {
-        // Convert the palette to native format
-        if (!driver->driver_vtable->palette_convert(device, palette_entries, qp_internal_global_pixel_lookup_table)) {
-            qp_dprintf("qp_drawimage_recolor: fail (could not convert pixels to native)\n");
-            qp_comms_stop(device);
-            return false;
-        }
+    if (!converted) {
+        qp_dprintf("qp_drawimage_recolor: fail (could not convert pixels to native)\n");
+        qp_comms_stop(device);
+        return false;
     }
 
-    // Handle delta if needed
+    // Handle delta if needed -- the rects are read as each one gets drawn, so just take note of where they are
     if (info->is_delta) {
         qgf_delta_v1_t delta_descriptor;
         if (qp_stream_read(&delta_descriptor, sizeof(qgf_delta_v1_t), 1, &qgf_image->stream) != 1) {
@@ -190,10 +208,11 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
             return false;
         }
 
-        info->left   = delta_descriptor.left;
-        info->top    = delta_descriptor.top;
-        info->right  = delta_descriptor.right;
-        info->bottom = delta_descriptor.bottom;
+        info->delta_rect_count  = delta_descriptor.header.length / sizeof(qgf_delta_rect_v1_t);
+        info->delta_rect_offset = qp_stream_tell(&qgf_image->stream);
+        qp_stream_seek(&qgf_image->stream, delta_descriptor.header.length, SEEK_CUR);
+    } else {
+        info->delta_rect_count = 1;
     }
 
     // Read the data block
@@ -232,28 +251,7 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
         return false;
     }
 
-    uint16_t l, t, r, b;
-    if (frame_info->is_delta) {
-        l = x + frame_info->left;
-        t = y + frame_info->top;
-        r = x + frame_info->right - 1;
-        b = y + frame_info->bottom - 1;
-    } else {
-        l = x;
-        t = y;
-        r = x + image->width - 1;
-        b = y + image->height - 1;
-    }
-    uint32_t pixel_count = ((uint32_t)(r - l + 1)) * (b - t + 1);
-
-    // Configure where we're going to be rendering to
-    if (!driver->driver_vtable->viewport(device, l, t, r, b)) {
-        qp_dprintf("qp_drawimage_recolor: fail (could not set viewport)\n");
-        qp_comms_stop(device);
-        return false;
-    }
-
-    // Set up the input state
+    // Set up the input state, shared by all the rects of a delta frame as their data is compressed together
     qp_internal_byte_input_state_t  input_state    = {.device = device, .src_stream = &qgf_image->stream};
     qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, frame_info->compression_scheme);
     if (input_callback == NULL) {
@@ -262,31 +260,65 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
         return false;
     }
 
-    bool ret = false;
-    if (frame_info->bpp <= 8) {
-        // Set up the output state
-        qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
+    bool ret = true;
+    for (uint16_t i = 0; ret && i < frame_info->delta_rect_count; ++i) {
+        uint16_t l, t, r, b;
+        if (frame_info->is_delta) {
+            // Grab the next rect, then return to where the pixel data left off
+            qgf_delta_rect_v1_t rect;
+            uint32_t            data_pos = qp_stream_tell(&qgf_image->stream);
+            qp_stream_setpos(&qgf_image->stream, frame_info->delta_rect_offset + i * sizeof(qgf_delta_rect_v1_t));
+            if (qp_stream_read(&rect, sizeof(qgf_delta_rect_v1_t), 1, &qgf_image->stream) != 1 || rect.left > rect.right || rect.top > rect.bottom || rect.right >= image->width || rect.bottom >= image->height) {
+                qp_dprintf("qp_drawimage_recolor: fail (invalid delta rect %d)\n", (int)i);
+                ret = false;
+                break;
+            }
+            qp_stream_setpos(&qgf_image->stream, data_pos);
+
+            l = x + rect.left;
+            t = y + rect.top;
+            r = x + rect.right;
+            b = y + rect.bottom;
+        } else {
+            l = x;
+            t = y;
+            r = x + image->width - 1;
+            b = y + image->height - 1;
+        }
+        uint32_t pixel_count = ((uint32_t)(r - l + 1)) * (b - t + 1);
 
-        // Decode the pixel data and stream to the display
-        ret = qp_internal_decode_palette(device, pixel_count, frame_info->bpp, input_callback, &input_state, qp_internal_global_pixel_lookup_table, qp_internal_pixel_appender, &output_state);
-        // Any leftovers need transmission as well.
-        if (ret && output_state.pixel_write_pos > 0) {
-            ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.pixel_write_pos);
+        // Configure where we're going to be rendering to
+        if (!driver->driver_vtable->viewport(device, l, t, r, b)) {
+            qp_dprintf("qp_drawimage_recolor: fail (could not set viewport)\n");
+            ret = false;
+            break;
         }
-    } else if (frame_info->bpp != driver->native_bits_per_pixel) {
-        // Prevent stuff like drawing 24bpp images on 16bpp displays
-        qp_dprintf("Image's bpp doesn't match the target display's native_bits_per_pixel\n");
-        return false;
-    } else {
-        // Set up the output state
-        qp_internal_byte_output_state_t output_state = {.device = device, .byte_write_pos = 0, .max_bytes = qp_internal_num_pixels_in_buffer(device) * driver->native_bits_per_pixel / 8};
-
-        // Stream the raw pixel data to the display
-        uint32_t byte_count = pixel_count * frame_info->bpp / 8;
-        ret                 = qp_internal_send_bytes(device, byte_count, input_callback, &input_state, qp_internal_byte_appender, &output_state);
-        // Any leftovers need transmission as well.
-        if (ret && output_state.byte_write_pos > 0) {
-            ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.byte_write_pos * 8 / driver->native_bits_per_pixel);
+
+        if (frame_info->bpp <= 8) {
+            // Set up the output state
+            qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
+
+            // Decode the pixel data and stream to the display
+            ret = qp_internal_decode_palette(device, pixel_count, frame_info->bpp, input_callback, &input_state, qp_internal_global_pixel_lookup_table, qp_internal_pixel_appender, &output_state);
+            // Any leftovers need transmission as well.
+            if (ret && output_state.pixel_write_pos > 0) {
+                ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.pixel_write_pos);
+            }
+        } else if (frame_info->bpp != driver->native_bits_per_pixel) {
+            // Prevent stuff like drawing 24bpp images on 16bpp displays
+            qp_dprintf("Image's bpp doesn't match the target display's native_bits_per_pixel\n");
+            ret = false;
+        } else {
+            // Set up the output state
+            qp_internal_byte_output_state_t output_state = {.device = device, .byte_write_pos = 0, .max_bytes = qp_internal_num_pixels_in_buffer(device) * driver->native_bits_per_pixel / 8};
+
+            // Stream the raw pixel data to the display
+            uint32_t byte_count = pixel_count * frame_info->bpp / 8;
+            ret                 = qp_internal_send_bytes(device, byte_count, input_callback, &input_state, qp_internal_byte_appender, &output_state);
+            // Any leftovers need transmission as well.
+            if (ret && output_state.byte_write_pos > 0) {
+                ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.byte_write_pos * 8 / driver->native_bits_per_pixel);
+            }
         }
     }
 
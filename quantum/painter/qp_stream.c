@@ -3,6 +3,10 @@
 
 #include "qp_stream.h"
 
+#ifdef FLASH_ENABLE
+#    include "flash_spi.h"
+#endif // FLASH_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Stream API
 
@@ -119,6 +123,96 @@ qp_memory_stream_t qp_make_memory_stream(void *buffer, int32_t length) {
     return stream;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// External flash streams
+
+#ifdef FLASH_ENABLE
+
+static inline int16_t flash_stream_get(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    if (s->position >= s->length) {
+        s->is_eof = true;
+        return STREAM_EOF;
+    }
+
+    // Refill the cache with as much as the stream has left, starting at the current position
+    if (s->position < s->cache_start || s->position >= s->cache_start + s->cache_length) {
+        int32_t length = s->length - s->position;
+        if (length > QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE) {
+            length = QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE;
+        }
+        if (flash_read_block(s->address + s->position, s->cache, length) != FLASH_STATUS_SUCCESS) {
+            s->cache_length = 0;
+            return STREAM_EOF;
+        }
+        s->cache_start  = s->position;
+        s->cache_length = length;
+    }
+
+    return s->cache[s->position++ - s->cache_start];
+}
+
+static inline bool flash_stream_put(qp_stream_t *stream, uint8_t c) {
+    // Assets in external flash are read-only.
+    return false;
+}
+
+static inline int flash_stream_seek(qp_stream_t *stream, int32_t offset, int origin) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+
+    // Handle as per fseek, the cache is kept as seeking within it is common when parsing
+    int32_t position = s->position;
+    switch (origin) {
+        case SEEK_SET:
+            position = offset;
+            break;
+        case SEEK_CUR:
+            position += offset;
+            break;
+        case SEEK_END:
+            position = s->length + offset;
+            break;
+        default:
+            return -1;
+    }
+
+    if (position < 0 || position > s->length) {
+        return -1;
+    }
+
+    s->position = position;
+    s->is_eof   = false;
+    return 0;
+}
+
+static inline int32_t flash_stream_tell(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    return s->position;
+}
+
+static inline bool flash_stream_is_eof(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    return s->is_eof;
+}
+
+static inline void flash_stream_close(qp_stream_t *stream) {
+    // No-op.
+}
+
+qp_flash_stream_t qp_make_flash_stream(uint32_t address, int32_t length) {
+    qp_flash_stream_t stream = {
+        .base         = {.get = flash_stream_get, .put = flash_stream_put, .seek = flash_stream_seek, .tell = flash_stream_tell, .is_eof = flash_stream_is_eof, .close = flash_stream_close},
+        .address      = address,
+        .length       = length,
+        .position     = 0,
+        .cache_start  = 0,
+        .cache_length = 0,
+    };
+    return stream;
+}
+
+#endif // FLASH_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // FILE streams
 
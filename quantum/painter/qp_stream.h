@@ -70,6 +70,26 @@ typedef struct qp_memory_stream_t {
 
 qp_memory_stream_t qp_make_memory_stream(void *buffer, int32_t length);
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// External flash streams
+
+#ifdef FLASH_ENABLE
+
+typedef struct qp_flash_stream_t {
+    qp_stream_t base;
+    uint32_t    address;      // address of the start of the stream in external flash
+    int32_t     length;
+    int32_t     position;
+    bool        is_eof;
+    int32_t     cache_start;  // stream position of the first cached byte
+    int32_t     cache_length; // number of valid bytes in the cache, zero if nothing has been read yet
+    uint8_t     cache[QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE];
+} qp_flash_stream_t;
+
+qp_flash_stream_t qp_make_flash_stream(uint32_t address, int32_t length);
+
+#endif // FLASH_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // FILE streams
 
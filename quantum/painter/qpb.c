@@ -0,0 +1,124 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Quantum Painter Bundle "QPB" File Format.
+// See https://docs.qmk.fm/#/quantum_painter_qpb for more information.
+
+#include "qpb.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// QPB API
+
+bool qpb_read_bundle_descriptor(qp_stream_t *stream, uint16_t *asset_count, uint32_t *total_bytes) {
+    // Seek to the start
+    qp_stream_setpos(stream, 0);
+
+    // Read and validate the bundle descriptor
+    qpb_bundle_descriptor_v1_t bundle_descriptor;
+    if (qp_stream_read(&bundle_descriptor, sizeof(qpb_bundle_descriptor_v1_t), 1, stream) != 1) {
+        qp_dprintf("Failed to read bundle_descriptor, expected length was not %d\n", (int)sizeof(qpb_bundle_descriptor_v1_t));
+        return false;
+    }
+
+    // Make sure this block is valid
+    if (!qgf_validate_block_header(&bundle_descriptor.header, QPB_BUNDLE_DESCRIPTOR_TYPEID, (sizeof(qpb_bundle_descriptor_v1_t) - sizeof(qgf_block_header_v1_t)))) {
+        return false;
+    }
+
+    // Make sure the magic and version are correct
+    if (bundle_descriptor.magic != QPB_MAGIC || bundle_descriptor.qpb_version != 0x01) {
+        qp_dprintf("Failed to validate bundle_descriptor, expected magic 0x%06X was 0x%06X, expected version = 0x%02X was 0x%02X\n", (int)QPB_MAGIC, (int)bundle_descriptor.magic, (int)0x01, (int)bundle_descriptor.qpb_version);
+        return false;
+    }
+
+    // Make sure the file length is valid
+    if (bundle_descriptor.neg_total_file_size != ~bundle_descriptor.total_file_size) {
+        qp_dprintf("Failed to validate bundle_descriptor, expected negated length 0x%08X was 0x%08X\n", (int)(~bundle_descriptor.total_file_size), (int)bundle_descriptor.neg_total_file_size);
+        return false;
+    }
+
+    // Copy out the required info
+    if (asset_count) {
+        *asset_count = bundle_descriptor.asset_count;
+    }
+    if (total_bytes) {
+        *total_bytes = bundle_descriptor.total_file_size;
+    }
+
+    return true;
+}
+
+bool qpb_read_asset_entry(qp_stream_t *stream, uint16_t index, uint32_t *offset, uint32_t *length) {
+    uint16_t asset_count;
+    uint32_t total_bytes;
+    if (!qpb_read_bundle_descriptor(stream, &asset_count, &total_bytes)) {
+        return false;
+    }
+
+    if (index >= asset_count) {
+        qp_dprintf("Failed to read asset entry, index %d is out of range (%d assets)\n", (int)index, (int)asset_count);
+        return false;
+    }
+
+    // Read and validate the asset table header
+    qpb_asset_table_v1_t asset_table;
+    if (qp_stream_read(&asset_table, sizeof(qpb_asset_table_v1_t), 1, stream) != 1) {
+        qp_dprintf("Failed to read asset_table, expected length was not %d\n", (int)sizeof(qpb_asset_table_v1_t));
+        return false;
+    }
+
+    if (!qgf_validate_block_header(&asset_table.header, QPB_ASSET_TABLE_TYPEID, (asset_count * sizeof(qpb_asset_entry_v1_t)))) {
+        return false;
+    }
+
+    // Skip straight to the requested entry
+    qpb_asset_entry_v1_t entry;
+    qp_stream_seek(stream, index * sizeof(qpb_asset_entry_v1_t), SEEK_CUR);
+    if (qp_stream_read(&entry, sizeof(qpb_asset_entry_v1_t), 1, stream) != 1) {
+        qp_dprintf("Failed to read asset entry %d\n", (int)index);
+        return false;
+    }
+
+    // Make sure the asset lies within the bundle
+    if (entry.offset > total_bytes || entry.length > total_bytes - entry.offset) {
+        qp_dprintf("Failed to validate asset entry %d, offset 0x%08X and length %d are outside the bundle\n", (int)index, (int)entry.offset, (int)entry.length);
+        return false;
+    }
+
+    if (offset) {
+        *offset = entry.offset;
+    }
+    if (length) {
+        *length = entry.length;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_find_bundle_asset_flash
+
+#ifdef FLASH_ENABLE
+
+bool qp_find_bundle_asset_flash(uint32_t bundle_address, uint16_t index, uint32_t *address) {
+    // The stream only needs to be as long as the bundle descriptor to read it
+    qp_flash_stream_t stream = qp_make_flash_stream(bundle_address, sizeof(qpb_bundle_descriptor_v1_t));
+    uint32_t          total_bytes;
+    if (!qpb_read_bundle_descriptor((qp_stream_t *)&stream, NULL, &total_bytes)) {
+        return false;
+    }
+
+    // Now that we know the length, look up the asset
+    stream.length = total_bytes;
+    uint32_t offset;
+    if (!qpb_read_asset_entry((qp_stream_t *)&stream, index, &offset, NULL)) {
+        return false;
+    }
+
+    if (address) {
+        *address = bundle_address + offset;
+    }
+    return true;
+}
+
+#endif // FLASH_ENABLE
@@ -0,0 +1,60 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// Quantum Painter Bundle "QPB" File Format.
+// See https://docs.qmk.fm/#/quantum_painter_qpb for more information.
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "qp_stream.h"
+#include "qp_internal.h"
+#include "qgf.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// QPB structures
+
+/////////////////////////////////////////
+// Bundle descriptor
+
+#define QPB_BUNDLE_DESCRIPTOR_TYPEID 0x00
+
+typedef struct QP_PACKED qpb_bundle_descriptor_v1_t {
+    qgf_block_header_v1_t header;              // = { .type_id = 0x00, .neg_type_id = (~0x00), .length = 14 }
+    uint32_t              magic : 24;          // constant, equal to 0x425051 ("QPB")
+    uint8_t               qpb_version;         // constant, equal to 0x01
+    uint32_t              total_file_size;     // total size of the entire file, starting at offset zero
+    uint32_t              neg_total_file_size; // negated value of total_file_size
+    uint16_t              asset_count;         // number of assets in the bundle
+} qpb_bundle_descriptor_v1_t;
+
+_Static_assert(sizeof(qpb_bundle_descriptor_v1_t) == (sizeof(qgf_block_header_v1_t) + 14), "qpb_bundle_descriptor_v1_t must be 19 bytes in v1 of QPB");
+
+#define QPB_MAGIC 0x425051
+
+/////////////////////////////////////////
+// Asset table
+
+#define QPB_ASSET_TABLE_TYPEID 0x01
+
+typedef struct QP_PACKED qpb_asset_entry_v1_t {
+    uint32_t offset; // offset of the asset, starting at the start of the bundle
+    uint32_t length; // length of the asset
+} qpb_asset_entry_v1_t;
+
+_Static_assert(sizeof(qpb_asset_entry_v1_t) == 8, "qpb_asset_entry_v1_t must be 8 bytes in v1 of QPB");
+
+typedef struct QP_PACKED qpb_asset_table_v1_t {
+    qgf_block_header_v1_t header;   // = { .type_id = 0x01, .neg_type_id = (~0x01), .length = (N * sizeof(qpb_asset_entry_v1_t)) }
+    qpb_asset_entry_v1_t  entry[0]; // '0' signifies that this struct is immediately followed by the asset entries
+} qpb_asset_table_v1_t;
+
+_Static_assert(sizeof(qpb_asset_table_v1_t) == sizeof(qgf_block_header_v1_t), "qpb_asset_table_v1_t must only contain qgf_block_header_v1_t in v1 of QPB");
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// QPB API
+
+bool qpb_read_bundle_descriptor(qp_stream_t *stream, uint16_t *asset_count, uint32_t *total_bytes);
+bool qpb_read_asset_entry(qp_stream_t *stream, uint16_t index, uint32_t *offset, uint32_t *length);
@@ -7,6 +7,8 @@ QUANTUM_PAINTER_LVGL_INTEGRATION ?= no
 # The list of permissible drivers that can be listed in QUANTUM_PAINTER_DRIVERS
 VALID_QUANTUM_PAINTER_DRIVERS := \
 	rgb565_surface \
+	palette_surface \
+	virtual_display \
 	ili9163_spi \
 	ili9341_spi \
 	ili9488_spi \
@@ -25,9 +27,11 @@ SRC += \
     $(QUANTUM_DIR)/color.c \
     $(QUANTUM_DIR)/painter/qp.c \
     $(QUANTUM_DIR)/painter/qp_internal.c \
+    $(QUANTUM_DIR)/painter/qp_comms.c \
     $(QUANTUM_DIR)/painter/qp_stream.c \
     $(QUANTUM_DIR)/painter/qgf.c \
     $(QUANTUM_DIR)/painter/qff.c \
+    $(QUANTUM_DIR)/painter/qpb.c \
     $(QUANTUM_DIR)/painter/qp_draw_core.c \
     $(QUANTUM_DIR)/painter/qp_draw_codec.c \
     $(QUANTUM_DIR)/painter/qp_draw_circle.c \
@@ -58,6 +62,20 @@ define handle_quantum_painter_driver
         SRC += \
             $(DRIVER_PATH)/painter/generic/qp_rgb565_surface.c \
 
+    else ifeq ($$(strip $$(CURRENT_PAINTER_DRIVER)),palette_surface)
+        OPT_DEFS += -DQUANTUM_PAINTER_PALETTE_SURFACE_ENABLE
+        COMMON_VPATH += \
+            $(DRIVER_PATH)/painter/generic
+        SRC += \
+            $(DRIVER_PATH)/painter/generic/qp_palette_surface.c \
+
+    else ifeq ($$(strip $$(CURRENT_PAINTER_DRIVER)),virtual_display)
+        OPT_DEFS += -DQUANTUM_PAINTER_VIRTUAL_DISPLAY_ENABLE
+        COMMON_VPATH += \
+            $(DRIVER_PATH)/painter/generic
+        SRC += \
+            $(DRIVER_PATH)/painter/generic/qp_virtual_display.c \
+
     else ifeq ($$(strip $$(CURRENT_PAINTER_DRIVER)),ili9163_spi)
         QUANTUM_PAINTER_NEEDS_COMMS_SPI := yes
         QUANTUM_PAINTER_NEEDS_COMMS_SPI_DC_RESET := yes
@@ -147,7 +165,6 @@ ifeq ($(strip $(QUANTUM_PAINTER_NEEDS_COMMS_SPI)), yes)
     QUANTUM_LIB_SRC += spi_master.c
     VPATH += $(DRIVER_PATH)/painter/comms
     SRC += \
-        $(QUANTUM_DIR)/painter/qp_comms.c \
         $(DRIVER_PATH)/painter/comms/qp_comms_spi.c
 
     ifeq ($(strip $(QUANTUM_PAINTER_NEEDS_COMMS_SPI_DC_RESET)), yes)
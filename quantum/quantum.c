@@ -252,6 +252,10 @@ bool process_record_quantum(keyrecord_t *record) {
     }
 #endif
 
+#ifdef KEY_JOURNAL_ENABLE
+    key_journal_record(KEY_JOURNAL_KEYCODE, record->event.pressed, keycode);
+#endif
+
 #ifdef VELOCIKEY_ENABLE
     if (velocikey_enabled() && record->event.pressed) {
         velocikey_accelerate();
@@ -225,6 +225,10 @@ extern layer_state_t layer_state;
 #    include "wpm.h"
 #endif
 
+#ifdef KEY_JOURNAL_ENABLE
+#    include "key_journal.h"
+#endif
+
 #ifdef USBPD_ENABLE
 #    include "usbpd.h"
 #endif
@@ -131,6 +131,17 @@ static uint32_t rgb_timer_buffer;
 static last_hit_t last_hit_buffer;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
+// keyframe interpolation
+#ifdef RGB_MATRIX_KEYFRAME_INTERVAL
+#    if RGB_MATRIX_KEYFRAME_INTERVAL <= RGB_MATRIX_LED_FLUSH_LIMIT
+#        error "RGB_MATRIX_KEYFRAME_INTERVAL must be greater than RGB_MATRIX_LED_FLUSH_LIMIT"
+#    endif
+static RGB      rgb_keyframe_from[RGB_MATRIX_LED_COUNT];
+static RGB      rgb_keyframe_to[RGB_MATRIX_LED_COUNT];
+static uint32_t rgb_flush_timer;
+static bool     rgb_keyframe_reached = true;
+#endif // RGB_MATRIX_KEYFRAME_INTERVAL
+
 // split rgb matrix
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
@@ -192,11 +203,18 @@ void rgb_matrix_update_pwm_buffers(void) {
 }
 
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_KEYFRAME_INTERVAL
+    // Effects draw the next keyframe, the drivers are updated by rgb_keyframe_tween()
+    if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
+        rgb_keyframe_to[index] = (RGB){.r = red, .g = green, .b = blue};
+    }
+#else
     rgb_matrix_driver.set_color(index, red, green, blue);
+#endif
 }
 
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
-#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+#if (defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)) || defined(RGB_MATRIX_KEYFRAME_INTERVAL)
     for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
         rgb_matrix_set_color(i, red, green, blue);
 #else
@@ -290,6 +308,30 @@ static bool rgb_matrix_none(effect_params_t *params) {
     return false;
 }
 
+#ifdef RGB_MATRIX_KEYFRAME_INTERVAL
+// Position between the previous and the next keyframe, 0 to 256
+static uint16_t rgb_keyframe_fraction(void) {
+    uint32_t elapsed = sync_timer_elapsed32(g_rgb_timer);
+    return elapsed >= RGB_MATRIX_KEYFRAME_INTERVAL ? 256 : elapsed * 256 / RGB_MATRIX_KEYFRAME_INTERVAL;
+}
+
+static inline RGB rgb_keyframe_blend(RGB from, RGB to, uint16_t fraction) {
+    if (fraction >= 256) {
+        return to;
+    }
+    return (RGB){.r = lerp8by8(from.r, to.r, fraction), .g = lerp8by8(from.g, to.g, fraction), .b = lerp8by8(from.b, to.b, fraction)};
+}
+
+static void rgb_keyframe_tween(uint16_t fraction) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        RGB rgb = rgb_keyframe_blend(rgb_keyframe_from[i], rgb_keyframe_to[i], fraction);
+        rgb_matrix_driver.set_color(i, rgb.r, rgb.g, rgb.b);
+    }
+    rgb_matrix_update_pwm_buffers();
+    rgb_keyframe_reached = fraction >= 256;
+}
+#endif // RGB_MATRIX_KEYFRAME_INTERVAL
+
 static void rgb_task_timers(void) {
 #if defined(RGB_MATRIX_KEYREACTIVE_ENABLED) || RGB_MATRIX_TIMEOUT > 0
     uint32_t deltaTime = sync_timer_elapsed32(rgb_timer_buffer);
@@ -318,14 +360,35 @@ static void rgb_task_timers(void) {
 
 static void rgb_task_sync(void) {
     eeconfig_flush_rgb_matrix(false);
+#ifdef RGB_MATRIX_KEYFRAME_INTERVAL
+    // next task, in between keyframes move the LEDs towards the last one rendered
+    if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_KEYFRAME_INTERVAL) {
+        if (!rgb_keyframe_reached) {
+            rgb_keyframe_tween(256);
+        }
+        rgb_task_state = STARTING;
+    } else if (!rgb_keyframe_reached && sync_timer_elapsed32(rgb_flush_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) {
+        rgb_flush_timer = sync_timer_read32();
+        rgb_keyframe_tween(rgb_keyframe_fraction());
+    }
+#else
     // next task
     if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
+#endif // RGB_MATRIX_KEYFRAME_INTERVAL
 }
 
 static void rgb_task_start(void) {
     // reset iter
     rgb_effect_params.iter = 0;
 
+#ifdef RGB_MATRIX_KEYFRAME_INTERVAL
+    // the next keyframe starts from what is shown now, in case the previous one was cut short
+    uint16_t fraction = rgb_keyframe_fraction();
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        rgb_keyframe_from[i] = rgb_keyframe_blend(rgb_keyframe_from[i], rgb_keyframe_to[i], fraction);
+    }
+#endif // RGB_MATRIX_KEYFRAME_INTERVAL
+
     // update double buffers
     g_rgb_timer = rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -401,8 +464,14 @@ static void rgb_task_flush(uint8_t effect) {
     rgb_last_effect = effect;
     rgb_last_enable = rgb_matrix_config.enable;
 
+#ifdef RGB_MATRIX_KEYFRAME_INTERVAL
+    // start moving towards the new keyframe, unless it is what is already shown
+    rgb_flush_timer      = sync_timer_read32();
+    rgb_keyframe_reached = rgb_keyframe_reached && memcmp(rgb_keyframe_from, rgb_keyframe_to, sizeof(rgb_keyframe_to)) == 0;
+#else
     // update pwm buffers
     rgb_matrix_update_pwm_buffers();
+#endif // RGB_MATRIX_KEYFRAME_INTERVAL
 
     // next task
     rgb_task_state = SYNCING;
@@ -505,6 +574,9 @@ void rgb_matrix_set_suspend_state(bool state) {
     if (state && !suspend_state) { // only run if turning off, and only once
         rgb_task_render(0);        // turn off all LEDs when suspending
         rgb_task_flush(0);         // and actually flash led state to LEDs
+#    ifdef RGB_MATRIX_KEYFRAME_INTERVAL
+        rgb_keyframe_tween(256); // without fading out
+#    endif
     }
     suspend_state = state;
 #endif
@@ -22,8 +22,13 @@
 #include "quantum_keycodes.h"
 #include "keycode.h"
 #include "action.h"
+#include "action_util.h"
 #include "wait.h"
 
+#if defined(SEND_STRING_ASYNC_ENABLE)
+#    include "timer.h"
+#endif
+
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
 #    include "audio.h"
 #    ifndef BELL_SOUND
@@ -143,9 +148,6 @@ __attribute__((weak)) const uint8_t ascii_to_keycode_lut[128] PROGMEM = {
 
 // clang-format on
 
-// Note: we bit-pack in "reverse" order to optimize loading
-#define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
-
 void send_string(const char *string) {
     send_string_with_delay(string, 0);
 }
@@ -326,3 +328,301 @@ void send_string_with_delay_P(const char *string, uint8_t interval) {
     }
 }
 #endif
+
+/* Taps are packed into as few keyboard reports as possible. Keys tapped by
+ * a report are released by the next one, which may also press the next
+ * group of keys. Hosts handle the keys released by a report before the
+ * pressed ones, and the pressed ones in ascending order, so taps are only
+ * grouped while their keycodes ascend and their modifiers match. Modifier
+ * changes get a report of their own, ahead of the keys they apply to.
+ */
+bool tap_packer_begin(tap_packer_t *packer) {
+    for (uint8_t i = 0; i < packer->count; i++) {
+        packer->released[i] = packer->keys[i];
+        del_key(packer->keys[i]);
+    }
+    packer->released_count = packer->count;
+    packer->count          = 0;
+    packer->changed        = packer->released_count > 0;
+    packer->closed         = false;
+    return packer->changed;
+}
+
+bool tap_packer_add(tap_packer_t *packer, uint8_t keycode, uint8_t mods, uint8_t max_keys) {
+    if (packer->closed) {
+        return false;
+    }
+
+    if (mods != packer->mods) {
+        if (!packer->count) {
+            del_mods(packer->mods);
+            add_mods(mods);
+            packer->mods    = mods;
+            packer->changed = true;
+        }
+        packer->closed = true;
+        return false;
+    }
+
+    bool fits = packer->count < max_keys && (!packer->count || keycode > packer->keys[packer->count - 1]);
+    // A key released by this report can't be pressed again by it.
+    for (uint8_t i = 0; i < packer->released_count; i++) {
+        fits &= packer->released[i] != keycode;
+    }
+    if (!fits) {
+        packer->closed = true;
+        return false;
+    }
+
+    add_key(keycode);
+    packer->keys[packer->count++] = keycode;
+    packer->changed               = true;
+    return true;
+}
+
+void tap_packer_release_mods(tap_packer_t *packer) {
+    if (packer->mods) {
+        del_mods(packer->mods);
+        packer->mods    = 0;
+        packer->changed = true;
+    }
+    packer->closed = true;
+}
+
+bool tap_packer_send(tap_packer_t *packer) {
+    bool sent = packer->changed;
+    if (sent) {
+        send_keyboard_report();
+    }
+    packer->changed = false;
+    packer->closed  = true;
+    return sent;
+}
+
+#if defined(SEND_STRING_ASYNC_ENABLE)
+/* Queued strings are decoded a few actions ahead of time, and the actions
+ * are turned into keyboard reports by a tap packer, at most one every
+ * SEND_STRING_ASYNC_INTERVAL milliseconds.
+ */
+enum {
+    ASYNC_TAP,
+    ASYNC_DOWN,
+    ASYNC_UP,
+    ASYNC_DELAY,
+#    if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+    ASYNC_BELL,
+#    endif
+};
+
+typedef struct {
+    uint8_t  type;
+    uint8_t  mods;  // modifiers a tap has to be sent with
+    uint16_t value; // keycode, or delay in milliseconds
+} async_action_t;
+
+typedef struct {
+    const char *string;
+    uint8_t     interval;
+    bool        progmem;
+} async_source_t;
+
+// A character decodes to at most a tap, a dead key space and an interval.
+#    define ASYNC_MAX_ACTIONS_PER_CHAR 3
+
+#    if SEND_STRING_ASYNC_LOOKAHEAD < ASYNC_MAX_ACTIONS_PER_CHAR
+#        error "SEND_STRING_ASYNC_LOOKAHEAD must be at least 3"
+#    endif
+
+static async_source_t async_sources[SEND_STRING_ASYNC_QUEUE_SIZE];
+static uint8_t        async_source_head  = 0;
+static uint8_t        async_source_count = 0;
+static async_action_t async_actions[SEND_STRING_ASYNC_LOOKAHEAD];
+static uint8_t        async_action_head  = 0;
+static uint8_t        async_action_count = 0;
+static tap_packer_t   async_packer;
+static uint16_t       async_timer      = 0;
+static uint16_t       async_wait       = 0;
+
+static char async_peek(async_source_t *source) {
+    return source->progmem ? pgm_read_byte(source->string) : *source->string;
+}
+
+static char async_next(async_source_t *source) {
+    char ascii_code = async_peek(source);
+    // Never step past the terminator, even for truncated sequences.
+    if (ascii_code) {
+        source->string++;
+    }
+    return ascii_code;
+}
+
+static void async_push(uint8_t type, uint8_t mods, uint16_t value) {
+    uint8_t index        = (async_action_head + async_action_count) % SEND_STRING_ASYNC_LOOKAHEAD;
+    async_actions[index] = (async_action_t){.type = type, .mods = mods, .value = value};
+    async_action_count++;
+}
+
+static void async_pop(void) {
+    async_action_head = (async_action_head + 1) % SEND_STRING_ASYNC_LOOKAHEAD;
+    async_action_count--;
+}
+
+static void async_refill(void) {
+    while (async_source_count > 0 && SEND_STRING_ASYNC_LOOKAHEAD - async_action_count >= ASYNC_MAX_ACTIONS_PER_CHAR) {
+        async_source_t *source     = &async_sources[async_source_head];
+        char            ascii_code = async_next(source);
+
+        if (!ascii_code) {
+            async_source_head = (async_source_head + 1) % SEND_STRING_ASYNC_QUEUE_SIZE;
+            async_source_count--;
+            continue;
+        }
+
+        if (ascii_code == SS_QMK_PREFIX) {
+            ascii_code = async_next(source);
+            if (ascii_code == SS_TAP_CODE) {
+                async_push(ASYNC_TAP, 0, (uint8_t)async_next(source));
+            } else if (ascii_code == SS_DOWN_CODE) {
+                async_push(ASYNC_DOWN, 0, (uint8_t)async_next(source));
+            } else if (ascii_code == SS_UP_CODE) {
+                async_push(ASYNC_UP, 0, (uint8_t)async_next(source));
+            } else if (ascii_code == SS_DELAY_CODE) {
+                uint16_t ms = 0;
+                while (isdigit(async_peek(source))) {
+                    ms *= 10;
+                    ms += async_next(source) - '0';
+                }
+                async_next(source); // delay terminator
+                async_push(ASYNC_DELAY, 0, ms);
+            }
+        } else {
+#    if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+            if (ascii_code == '\a') { // BEL
+                async_push(ASYNC_BELL, 0, 0);
+            } else
+#    endif
+            {
+                uint8_t keycode = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+                uint8_t mods    = 0;
+                if (PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code)) {
+                    mods |= MOD_BIT(KC_LEFT_SHIFT);
+                }
+                if (PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code)) {
+                    mods |= MOD_BIT(KC_RIGHT_ALT);
+                }
+                async_push(ASYNC_TAP, mods, keycode);
+                if (PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code)) {
+                    async_push(ASYNC_TAP, 0, KC_SPACE);
+                }
+            }
+        }
+
+        if (source->interval) {
+            async_push(ASYNC_DELAY, 0, source->interval);
+        }
+    }
+}
+
+static void async_enqueue(const char *string, uint8_t interval, bool progmem) {
+    while (async_source_count == SEND_STRING_ASYNC_QUEUE_SIZE) {
+        send_string_async_task();
+        wait_ms(1);
+    }
+
+    // Start typing on the next task call rather than a full interval later.
+    if (!send_string_async_busy()) {
+        async_timer = timer_read() - SEND_STRING_ASYNC_INTERVAL;
+    }
+
+    uint8_t index        = (async_source_head + async_source_count) % SEND_STRING_ASYNC_QUEUE_SIZE;
+    async_sources[index] = (async_source_t){.string = string, .interval = interval, .progmem = progmem};
+    async_source_count++;
+}
+
+void send_string_async_with_delay(const char *string, uint8_t interval) {
+    async_enqueue(string, interval, false);
+}
+
+#    if defined(__AVR__)
+void send_string_async_with_delay_P(const char *string, uint8_t interval) {
+    async_enqueue(string, interval, true);
+}
+#    endif
+
+bool send_string_async_busy(void) {
+    return async_source_count || async_action_count || async_packer.count || async_packer.mods || async_wait;
+}
+
+void send_string_async_flush(void) {
+    while (send_string_async_busy()) {
+        send_string_async_task();
+        wait_ms(1);
+    }
+}
+
+void send_string_async_cancel(void) {
+    async_source_count = 0;
+    async_action_count = 0;
+    async_wait         = 0;
+
+    tap_packer_begin(&async_packer);
+    tap_packer_release_mods(&async_packer);
+    tap_packer_send(&async_packer);
+}
+
+void send_string_async_task(void) {
+    if (async_wait) {
+        if (timer_elapsed(async_timer) < async_wait) {
+            return;
+        }
+        async_wait = 0;
+    } else if (timer_elapsed(async_timer) < SEND_STRING_ASYNC_INTERVAL) {
+        return;
+    }
+
+    async_refill();
+    if (!async_action_count && !async_packer.count && !async_packer.mods) {
+        return;
+    }
+
+    bool            released = tap_packer_begin(&async_packer);
+    async_action_t *action   = &async_actions[async_action_head];
+
+    if (async_action_count && action->type == ASYNC_TAP && IS_BASIC_KEYCODE(action->value)) {
+        while (async_action_count) {
+            action = &async_actions[async_action_head];
+            if (action->type != ASYNC_TAP || !IS_BASIC_KEYCODE(action->value) || !tap_packer_add(&async_packer, action->value, action->mods, SEND_STRING_ASYNC_MAX_KEYS)) {
+                break;
+            }
+            async_pop();
+        }
+    } else if (released || async_packer.mods) {
+        // Everything is released before anything other than a tap.
+        tap_packer_release_mods(&async_packer);
+    } else {
+        async_pop();
+        switch (action->type) {
+            case ASYNC_TAP:
+                tap_code(action->value);
+                break;
+            case ASYNC_DOWN:
+                register_code(action->value);
+                break;
+            case ASYNC_UP:
+                unregister_code(action->value);
+                break;
+            case ASYNC_DELAY:
+                async_wait = action->value;
+                break;
+#    if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+            case ASYNC_BELL:
+                PLAY_SONG(bell_song);
+                break;
+#    endif
+        }
+    }
+
+    tap_packer_send(&async_packer);
+    async_timer = timer_read();
+}
+#endif
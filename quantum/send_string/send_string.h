@@ -23,9 +23,13 @@
  * \{
  */
 
+#pragma once
+
 #include <stdint.h>
+#include <stdbool.h>
 
 #include "progmem.h"
+#include "report.h"
 #include "send_string_keycodes.h"
 
 // Look-Up Tables (LUTs) to convert ASCII character to keycode sequence.
@@ -34,6 +38,9 @@ extern const uint8_t ascii_to_altgr_lut[16];
 extern const uint8_t ascii_to_dead_lut[16];
 extern const uint8_t ascii_to_keycode_lut[128];
 
+// Note: we bit-pack in "reverse" order to optimize loading
+#define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
+
 // clang-format off
 #define KCLUT_ENTRY(a, b, c, d, e, f, g, h) \
     ( ((a) ? 1 : 0) << 0 \
@@ -151,4 +158,131 @@ void send_string_with_delay_P(const char *string, uint8_t interval);
  */
 #define SEND_STRING_DELAY(string, interval) send_string_with_delay_P(PSTR(string), interval)
 
+/**
+ * \brief State for packing taps of basic keycodes into as few keyboard reports as possible.
+ */
+typedef struct {
+    uint8_t keys[KEYBOARD_REPORT_KEYS];     // keys pressed by the report being built
+    uint8_t count;
+    uint8_t released[KEYBOARD_REPORT_KEYS]; // keys released by the report being built
+    uint8_t released_count;
+    uint8_t mods;
+    bool    changed;
+    bool    closed;
+} tap_packer_t;
+
+/**
+ * \brief Starts the next report, which releases the keys tapped by the previous one.
+ *
+ * \return Whether any keys were released.
+ */
+bool tap_packer_begin(tap_packer_t *packer);
+
+/**
+ * \brief Adds a tap to the report being built.
+ *
+ * A tap whose modifiers differ from the held ones changes them instead, if no keys were pressed by this report yet.
+ *
+ * \param keycode The basic keycode to tap.
+ * \param mods The modifiers the key has to be sent with.
+ * \param max_keys The maximum number of keys per report, at most `KEYBOARD_REPORT_KEYS`.
+ *
+ * \return `false` if the tap has to wait for a later report.
+ */
+bool tap_packer_add(tap_packer_t *packer, uint8_t keycode, uint8_t mods, uint8_t max_keys);
+
+/**
+ * \brief Releases the held modifiers with the report being built.
+ */
+void tap_packer_release_mods(tap_packer_t *packer);
+
+/**
+ * \brief Sends the report being built, if it changes anything.
+ *
+ * \return Whether a report was sent.
+ */
+bool tap_packer_send(tap_packer_t *packer);
+
+#if defined(SEND_STRING_ASYNC_ENABLE) || defined(__DOXYGEN__)
+#    ifndef SEND_STRING_ASYNC_QUEUE_SIZE
+#        define SEND_STRING_ASYNC_QUEUE_SIZE 4
+#    endif
+#    ifndef SEND_STRING_ASYNC_LOOKAHEAD
+#        define SEND_STRING_ASYNC_LOOKAHEAD 8
+#    endif
+#    ifndef SEND_STRING_ASYNC_MAX_KEYS
+#        ifdef RING_BUFFERED_6KRO_REPORT_ENABLE
+#            define SEND_STRING_ASYNC_MAX_KEYS 1
+#        else
+#            define SEND_STRING_ASYNC_MAX_KEYS 6
+#        endif
+#    endif
+#    if SEND_STRING_ASYNC_MAX_KEYS > KEYBOARD_REPORT_KEYS
+#        error "SEND_STRING_ASYNC_MAX_KEYS must be at most 6"
+#    endif
+#    ifndef SEND_STRING_ASYNC_INTERVAL
+#        ifdef USB_POLLING_INTERVAL_MS
+#            define SEND_STRING_ASYNC_INTERVAL USB_POLLING_INTERVAL_MS
+#        else
+#            define SEND_STRING_ASYNC_INTERVAL 1
+#        endif
+#    endif
+
+/**
+ * \brief Queue a string of ASCII characters to be typed out in the background.
+ *
+ * The string is decoded and sent by `send_string_async_task()`, one keyboard report at a time, so the keyboard keeps scanning while it is typed out. Consecutive characters with ascending keycodes and the same modifiers are packed into a single report.
+ *
+ * The string is not copied, it must remain valid until it has been typed out. If the queue is full, this call blocks until there is room.
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ */
+void send_string_async_with_delay(const char *string, uint8_t interval);
+
+/**
+ * \brief Returns whether queued strings are still being typed out.
+ */
+bool send_string_async_busy(void);
+
+/**
+ * \brief Blocks until all queued strings have been typed out.
+ */
+void send_string_async_flush(void);
+
+/**
+ * \brief Discards all queued strings and releases any keys held by them.
+ */
+void send_string_async_cancel(void);
+
+/**
+ * \brief Sends the next report of the queued strings, if due. Called from `keyboard_task()`.
+ */
+void send_string_async_task(void);
+
+#    if defined(__AVR__) || defined(__DOXYGEN__)
+/**
+ * \brief Queue a PROGMEM string of ASCII characters to be typed out in the background.
+ *
+ * On ARM devices, this function is simply an alias for send_string_async_with_delay(string, interval).
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ */
+void send_string_async_with_delay_P(const char *string, uint8_t interval);
+#    else
+#        define send_string_async_with_delay_P(string, interval) send_string_async_with_delay(string, interval)
+#    endif
+
+/**
+ * \brief Shortcut macro for send_string_async_with_delay_P(PSTR(string), 0).
+ */
+#    define SEND_STRING_ASYNC(string) send_string_async_with_delay_P(PSTR(string), 0)
+
+/**
+ * \brief Shortcut macro for send_string_async_with_delay_P(PSTR(string), interval).
+ */
+#    define SEND_STRING_ASYNC_DELAY(string, interval) send_string_async_with_delay_P(PSTR(string), interval)
+#endif
+
 /** \} */
@@ -0,0 +1,7 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#define SPLIT_KEYBOARD
+#define MATRIX_ROWS 2
+#define MATRIX_COLS 1
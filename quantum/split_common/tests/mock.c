@@ -0,0 +1,123 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "crc.h"
+#include "host.h"
+#include "transactions.h"
+#include "transaction_id_define.h"
+#include "transport.h"
+#include "split_util.h"
+#include "mock.h"
+
+mock_transaction_t mock_transactions[MOCK_MAX_TRANSACTIONS];
+size_t             mock_transaction_count = 0;
+
+const int8_t mock_id_get_slave_matrix_checksum = GET_SLAVE_MATRIX_CHECKSUM;
+const int8_t mock_id_put_layer_state           = PUT_LAYER_STATE;
+const int8_t mock_id_put_default_layer_state   = PUT_DEFAULT_LAYER_STATE;
+const int8_t mock_id_put_led_state             = PUT_LED_STATE;
+const int8_t mock_id_put_watchdog              = PUT_WATCHDOG;
+const int8_t mock_id_put_batch                 = PUT_BATCH;
+
+static split_shared_memory_t shmem;
+split_shared_memory_t *const split_shmem = &shmem;
+
+// What the slave has received, to tell it apart from the master's local copy
+static split_shared_memory_t slave_shmem;
+
+static uint32_t failing = 0;
+
+layer_state_t layer_state         = 0;
+layer_state_t default_layer_state = 0;
+
+uint8_t host_keyboard_leds(void) {
+    return 0;
+}
+
+void set_split_host_keyboard_leds(uint8_t led_state) {}
+
+bool is_transport_connected(void) {
+    return true;
+}
+
+bool split_watchdog_check(void) {
+    // Keep the watchdog transaction running every cycle
+    return false;
+}
+
+void split_watchdog_update(bool done) {}
+
+bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+
+    if (mock_transaction_count < MOCK_MAX_TRANSACTIONS) {
+        mock_transaction_t *logged = &mock_transactions[mock_transaction_count++];
+        logged->id                 = id;
+        logged->length             = initiator2target_length;
+        memcpy(logged->data, initiator2target_buf, initiator2target_length);
+    }
+
+    if (initiator2target_length > 0) {
+        size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
+        memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+    }
+    if (failing & (1UL << id)) {
+        return false;
+    }
+    if (initiator2target_length > 0) {
+        memcpy(((uint8_t *)&slave_shmem) + trans->initiator2target_offset, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+        if (id == PUT_BATCH) {
+            // Unpack the records, as batch_slave_callback() would on the slave
+            const uint8_t *batch  = initiator2target_buf;
+            uint8_t        offset = 1;
+            for (uint8_t count = batch[0]; count; count--) {
+                split_transaction_desc_t *record = &split_transaction_table[batch[offset]];
+                memcpy(((uint8_t *)&slave_shmem) + record->initiator2target_offset, &batch[offset + 2], batch[offset + 1]);
+                offset += 2 + batch[offset + 1];
+            }
+        }
+    }
+    if (target2initiator_length > 0) {
+        size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+        memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
+    }
+    return true;
+}
+
+void mock_reset(void) {
+    memset(&shmem, 0, sizeof(shmem));
+    memset(&slave_shmem, 0, sizeof(slave_shmem));
+    shmem.smatrix.checksum = crc8(shmem.smatrix.matrix, sizeof(shmem.smatrix.matrix));
+    layer_state            = 0;
+    default_layer_state    = 0;
+    failing                = 0;
+    mock_clear_transactions();
+}
+
+void mock_clear_transactions(void) {
+    mock_transaction_count = 0;
+}
+
+void mock_set_failing(int8_t id, bool fail) {
+    if (fail) {
+        failing |= 1UL << id;
+    } else {
+        failing &= ~(1UL << id);
+    }
+}
+
+void mock_set_layer_state(uint32_t state) {
+    layer_state = state;
+}
+
+uint32_t mock_slave_layer_state(void) {
+    return slave_shmem.layers.layer_state;
+}
+
+bool mock_transactions_master(void) {
+    matrix_row_t master_matrix[MATRIX_ROWS / 2] = {0};
+    matrix_row_t slave_matrix[MATRIX_ROWS / 2]  = {0};
+    return transactions_master(master_matrix, slave_matrix);
+}
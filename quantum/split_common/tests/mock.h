@@ -0,0 +1,34 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define MOCK_MAX_TRANSACTIONS 64
+
+typedef struct {
+    int8_t  id;
+    uint8_t length;
+    uint8_t data[255];
+} mock_transaction_t;
+
+extern mock_transaction_t mock_transactions[MOCK_MAX_TRANSACTIONS];
+extern size_t             mock_transaction_count;
+
+extern const int8_t mock_id_get_slave_matrix_checksum;
+extern const int8_t mock_id_put_layer_state;
+extern const int8_t mock_id_put_default_layer_state;
+extern const int8_t mock_id_put_led_state;
+extern const int8_t mock_id_put_watchdog;
+extern const int8_t mock_id_put_batch;
+
+void     mock_reset(void);
+void     mock_clear_transactions(void);
+void     mock_set_failing(int8_t id, bool failing);
+void     mock_set_layer_state(uint32_t state);
+uint32_t mock_slave_layer_state(void);
+bool     mock_transactions_master(void);
+
+void advance_time(uint32_t ms);
@@ -0,0 +1,11 @@
+split_transactions_batch_DEFS := -DSPLIT_TRANSACTION_BATCH_ENABLE -DSPLIT_LAYER_STATE_ENABLE -DSPLIT_LED_STATE_ENABLE -DSPLIT_WATCHDOG_ENABLE -DDISABLE_SYNC_TIMER -DNO_DEBUG
+split_transactions_batch_INC := $(QUANTUM_PATH)/split_common
+split_transactions_batch_CONFIG := $(QUANTUM_PATH)/split_common/tests/config_mock.h
+
+split_transactions_batch_SRC := \
+	platforms/test/timer.c \
+	$(PLATFORM_PATH)/synchronization_util.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(QUANTUM_PATH)/split_common/tests/mock.c \
+	$(QUANTUM_PATH)/split_common/tests/transactions_batch_tests.cpp \
+	$(QUANTUM_PATH)/split_common/transactions.c
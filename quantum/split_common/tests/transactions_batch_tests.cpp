@@ -0,0 +1,130 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <vector>
+
+extern "C" {
+#include "split_common/tests/mock.h"
+}
+
+class TransactionsBatch : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        mock_reset();
+
+        // Force a full sync, so that each test starts from delivered state
+        advance_time(1000);
+        ASSERT_TRUE(mock_transactions_master());
+        mock_clear_transactions();
+    }
+
+    // Index of the last transaction with the given ID, or -1 if there is none
+    int last_index(int8_t id) {
+        for (int i = mock_transaction_count - 1; i >= 0; i--) {
+            if (mock_transactions[i].id == id) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    // Transaction IDs of the records in the last batch sent, empty if there is none
+    std::vector<int8_t> last_batch(void) {
+        std::vector<int8_t> ids;
+        int                 index = last_index(mock_id_put_batch);
+        if (index >= 0) {
+            const uint8_t *batch  = mock_transactions[index].data;
+            size_t         offset = 1;
+            for (uint8_t count = batch[0]; count; count--) {
+                ids.push_back(batch[offset]);
+                offset += 2 + batch[offset + 1];
+            }
+        }
+        return ids;
+    }
+
+    std::vector<int8_t> all_state(void) {
+        return {mock_id_put_layer_state, mock_id_put_default_layer_state, mock_id_put_led_state};
+    }
+};
+
+TEST_F(TransactionsBatch, QueuesStateWrites) {
+    mock_set_layer_state(1 << 1);
+    EXPECT_TRUE(mock_transactions_master());
+    EXPECT_EQ(last_batch(), std::vector<int8_t>({mock_id_put_layer_state}));
+    EXPECT_EQ(last_index(mock_id_put_layer_state), -1);
+    EXPECT_EQ(mock_slave_layer_state(), 1 << 1);
+
+    // Nothing changed, nothing to send
+    mock_clear_transactions();
+    EXPECT_TRUE(mock_transactions_master());
+    EXPECT_TRUE(last_batch().empty());
+}
+
+TEST_F(TransactionsBatch, FailedHandlerStillSendsQueuedWrites) {
+    mock_set_layer_state(1 << 2);
+    mock_set_failing(mock_id_put_watchdog, true);
+    EXPECT_FALSE(mock_transactions_master());
+
+    // The watchdog fails after the layer state was queued, which must still go out
+    EXPECT_GT(last_index(mock_id_put_batch), last_index(mock_id_put_watchdog));
+    EXPECT_EQ(last_batch(), std::vector<int8_t>({mock_id_put_layer_state}));
+    EXPECT_EQ(mock_slave_layer_state(), 1 << 2);
+}
+
+TEST_F(TransactionsBatch, FailedSlaveReadSendsNothing) {
+    mock_set_layer_state(1 << 3);
+    mock_set_failing(mock_id_get_slave_matrix_checksum, true);
+    EXPECT_FALSE(mock_transactions_master());
+    EXPECT_EQ(last_index(mock_id_put_batch), -1);
+
+    // Nothing was queued, so the layer state is sent once the slave responds
+    mock_set_failing(mock_id_get_slave_matrix_checksum, false);
+    mock_clear_transactions();
+    EXPECT_TRUE(mock_transactions_master());
+    EXPECT_EQ(last_batch(), std::vector<int8_t>({mock_id_put_layer_state}));
+    EXPECT_EQ(mock_slave_layer_state(), 1 << 3);
+}
+
+TEST_F(TransactionsBatch, LostBatchIsQueuedAgain) {
+    mock_set_layer_state(1 << 4);
+    mock_set_failing(mock_id_put_batch, true);
+    EXPECT_FALSE(mock_transactions_master());
+    EXPECT_EQ(mock_slave_layer_state(), 0);
+
+    // Without any change or forced sync due, all batched state is sent again
+    mock_set_failing(mock_id_put_batch, false);
+    mock_clear_transactions();
+    EXPECT_TRUE(mock_transactions_master());
+    EXPECT_EQ(last_batch(), all_state());
+    EXPECT_EQ(mock_slave_layer_state(), 1 << 4);
+
+    // Once delivered, the batch only carries changes again
+    mock_clear_transactions();
+    EXPECT_TRUE(mock_transactions_master());
+    EXPECT_TRUE(last_batch().empty());
+}
+
+TEST_F(TransactionsBatch, LostBatchAfterFailedHandlerIsQueuedAgain) {
+    mock_set_layer_state(1 << 5);
+    mock_set_failing(mock_id_put_watchdog, true);
+    mock_set_failing(mock_id_put_batch, true);
+    EXPECT_FALSE(mock_transactions_master());
+
+    mock_set_failing(mock_id_put_batch, false);
+    mock_clear_transactions();
+    EXPECT_FALSE(mock_transactions_master());
+    EXPECT_EQ(last_batch(), all_state());
+    EXPECT_EQ(mock_slave_layer_state(), 1 << 5);
+
+    // A batch flushed by a failing cycle doesn't end the resync, a full cycle does
+    mock_set_failing(mock_id_put_watchdog, false);
+    mock_clear_transactions();
+    EXPECT_TRUE(mock_transactions_master());
+    EXPECT_EQ(last_batch(), all_state());
+
+    mock_clear_transactions();
+    EXPECT_TRUE(mock_transactions_master());
+    EXPECT_TRUE(last_batch().empty());
+}
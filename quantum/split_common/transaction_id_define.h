@@ -70,6 +70,10 @@ enum serial_transaction_id {
     PUT_WPM,
 #endif // defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
 
+#if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE) && defined(WPM_STATS_ENABLE)
+    PUT_WPM_STATS,
+#endif // defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE) && defined(WPM_STATS_ENABLE)
+
 #if defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
     PUT_OLED,
 #endif // defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
@@ -117,6 +121,10 @@ enum serial_transaction_id {
     PUT_DETECTED_OS,
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+#if defined(SPLIT_TRANSACTION_BATCH_ENABLE)
+    PUT_BATCH,
+#endif // defined(SPLIT_TRANSACTION_BATCH_ENABLE)
+
     NUM_TOTAL_TRANSACTIONS
 };
 
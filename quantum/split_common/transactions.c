@@ -71,9 +71,12 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
     return false;
 }
 
-#define TRANSACTION_HANDLER_MASTER(prefix)                                                                              \
-    do {                                                                                                                \
-        if (!transaction_handler_master(master_matrix, slave_matrix, #prefix, &prefix##_handlers_master)) return false; \
+#define TRANSACTION_HANDLER_MASTER(prefix)                                                                \
+    do {                                                                                                  \
+        if (!transaction_handler_master(master_matrix, slave_matrix, #prefix, &prefix##_handlers_master)) { \
+            TRANSACTIONS_BATCH_MASTER_ABORT();                                                            \
+            return false;                                                                                 \
+        }                                                                                                 \
     } while (0)
 
 /**
@@ -102,6 +105,42 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
         split_shared_memory_unlock();                         \
     } while (0)
 
+#ifdef SPLIT_TRANSACTION_BATCH_ENABLE
+/* Writes of state that is only used for display on the slave are batched:
+ * instead of a round trip each, they are appended to a buffer as records of
+ * transaction ID, length and data, and sent as a single transaction at the
+ * end of transactions_master(). Reads, and writes that don't fit, still run
+ * immediately, so the slave matrix and pointing data are never held up.
+ */
+static uint8_t batch_length = 0;
+static uint8_t batch_buffer[SPLIT_TRANSACTION_BATCH_SIZE];
+// The last batch was lost, so every batched handler has to send its state again
+static bool batch_resync = false;
+
+static bool transport_queue(int8_t id, const void *data, uint8_t length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (length > trans->initiator2target_buffer_size) {
+        length = trans->initiator2target_buffer_size;
+    }
+    if (batch_length + 2 + length > sizeof(batch_buffer)) {
+        return transport_write(id, data, length);
+    }
+
+    // Keep the local copy up to date, as transport_execute_transaction() would
+    memcpy(split_trans_initiator2target_buffer(trans), data, length);
+
+    batch_buffer[0]++;
+    batch_buffer[batch_length++] = id;
+    batch_buffer[batch_length++] = length;
+    memcpy(&batch_buffer[batch_length], data, length);
+    batch_length += length;
+    return true;
+}
+#else
+#    define transport_queue(id, data, length) transport_write(id, data, length)
+#    define batch_resync false
+#endif // SPLIT_TRANSACTION_BATCH_ENABLE
+
 inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t trans_id_retrieve, uint32_t *last_update, void *destination, const void *equiv_shmem, size_t length) {
     uint8_t curr_checksum;
     bool    okay = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
@@ -119,8 +158,8 @@ inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t tr
 
 inline static bool send_if_condition(int8_t trans_id, uint32_t *last_update, bool condition, void *source, size_t length) {
     bool okay = true;
-    if (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || condition) {
-        okay &= transport_write(trans_id, source, length);
+    if (batch_resync || timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || condition) {
+        okay &= transport_queue(trans_id, source, length);
         if (okay) {
             *last_update = timer_read32();
         }
@@ -341,7 +380,7 @@ static void led_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 
 static bool mods_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t   last_update    = 0;
-    bool              mods_need_sync = timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS;
+    bool              mods_need_sync = batch_resync || timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS;
     split_mods_sync_t new_mods;
     new_mods.real_mods = get_mods();
     if (!mods_need_sync && new_mods.real_mods != split_shmem->mods.real_mods) {
@@ -362,7 +401,7 @@ static bool mods_handlers_master(matrix_row_t master_matrix[], matrix_row_t slav
 
     bool okay = true;
     if (mods_need_sync) {
-        okay &= transport_write(PUT_MODS, &new_mods, sizeof(new_mods));
+        okay &= transport_queue(PUT_MODS, &new_mods, sizeof(new_mods));
         if (okay) {
             last_update = timer_read32();
         }
@@ -436,6 +475,10 @@ static bool rgblight_handlers_master(matrix_row_t master_matrix[], matrix_row_t
     static uint32_t     last_update = 0;
     rgblight_syncinfo_t rgblight_sync;
     rgblight_get_syncinfo(&rgblight_sync);
+    if (batch_resync) {
+        // The flags of the lost batch were already cleared, have the slave apply everything again
+        rgblight_sync.status.change_flags |= RGBLIGHT_STATUS_CHANGE_MODE | RGBLIGHT_STATUS_CHANGE_HSVS | RGBLIGHT_STATUS_CHANGE_TIMER | RGBLIGHT_STATUS_CHANGE_LAYERS;
+    }
     if (send_if_condition(PUT_RGBLIGHT, &last_update, (rgblight_sync.status.change_flags != 0), &rgblight_sync, sizeof(rgblight_sync))) {
         rgblight_clear_change_flags();
     } else {
@@ -564,6 +607,33 @@ static void wpm_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_
 
 #endif // defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
 
+////////////////////////////////////////////////////
+// WPM statistics
+
+#if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE) && defined(WPM_STATS_ENABLE)
+
+static bool wpm_stats_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint32_t last_update = 0;
+    wpm_stats_t     wpm_stats   = get_wpm_stats();
+    return send_if_data_mismatch(PUT_WPM_STATS, &last_update, &wpm_stats, &split_shmem->wpm_stats, sizeof(wpm_stats));
+}
+
+static void wpm_stats_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    set_wpm_stats(&split_shmem->wpm_stats);
+}
+
+#    define TRANSACTIONS_WPM_STATS_MASTER() TRANSACTION_HANDLER_MASTER(wpm_stats)
+#    define TRANSACTIONS_WPM_STATS_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(wpm_stats)
+#    define TRANSACTIONS_WPM_STATS_REGISTRATIONS [PUT_WPM_STATS] = trans_initiator2target_initializer(wpm_stats),
+
+#else // defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE) && defined(WPM_STATS_ENABLE)
+
+#    define TRANSACTIONS_WPM_STATS_MASTER()
+#    define TRANSACTIONS_WPM_STATS_SLAVE()
+#    define TRANSACTIONS_WPM_STATS_REGISTRATIONS
+
+#endif // defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE) && defined(WPM_STATS_ENABLE)
+
 ////////////////////////////////////////////////////
 // OLED
 
@@ -656,9 +726,9 @@ static bool pointing_handlers_master(matrix_row_t master_matrix[], matrix_row_t
     bool            okay = read_if_checksum_mismatch(GET_POINTING_CHECKSUM, GET_POINTING_DATA, &last_update, &temp_state, &split_shmem->pointing.report, sizeof(temp_state));
     if (okay) pointing_device_set_shared_report(temp_state);
     temp_cpi = pointing_device_get_shared_cpi();
-    if (temp_cpi && last_cpi != temp_cpi) {
+    if (temp_cpi && (batch_resync || last_cpi != temp_cpi)) {
         split_shmem->pointing.cpi = temp_cpi;
-        okay                      = transport_write(PUT_POINTING_CPI, &split_shmem->pointing.cpi, sizeof(split_shmem->pointing.cpi));
+        okay                      = transport_queue(PUT_POINTING_CPI, &split_shmem->pointing.cpi, sizeof(split_shmem->pointing.cpi));
         if (okay) {
             last_cpi = temp_cpi;
         }
@@ -847,6 +917,93 @@ static void detected_os_handlers_slave(matrix_row_t master_matrix[], matrix_row_
 
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+////////////////////////////////////////////////////
+// Batched writes
+
+#ifdef SPLIT_TRANSACTION_BATCH_ENABLE
+
+static bool batch_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    if (!batch_buffer[0]) {
+        return true;
+    }
+    return transport_write(PUT_BATCH, batch_buffer, sizeof(batch_buffer));
+}
+
+static bool batch_flush_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[], bool complete) {
+    if (!transaction_handler_master(master_matrix, slave_matrix, "batch", &batch_handlers_master)) {
+        // Handlers have already committed the queued state, have them queue it again next time
+        batch_resync = true;
+        return false;
+    }
+    if (complete) {
+        // Every batched handler got to run, so all of their state has been delivered
+        batch_resync = false;
+    }
+    return true;
+}
+
+static void batch_slave_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    const uint8_t *batch  = initiator2target_buffer;
+    uint8_t        count  = batch[0];
+    uint8_t        offset = 1;
+
+    while (count-- && offset + 2 <= initiator2target_buffer_size) {
+        int8_t  id     = batch[offset++];
+        uint8_t length = batch[offset++];
+        if (id < 0 || id >= NUM_TOTAL_TRANSACTIONS || length > split_transaction_table[id].initiator2target_buffer_size || offset + length > initiator2target_buffer_size) {
+            return;
+        }
+
+        // Apply the record as if it was received as a transaction of its own
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        memcpy(split_trans_initiator2target_buffer(trans), &batch[offset], length);
+        offset += length;
+        if (trans->slave_callback) {
+            trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+        }
+    }
+}
+
+#    define TRANSACTIONS_BATCH_MASTER_BEGIN() \
+        do {                                  \
+            batch_buffer[0] = 0;              \
+            batch_length    = 1;              \
+        } while (0)
+#    define TRANSACTIONS_BATCH_MASTER()                                  \
+        do {                                                             \
+            if (!batch_flush_master(master_matrix, slave_matrix, true)) { \
+                return false;                                            \
+            }                                                            \
+        } while (0)
+// Still deliver what was queued before a handler failed
+#    define TRANSACTIONS_BATCH_MASTER_ABORT() batch_flush_master(master_matrix, slave_matrix, false)
+#    define TRANSACTIONS_BATCH_REGISTRATIONS [PUT_BATCH] = trans_initiator2target_initializer_cb(batch, batch_slave_callback),
+
+#else // SPLIT_TRANSACTION_BATCH_ENABLE
+
+#    define TRANSACTIONS_BATCH_MASTER_BEGIN()
+#    define TRANSACTIONS_BATCH_MASTER()
+#    define TRANSACTIONS_BATCH_MASTER_ABORT()
+#    define TRANSACTIONS_BATCH_REGISTRATIONS
+
+#endif // SPLIT_TRANSACTION_BATCH_ENABLE
+
+////////////////////////////////////////////////////
+// Asynchronous slave matrix
+
+#if defined(SERIAL_ASYNC_ENABLE) && !defined(USE_I2C) && !defined(SERIAL_DRIVER_BITBANG)
+
+#    include "serial.h"
+
+// Start reading the slave matrix checksum now, it is collected by the next transactions_master()
+#    define TRANSACTIONS_ASYNC_MASTER() soft_serial_transaction_start(GET_SLAVE_MATRIX_CHECKSUM)
+
+#else // defined(SERIAL_ASYNC_ENABLE) && !defined(USE_I2C) && !defined(SERIAL_DRIVER_BITBANG)
+
+#    define TRANSACTIONS_ASYNC_MASTER()
+
+#endif // defined(SERIAL_ASYNC_ENABLE) && !defined(USE_I2C) && !defined(SERIAL_DRIVER_BITBANG)
+
 ////////////////////////////////////////////////////
 
 split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
@@ -870,6 +1027,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_LED_MATRIX_REGISTRATIONS
     TRANSACTIONS_RGB_MATRIX_REGISTRATIONS
     TRANSACTIONS_WPM_REGISTRATIONS
+    TRANSACTIONS_WPM_STATS_REGISTRATIONS
     TRANSACTIONS_OLED_REGISTRATIONS
     TRANSACTIONS_ST7565_REGISTRATIONS
     TRANSACTIONS_POINTING_REGISTRATIONS
@@ -877,6 +1035,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_HAPTIC_REGISTRATIONS
     TRANSACTIONS_ACTIVITY_REGISTRATIONS
     TRANSACTIONS_DETECTED_OS_REGISTRATIONS
+    TRANSACTIONS_BATCH_REGISTRATIONS
 // clang-format on
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -888,6 +1047,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 };
 
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    TRANSACTIONS_BATCH_MASTER_BEGIN();
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
     TRANSACTIONS_MASTER_MATRIX_MASTER();
     TRANSACTIONS_ENCODERS_MASTER();
@@ -900,6 +1060,7 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_LED_MATRIX_MASTER();
     TRANSACTIONS_RGB_MATRIX_MASTER();
     TRANSACTIONS_WPM_MASTER();
+    TRANSACTIONS_WPM_STATS_MASTER();
     TRANSACTIONS_OLED_MASTER();
     TRANSACTIONS_ST7565_MASTER();
     TRANSACTIONS_POINTING_MASTER();
@@ -907,6 +1068,8 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_HAPTIC_MASTER();
     TRANSACTIONS_ACTIVITY_MASTER();
     TRANSACTIONS_DETECTED_OS_MASTER();
+    TRANSACTIONS_BATCH_MASTER();
+    TRANSACTIONS_ASYNC_MASTER();
     return true;
 }
 
@@ -923,6 +1086,7 @@ void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[
     TRANSACTIONS_LED_MATRIX_SLAVE();
     TRANSACTIONS_RGB_MATRIX_SLAVE();
     TRANSACTIONS_WPM_SLAVE();
+    TRANSACTIONS_WPM_STATS_SLAVE();
     TRANSACTIONS_OLED_SLAVE();
     TRANSACTIONS_ST7565_SLAVE();
     TRANSACTIONS_POINTING_SLAVE();
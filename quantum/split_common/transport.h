@@ -31,6 +31,13 @@
 #    define RPC_S2M_BUFFER_SIZE 32
 #endif // RPC_S2M_BUFFER_SIZE
 
+#ifdef SPLIT_TRANSACTION_BATCH_ENABLE
+#    ifndef SPLIT_TRANSACTION_BATCH_SIZE
+#        define SPLIT_TRANSACTION_BATCH_SIZE 32
+#    endif // SPLIT_TRANSACTION_BATCH_SIZE
+_Static_assert(SPLIT_TRANSACTION_BATCH_SIZE >= 4 && SPLIT_TRANSACTION_BATCH_SIZE <= 255, "SPLIT_TRANSACTION_BATCH_SIZE must be between 4 and 255");
+#endif // SPLIT_TRANSACTION_BATCH_ENABLE
+
 void transport_master_init(void);
 void transport_slave_init(void);
 
@@ -122,6 +129,10 @@ typedef struct _split_slave_haptic_sync_t {
 } split_slave_haptic_sync_t;
 #endif // defined(HAPTIC_ENABLE) && defined(SPLIT_HAPTIC_ENABLE)
 
+#if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
+#    include "wpm.h"
+#endif // defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
+
 #if defined(SPLIT_ACTIVITY_ENABLE)
 #    include "keyboard.h"
 typedef struct _split_slave_activity_sync_t {
@@ -197,6 +208,10 @@ typedef struct _split_shared_memory_t {
     uint8_t current_wpm;
 #endif // defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
 
+#if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE) && defined(WPM_STATS_ENABLE)
+    wpm_stats_t wpm_stats;
+#endif // defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE) && defined(WPM_STATS_ENABLE)
+
 #if defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
     uint8_t current_oled_state;
 #endif // defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
@@ -230,6 +245,11 @@ typedef struct _split_shared_memory_t {
 #if defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
     os_variant_t detected_os;
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
+
+#ifdef SPLIT_TRANSACTION_BATCH_ENABLE
+    // Record count, then (transaction ID, length, data) records
+    uint8_t batch[SPLIT_TRANSACTION_BATCH_SIZE];
+#endif // SPLIT_TRANSACTION_BATCH_ENABLE
 } split_shared_memory_t;
 
 extern split_shared_memory_t *const split_shmem;
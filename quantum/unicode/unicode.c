@@ -304,6 +304,31 @@ __attribute__((weak)) void unicode_input_cancel(void) {
     set_mods(unicode_saved_mods); // Reregister previously set mods
 }
 
+// Hex digits are typed with as few keyboard reports as possible.
+static tap_packer_t digit_packer;
+
+static void digit_send(void) {
+    if (tap_packer_send(&digit_packer)) {
+#if TAP_CODE_DELAY > 0
+        wait_ms(TAP_CODE_DELAY);
+#endif
+    }
+    tap_packer_begin(&digit_packer);
+}
+
+static void digit_flush(void) {
+    digit_send();
+    tap_packer_release_mods(&digit_packer);
+    tap_packer_send(&digit_packer);
+    tap_packer_begin(&digit_packer);
+}
+
+static void digit_add(uint8_t keycode, uint8_t mods) {
+    while (!tap_packer_add(&digit_packer, keycode, mods, KEYBOARD_REPORT_KEYS)) {
+        digit_send();
+    }
+}
+
 // clang-format off
 
 static void send_nibble_wrapper(uint8_t digit) {
@@ -311,22 +336,30 @@ static void send_nibble_wrapper(uint8_t digit) {
         uint8_t kc = digit < 10
                    ? KC_KP_1 + (10 + digit - 1) % 10
                    : KC_A + (digit - 10);
-        tap_code(kc);
+        digit_add(kc, 0);
         return;
     }
-    send_nibble(digit);
-}
-
-// clang-format on
 
-void register_hex(uint16_t hex) {
-    for (int i = 3; i >= 0; i--) {
-        uint8_t digit = ((hex >> (i * 4)) & 0xF);
-        send_nibble_wrapper(digit);
+    char    ascii_code = digit < 10 ? '0' + digit : 'a' + (digit - 10);
+    uint8_t mods       = 0;
+    if (PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code)) {
+        // Dead keys need a space tapped after them, so they are sent on their own
+        digit_flush();
+        send_nibble(digit);
+        return;
+    }
+    if (PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code)) {
+        mods |= MOD_BIT(KC_LEFT_SHIFT);
+    }
+    if (PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code)) {
+        mods |= MOD_BIT(KC_RIGHT_ALT);
     }
+    digit_add(pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]), mods);
 }
 
-void register_hex32(uint32_t hex) {
+// clang-format on
+
+static void queue_hex32(uint32_t hex) {
     bool first_digit        = true;
     bool needs_leading_zero = (unicode_config.input_mode == UNICODE_MODE_WINCOMPOSE);
     for (int i = 7; i >= 0; i--) {
@@ -351,22 +384,44 @@ void register_hex32(uint32_t hex) {
     }
 }
 
-void register_unicode(uint32_t code_point) {
-    if (code_point > 0x10FFFF || (code_point > 0xFFFF && unicode_config.input_mode == UNICODE_MODE_WINDOWS)) {
-        // Code point out of range, do nothing
-        return;
-    }
+static bool code_point_valid(uint32_t code_point) {
+    return code_point <= 0x10FFFF && (code_point <= 0xFFFF || unicode_config.input_mode != UNICODE_MODE_WINDOWS);
+}
 
-    unicode_input_start();
+static void queue_code_point(uint32_t code_point) {
     if (code_point > 0xFFFF && unicode_config.input_mode == UNICODE_MODE_MACOS) {
         // Convert code point to UTF-16 surrogate pair on macOS
         code_point -= 0x10000;
         uint32_t lo = code_point & 0x3FF, hi = (code_point & 0xFFC00) >> 10;
-        register_hex32(hi + 0xD800);
-        register_hex32(lo + 0xDC00);
+        queue_hex32(hi + 0xD800);
+        queue_hex32(lo + 0xDC00);
     } else {
-        register_hex32(code_point);
+        queue_hex32(code_point);
+    }
+}
+
+void register_hex(uint16_t hex) {
+    for (int i = 3; i >= 0; i--) {
+        uint8_t digit = ((hex >> (i * 4)) & 0xF);
+        send_nibble_wrapper(digit);
+    }
+    digit_flush();
+}
+
+void register_hex32(uint32_t hex) {
+    queue_hex32(hex);
+    digit_flush();
+}
+
+void register_unicode(uint32_t code_point) {
+    if (!code_point_valid(code_point)) {
+        // Code point out of range, do nothing
+        return;
     }
+
+    unicode_input_start();
+    queue_code_point(code_point);
+    digit_flush();
     unicode_input_finish();
 }
 
@@ -375,12 +430,31 @@ void send_unicode_string(const char *str) {
         return;
     }
 
+    // macOS takes any number of code points while the Unicode key is held,
+    // the other input modes need to be started again for each code point
+    bool run     = unicode_config.input_mode == UNICODE_MODE_MACOS;
+    bool started = false;
+
     while (*str) {
         int32_t code_point = 0;
         str                = decode_utf8(str, &code_point);
 
-        if (code_point >= 0) {
+        if (code_point < 0 || !code_point_valid(code_point)) {
+            continue;
+        }
+        if (!run) {
             register_unicode(code_point);
+            continue;
         }
+        if (!started) {
+            unicode_input_start();
+            started = true;
+        }
+        queue_code_point(code_point);
+    }
+
+    if (started) {
+        digit_flush();
+        unicode_input_finish();
     }
 }
@@ -21,6 +21,7 @@
 #include "quantum_keycodes.h"
 #include "action_util.h"
 #include <math.h>
+#include <string.h>
 
 // WPM Stuff
 static uint8_t  current_wpm = 0;
@@ -58,6 +59,144 @@ static uint8_t  prev_wpm        = 0;
 static uint8_t  next_wpm        = 0;
 #endif
 
+#if defined(WPM_STATS_ENABLE)
+#    if WPM_STATS_IDLE_TIMEOUT > UINT16_MAX
+#        error "WPM_STATS_IDLE_TIMEOUT must fit in 16 bits"
+#    endif
+
+/* The statistics window is a ring buffer holding the intervals between the
+ * most recent keystrokes.  Running sums over the whole window and over the
+ * trailing burst window, as well as a histogram of the intervals, are adjusted
+ * as each interval enters and leaves the ring, so recording a keystroke costs
+ * the same regardless of the window size.  A pause longer than
+ * `WPM_STATS_IDLE_TIMEOUT` ends the typing session and empties the window.
+ */
+static uint16_t    stats_intervals[WPM_STATS_WINDOW_SIZE];
+static uint8_t     stats_histogram[WPM_STATS_BUCKET_COUNT];
+static uint8_t     stats_head       = 0;
+static uint8_t     stats_count      = 0;
+static uint32_t    stats_window_sum = 0;
+static uint32_t    stats_burst_sum  = 0;
+static uint32_t    stats_last_press = 0;
+static bool        stats_active     = false;
+static wpm_stats_t wpm_stats        = {0};
+
+static inline uint8_t stats_bucket(uint16_t interval) {
+    uint16_t bucket = interval / WPM_STATS_BUCKET_WIDTH;
+    return bucket < WPM_STATS_BUCKET_COUNT ? bucket : WPM_STATS_BUCKET_COUNT - 1;
+}
+
+static uint8_t stats_wpm(uint32_t keys, uint32_t duration) {
+    if (duration == 0) {
+        return UINT8_MAX;
+    }
+    uint32_t wpm = (60000 * keys) / (duration * WPM_ESTIMATED_WORD_SIZE);
+    return wpm > UINT8_MAX ? UINT8_MAX : wpm;
+}
+
+static void stats_clear_window(void) {
+    stats_head       = 0;
+    stats_count      = 0;
+    stats_window_sum = 0;
+    stats_burst_sum  = 0;
+    stats_active     = false;
+    memset(stats_histogram, 0, sizeof(stats_histogram));
+
+    // Keep the percentiles and peak of the session that just ended around for
+    // display purposes, only the live speeds drop to zero.
+    wpm_stats.wpm       = 0;
+    wpm_stats.burst_wpm = 0;
+    wpm_stats.samples   = 0;
+}
+
+static void stats_record_press(void) {
+    uint32_t now = timer_read32();
+
+    uint32_t elapsed = TIMER_DIFF_32(now, stats_last_press);
+    stats_last_press = now;
+
+    if (!stats_active || elapsed > WPM_STATS_IDLE_TIMEOUT) {
+        stats_clear_window();
+        stats_active = true;
+        return;
+    }
+
+    uint16_t interval = elapsed;
+
+    // The interval leaving the burst window has to be read before the write
+    // below, as it is the slot being overwritten when both windows are equal.
+    if (stats_count >= WPM_STATS_BURST_SIZE) {
+        uint8_t leaving = stats_head >= WPM_STATS_BURST_SIZE ? stats_head - WPM_STATS_BURST_SIZE : stats_head + WPM_STATS_WINDOW_SIZE - WPM_STATS_BURST_SIZE;
+        stats_burst_sum -= stats_intervals[leaving];
+    }
+    if (stats_count == WPM_STATS_WINDOW_SIZE) {
+        uint16_t oldest = stats_intervals[stats_head];
+        stats_window_sum -= oldest;
+        stats_histogram[stats_bucket(oldest)]--;
+    } else {
+        stats_count++;
+    }
+
+    stats_intervals[stats_head] = interval;
+    stats_window_sum += interval;
+    stats_burst_sum += interval;
+    stats_histogram[stats_bucket(interval)]++;
+    if (++stats_head == WPM_STATS_WINDOW_SIZE) {
+        stats_head = 0;
+    }
+
+    uint8_t burst_keys  = stats_count < WPM_STATS_BURST_SIZE ? stats_count : WPM_STATS_BURST_SIZE;
+    wpm_stats.samples   = stats_count;
+    wpm_stats.wpm       = stats_count < 2 ? 0 : stats_wpm(stats_count, stats_window_sum); // don't guess high WPM based on a single interval.
+    wpm_stats.burst_wpm = stats_count < 2 ? 0 : stats_wpm(burst_keys, stats_burst_sum);
+    if (stats_count >= WPM_STATS_BURST_SIZE && wpm_stats.burst_wpm > wpm_stats.peak_wpm) {
+        wpm_stats.peak_wpm = wpm_stats.burst_wpm;
+    }
+    wpm_stats.interval_p50 = wpm_stats_interval_percentile(50);
+    wpm_stats.interval_p90 = wpm_stats_interval_percentile(90);
+}
+
+void set_wpm_stats(const wpm_stats_t *stats) {
+    wpm_stats = *stats;
+}
+
+wpm_stats_t get_wpm_stats(void) {
+    return wpm_stats;
+}
+
+/* Percentiles are resolved from the interval histogram, so the cost is bound
+ * by `WPM_STATS_BUCKET_COUNT` and the result is the centre of the bucket the
+ * percentile falls in.  Intervals beyond the last bucket are counted in it.
+ */
+uint16_t wpm_stats_interval_percentile(uint8_t percent) {
+    if (stats_count == 0) {
+        return 0;
+    }
+    if (percent > 100) {
+        percent = 100;
+    }
+
+    uint16_t target = ((uint16_t)stats_count * percent + 99) / 100;
+    if (target == 0) {
+        target = 1;
+    }
+
+    uint16_t seen = 0;
+    for (uint8_t i = 0; i < WPM_STATS_BUCKET_COUNT; i++) {
+        seen += stats_histogram[i];
+        if (seen >= target) {
+            return i * WPM_STATS_BUCKET_WIDTH + WPM_STATS_BUCKET_WIDTH / 2;
+        }
+    }
+    return WPM_STATS_BUCKET_COUNT * WPM_STATS_BUCKET_WIDTH;
+}
+
+void wpm_stats_reset(void) {
+    stats_clear_window();
+    memset(&wpm_stats, 0, sizeof(wpm_stats));
+}
+#endif // WPM_STATS_ENABLE
+
 void set_current_wpm(uint8_t new_wpm) {
     current_wpm = new_wpm;
 }
@@ -113,6 +252,11 @@ void update_wpm(uint16_t keycode) {
     if (wpm_keycode(keycode) && period_presses[current_period] < INT16_MAX) {
         period_presses[current_period]++;
     }
+#if defined(WPM_STATS_ENABLE)
+    if (wpm_keycode(keycode)) {
+        stats_record_press();
+    }
+#endif
 #if defined(WPM_ALLOW_COUNT_REGRESSION)
     uint8_t regress = wpm_regress_count(keycode);
     if (regress && period_presses[current_period] > INT16_MIN) {
@@ -122,6 +266,12 @@ void update_wpm(uint16_t keycode) {
 }
 
 void decay_wpm(void) {
+#if defined(WPM_STATS_ENABLE)
+    if (stats_active && timer_elapsed32(stats_last_press) > WPM_STATS_IDLE_TIMEOUT) {
+        stats_clear_window();
+    }
+#endif
+
     int32_t presses = period_presses[0];
     for (int i = 1; i <= periods; i++) {
         presses += period_presses[i];
@@ -129,7 +279,7 @@ void decay_wpm(void) {
     if (presses < 0) {
         presses = 0;
     }
-    int32_t  elapsed  = timer_elapsed32(wpm_timer);
+    uint32_t elapsed  = timer_elapsed32(wpm_timer);
     uint32_t duration = (((periods)*PERIOD_DURATION) + elapsed);
     int32_t  wpm_now  = (60000 * presses) / (duration * WPM_ESTIMATED_WORD_SIZE);
 
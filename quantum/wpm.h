@@ -30,6 +30,40 @@
 #    define WPM_SAMPLE_PERIODS 25
 #endif
 
+#ifdef WPM_STATS_ENABLE
+#    ifndef WPM_STATS_WINDOW_SIZE
+#        define WPM_STATS_WINDOW_SIZE 32
+#    endif
+#    ifndef WPM_STATS_BURST_SIZE
+#        define WPM_STATS_BURST_SIZE 8
+#    endif
+#    ifndef WPM_STATS_IDLE_TIMEOUT
+#        define WPM_STATS_IDLE_TIMEOUT 2000
+#    endif
+#    ifndef WPM_STATS_BUCKET_WIDTH
+#        define WPM_STATS_BUCKET_WIDTH 16
+#    endif
+#    ifndef WPM_STATS_BUCKET_COUNT
+#        define WPM_STATS_BUCKET_COUNT 32
+#    endif
+
+#    if WPM_STATS_WINDOW_SIZE > 255 || WPM_STATS_WINDOW_SIZE < 2
+#        error "WPM_STATS_WINDOW_SIZE must be between 2 and 255"
+#    endif
+#    if WPM_STATS_BURST_SIZE > WPM_STATS_WINDOW_SIZE || WPM_STATS_BURST_SIZE < 1
+#        error "WPM_STATS_BURST_SIZE must be between 1 and WPM_STATS_WINDOW_SIZE"
+#    endif
+
+typedef struct {
+    uint8_t  wpm;          // WPM over the last WPM_STATS_WINDOW_SIZE keystrokes
+    uint8_t  burst_wpm;    // WPM over the last WPM_STATS_BURST_SIZE keystrokes
+    uint8_t  peak_wpm;     // highest burst WPM since the last reset
+    uint8_t  samples;      // number of inter-key intervals in the window
+    uint16_t interval_p50; // median inter-key interval, in milliseconds
+    uint16_t interval_p90; // 90th percentile inter-key interval, in milliseconds
+} wpm_stats_t;
+#endif
+
 bool wpm_keycode(uint16_t keycode);
 bool wpm_keycode_kb(uint16_t keycode);
 bool wpm_keycode_user(uint16_t keycode);
@@ -43,3 +77,10 @@ uint8_t get_current_wpm(void);
 void    update_wpm(uint16_t);
 
 void decay_wpm(void);
+
+#ifdef WPM_STATS_ENABLE
+void        set_wpm_stats(const wpm_stats_t *stats);
+wpm_stats_t get_wpm_stats(void);
+uint16_t    wpm_stats_interval_percentile(uint8_t percent);
+void        wpm_stats_reset(void);
+#endif
@@ -0,0 +1,110 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+
+using ::testing::_;
+using ::testing::AnyNumber;
+
+class KeyJournal : public TestFixture {
+   public:
+    void SetUp() override {
+        key_journal_clear();
+    }
+
+    std::vector<key_journal_entry_t> drain() {
+        std::vector<key_journal_entry_t> result;
+        key_journal_entry_t              entries[8];
+        uint8_t                          count;
+        while ((count = key_journal_read(entries, 8)) > 0) {
+            result.insert(result.end(), entries, entries + count);
+        }
+        return result;
+    }
+};
+
+TEST_F(KeyJournal, TapRecordsEachStage) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 1, 2, KC_A);
+
+    set_keymap({key_a});
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    tap_key(key_a);
+
+    auto entries = drain();
+    ASSERT_EQ(entries.size(), 9);
+
+    EXPECT_EQ(entries[0].type, KEY_JOURNAL_META);
+    EXPECT_EQ(entries[0].timestamp, KEY_JOURNAL_TICK_RATE);
+    EXPECT_EQ(entries[0].data8, KEY_JOURNAL_VERSION);
+    EXPECT_EQ(entries[0].data16, 0);
+
+    EXPECT_EQ(entries[1].type, KEY_JOURNAL_KEY_EVENT);
+    EXPECT_EQ(entries[1].data8, 1);
+    EXPECT_EQ(entries[1].data16, 2 << 8 | 1);
+    EXPECT_EQ(entries[2].type, KEY_JOURNAL_RECORD);
+    EXPECT_EQ(entries[2].data16, 2 << 8 | 1);
+    EXPECT_EQ(entries[3].type, KEY_JOURNAL_KEYCODE);
+    EXPECT_EQ(entries[3].data16, KC_A);
+    EXPECT_EQ(entries[4].type, KEY_JOURNAL_REPORT);
+    EXPECT_EQ(entries[4].data16, 1);
+
+    EXPECT_EQ(entries[5].type, KEY_JOURNAL_KEY_EVENT);
+    EXPECT_EQ(entries[5].data8, 0);
+    EXPECT_EQ(entries[6].type, KEY_JOURNAL_RECORD);
+    EXPECT_EQ(entries[7].type, KEY_JOURNAL_KEYCODE);
+    EXPECT_EQ(entries[8].type, KEY_JOURNAL_REPORT);
+    EXPECT_EQ(entries[8].data16, 0);
+
+    EXPECT_LT(entries[1].timestamp, entries[5].timestamp);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyJournal, HoldDecisionIsTimestamped) {
+    TestDriver driver;
+    auto       mod_tap_key = KeymapKey(0, 0, 0, SFT_T(KC_P));
+
+    set_keymap({mod_tap_key});
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    mod_tap_key.press();
+    idle_for(TAPPING_TERM + 1);
+    mod_tap_key.release();
+    run_one_scan_loop();
+
+    auto entries = drain();
+    ASSERT_GE(entries.size(), 5);
+    EXPECT_EQ(entries[1].type, KEY_JOURNAL_KEY_EVENT);
+    EXPECT_EQ(entries[2].type, KEY_JOURNAL_RECORD);
+    EXPECT_EQ(entries[2].data8 & 1, 1);
+    EXPECT_GE(entries[2].timestamp - entries[1].timestamp, TAPPING_TERM);
+    EXPECT_EQ(entries[3].type, KEY_JOURNAL_KEYCODE);
+    EXPECT_EQ(entries[4].type, KEY_JOURNAL_REPORT);
+    EXPECT_EQ(entries[4].data8, MOD_BIT(KC_LEFT_SHIFT));
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyJournal, OverflowKeepsNewestEntries) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    // Each tap records eight entries.
+    for (int i = 0; i < 3; i++) {
+        tap_key(key_a);
+    }
+
+    EXPECT_EQ(key_journal_count(), KEY_JOURNAL_SIZE);
+    auto entries = drain();
+    ASSERT_EQ(entries.size(), KEY_JOURNAL_SIZE + 1);
+    EXPECT_EQ(entries[0].type, KEY_JOURNAL_META);
+    EXPECT_EQ(entries[0].data16, 8);
+    EXPECT_EQ(entries[1].type, KEY_JOURNAL_KEY_EVENT);
+    EXPECT_EQ(key_journal_count(), 0);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,56 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*******************************************************************************
+  88888888888 888      d8b                .d888 d8b 888               d8b
+      888     888      Y8P               d88P"  Y8P 888               Y8P
+      888     888                        888        888
+      888     88888b.  888 .d8888b       888888 888 888  .d88b.       888 .d8888b
+      888     888 "88b 888 88K           888    888 888 d8P  Y8b      888 88K
+      888     888  888 888 "Y8888b.      888    888 888 88888888      888 "Y8888b.
+      888     888  888 888      X88      888    888 888 Y8b.          888      X88
+      888     888  888 888  88888P'      888    888 888  "Y8888       888  88888P'
+                                                        888                 888
+                                                        888                 888
+                                                        888                 888
+     .d88b.   .d88b.  88888b.   .d88b.  888d888 8888b.  888888 .d88b.   .d88888
+    d88P"88b d8P  Y8b 888 "88b d8P  Y8b 888P"      "88b 888   d8P  Y8b d88" 888
+    888  888 88888888 888  888 88888888 888    .d888888 888   88888888 888  888
+    Y88b 888 Y8b.     888  888 Y8b.     888    888  888 Y88b. Y8b.     Y88b 888
+     "Y88888  "Y8888  888  888  "Y8888  888    "Y888888  "Y888 "Y8888   "Y88888
+         888
+    Y8b d88P
+     "Y88P"
+*******************************************************************************/
+
+#pragma once
+
+// Leader sequences (7 entries):
+//   KC_A           -> KC_1
+//   KC_A KC_B      -> KC_2
+//   KC_A KC_B KC_C -> KC_3
+//   KC_B KC_C      -> S(KC_4)
+//   KC_C KC_D KC_E -> "cde"
+//   KC_D KC_F      -> @rollback
+//   KC_D KC_G      -> @rollback
+
+enum leader_sequence_ids {
+    LEADER_ROLLBACK,
+};
+
+#ifdef LEADER_DATA_IMPLEMENTATION
+#    define LEADER_DATA_SIZE 41
+#    define LEADER_DATA_STRING_COUNT 1
+
+static const uint16_t leader_data[LEADER_DATA_SIZE] PROGMEM = {
+    0x0004, KC_A, 9, KC_B, 19, KC_C, 24, KC_D, 32, 0x1001, KC_1, KC_B, 13, 0x1001, KC_2, KC_C, 17,
+    0x1000, KC_3, 0x0001, KC_C, 22, 0x1000, S(KC_4), 0x0001, KC_D, 27, 0x0001, KC_E, 30, 0x2000, 0,
+    0x0002, KC_F, 37, KC_G, 39, 0x3000, LEADER_ROLLBACK, 0x3000, LEADER_ROLLBACK
+};
+
+static const char leader_string_0[] PROGMEM = "cde";
+
+static const char *const leader_strings[LEADER_DATA_STRING_COUNT] PROGMEM = {
+    leader_string_0
+};
+#endif
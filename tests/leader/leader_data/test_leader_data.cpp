@@ -0,0 +1,196 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+#include "leader_data.h"
+
+using testing::_;
+
+static std::vector<uint16_t> user_sequences;
+
+extern "C" void leader_sequence_user(uint16_t id) {
+    user_sequences.push_back(id);
+}
+
+// Sequences matched the legacy way, next to the dictionary
+extern "C" void leader_end_user(void) {
+    if (leader_sequence_two_keys(KC_E, KC_F)) {
+        tap_code(KC_8);
+    } else if (leader_sequence_two_keys(KC_D, KC_E)) {
+        tap_code(KC_9);
+    }
+}
+
+class LeaderData : public TestFixture {
+   public:
+    KeymapKey key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    KeymapKey key_a      = KeymapKey(0, 1, 0, KC_A);
+    KeymapKey key_b      = KeymapKey(0, 2, 0, KC_B);
+    KeymapKey key_c      = KeymapKey(0, 3, 0, KC_C);
+    KeymapKey key_d      = KeymapKey(0, 4, 0, KC_D);
+    KeymapKey key_e      = KeymapKey(0, 5, 0, KC_E);
+    KeymapKey key_f      = KeymapKey(0, 6, 0, KC_F);
+    KeymapKey key_g      = KeymapKey(0, 7, 0, KC_G);
+    KeymapKey key_z      = KeymapKey(0, 8, 0, KC_Z);
+
+    void SetUp() override {
+        user_sequences.clear();
+        set_keymap({key_leader, key_a, key_b, key_c, key_d, key_e, key_f, key_g, key_z});
+    }
+};
+
+TEST_F(LeaderData, triggers_longest_sequence_without_timeout) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_a);
+    tap_key(key_b);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_3));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_c);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+}
+
+TEST_F(LeaderData, triggers_prefix_sequence_on_timeout) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), true);
+
+    EXPECT_REPORT(driver, (KC_1));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(300);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+}
+
+TEST_F(LeaderData, triggers_keycode_with_modifiers) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_b);
+    VERIFY_AND_CLEAR(driver);
+
+    testing::InSequence s;
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_4));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_c);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LeaderData, sends_string) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_c);
+    tap_key(key_d);
+    VERIFY_AND_CLEAR(driver);
+
+    testing::InSequence s;
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_D));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_E));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_e);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LeaderData, calls_user_sequence) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_d);
+    tap_key(key_f);
+    tap_key(key_leader);
+    tap_key(key_d);
+    tap_key(key_g);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(user_sequences, std::vector<uint16_t>({LEADER_ROLLBACK, LEADER_ROLLBACK}));
+    EXPECT_EQ(leader_sequence_active(), false);
+}
+
+TEST_F(LeaderData, waits_for_timeout_on_undefined_sequence) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_a);
+    tap_key(key_z);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), true);
+
+    // Nothing fires once the timeout expires
+    EXPECT_NO_REPORT(driver);
+    idle_for(300);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+
+    EXPECT_REPORT(driver, (KC_Z));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_z);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LeaderData, mixes_dictionary_and_leader_end_user) {
+    TestDriver driver;
+
+    // Not in the dictionary at all
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_e);
+    tap_key(key_f);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), true);
+
+    EXPECT_REPORT(driver, (KC_8));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(300);
+    VERIFY_AND_CLEAR(driver);
+
+    // Leaves the trie after its first key
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_d);
+    tap_key(key_e);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_9));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(300);
+    VERIFY_AND_CLEAR(driver);
+
+    // Dictionary sequences still end as soon as they match
+    EXPECT_REPORT(driver, (KC_3));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_a);
+    tap_key(key_b);
+    tap_key(key_c);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+}
@@ -0,0 +1,17 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// One virtual display per native format
+#define VIRTUAL_DISPLAY_NUM_DEVICES 3
+
+// One palette surface and one mono surface
+#define PALETTE_SURFACE_NUM_DEVICES 2
+
+#define QUANTUM_PAINTER_SUPPORTS_LZ 1
+
+// External flash is emulated in RAM by the test, the chip select pin is never used
+#define EXTERNAL_FLASH_SPI_SLAVE_SELECT_PIN NO_PIN
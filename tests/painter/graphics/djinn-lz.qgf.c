@@ -0,0 +1,170 @@
+// Copyright 2023 QMK -- generated source code only, image retains original copyright
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// This file was generated from keyboards/tzarc/djinn/graphics/djinn.qgf.c, with the pixel data recompressed using QMK LZ
+
+#include <qp.h>
+
+const uint32_t gfx_djinn_lz_length = 2504;
+
+// clang-format off
+const uint8_t gfx_djinn_lz[2504] = {
+    0x00, 0xFF, 0x12, 0x00, 0x00, 0x51, 0x47, 0x46, 0x01, 0xC8, 0x09, 0x00, 0x00, 0x37, 0xF6, 0xFF,
+    0xFF, 0x66, 0x00, 0x20, 0x01, 0x01, 0x00, 0x01, 0xFE, 0x04, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00,
+    0x02, 0xFD, 0x06, 0x00, 0x00, 0x01, 0x00, 0x02, 0xFF, 0xE8, 0x03, 0x05, 0xFA, 0x98, 0x09, 0x00,
+    0x00, 0x00, 0xD4, 0x00, 0x00, 0x90, 0x96, 0x19, 0x00, 0x2D, 0x95, 0x18, 0x01, 0xE0, 0x07, 0x95,
+    0x19, 0x01, 0xFE, 0x01, 0x94, 0x18, 0x01, 0xF4, 0x2F, 0x94, 0x18, 0x01, 0x80, 0xFF, 0x95, 0x4C,
+    0x01, 0xFD, 0xFF, 0x94, 0x4C, 0x01, 0xE0, 0xFF, 0x94, 0x4C, 0x03, 0x80, 0xFF, 0xFF, 0x03, 0x92,
+    0x18, 0x04, 0x40, 0xFE, 0xFF, 0x7F, 0x14, 0x92, 0x19, 0x04, 0xF9, 0xFF, 0xFF, 0x4B, 0x1A, 0x91,
+    0x18, 0x05, 0xE4, 0xFF, 0xFF, 0xFF, 0xE0, 0x06, 0x90, 0x18, 0x00, 0xD0, 0x80, 0x18, 0x01, 0x0F,
+    0xBE, 0x90, 0x9A, 0x80, 0x7D, 0x80, 0x32, 0x00, 0x6F, 0x90, 0x32, 0x00, 0xFE, 0x81, 0x32, 0x01,
+    0xFE, 0x0B, 0x8F, 0x18, 0x00, 0xF8, 0x82, 0x32, 0x01, 0xFF, 0x02, 0x90, 0xE2, 0x82, 0x32, 0x00,
+    0xBF, 0x93, 0x64, 0x03, 0xBF, 0xF4, 0xFF, 0x1F, 0x92, 0x64, 0x04, 0xFF, 0x47, 0xFF, 0xFF, 0x07,
+    0x8D, 0x18, 0x00, 0xF4, 0x81, 0x18, 0x02, 0x2F, 0xF8, 0xFF, 0x8E, 0x4C, 0x81, 0xC9, 0x03, 0xFF,
+    0xFF, 0xD1, 0xFF, 0x8E, 0x4C, 0x00, 0x40, 0x82, 0x4B, 0x00, 0x0B, 0x80, 0x05, 0x00, 0x06, 0x91,
+    0xB0, 0x00, 0x2F, 0x80, 0x51, 0x8D, 0x4C, 0x82, 0xB0, 0x00, 0xBF, 0x81, 0x51, 0x8C, 0x4C, 0x00,
+    0x40, 0x82, 0x18, 0x00, 0x41, 0x81, 0x05, 0x8C, 0x4C, 0x82, 0x4B, 0x01, 0x06, 0xFD, 0x80, 0x04,
+    0x00, 0x7F, 0x90, 0x4B, 0x01, 0x06, 0x90, 0x82, 0x83, 0x8F, 0x4B, 0x02, 0x1B, 0x00, 0xE4, 0x81,
+    0x06, 0x00, 0x01, 0x8E, 0x4B, 0x01, 0x1B, 0x00, 0x82, 0x19, 0x00, 0x2F, 0x8E, 0xE3, 0x00, 0x5B,
+    0x80, 0x07, 0x81, 0x19, 0x00, 0x07, 0x8A, 0x19, 0x80, 0xDD, 0x00, 0x6F, 0x81, 0x07, 0x00, 0xF9,
+    0x8D, 0x7F, 0x80, 0x7E, 0x83, 0x10, 0x80, 0x9A, 0x8A, 0x7F, 0x80, 0x7E, 0x00, 0xBF, 0x82, 0x76,
+    0x00, 0x40, 0x80, 0x3B, 0x8D, 0x7E, 0x00, 0x02, 0x82, 0x08, 0x80, 0xB4, 0x00, 0x0F, 0x89, 0x18,
+    0x00, 0x80, 0x86, 0x75, 0x00, 0xF4, 0x8C, 0x32, 0x02, 0xFD, 0xFF, 0x1F, 0x8E, 0x09, 0x84, 0xB1,
+    0x85, 0x8E, 0x80, 0x3C, 0x8A, 0xE5, 0x00, 0xFD, 0x84, 0x64, 0x81, 0x4C, 0x8A, 0x32, 0x00, 0xE0,
+    0x87, 0xA7, 0x00, 0xFE, 0x8B, 0x32, 0x00, 0xFE, 0x86, 0xDA, 0x00, 0xD0, 0x8D, 0x32, 0x85, 0x4B,
+    0x80, 0xBC, 0x8A, 0x98, 0x00, 0xFE, 0x86, 0x27, 0x00, 0x40, 0x8B, 0xCB, 0x00, 0xE0, 0x87, 0x5A,
+    0x00, 0xF4, 0x8C, 0xCB, 0x86, 0x7E, 0x01, 0x00, 0xFE, 0x87, 0x0A, 0x81, 0x74, 0x00, 0xBF, 0x87,
+    0x3D, 0x87, 0x0A, 0x81, 0x00, 0x01, 0xF9, 0x07, 0x87, 0x3D, 0x87, 0x0A, 0x81, 0xF4, 0x86, 0xB1,
+    0x01, 0x00, 0xD0, 0x87, 0x0A, 0x82, 0xA7, 0x87, 0x27, 0x01, 0xF9, 0x03, 0x89, 0x18, 0x00, 0x40,
+    0x87, 0x27, 0x01, 0x90, 0x2F, 0x8A, 0x32, 0x00, 0xE0, 0x87, 0x32, 0x00, 0xF8, 0x86, 0xEF, 0x82,
+    0x00, 0x00, 0x7D, 0x87, 0x70, 0x86, 0xEF, 0x83, 0x0E, 0x87, 0x32, 0x00, 0xB8, 0x8A, 0x18, 0x01,
+    0x00, 0x74, 0x87, 0x23, 0x8A, 0xE4, 0x02, 0x00, 0x00, 0x0A, 0x80, 0x03, 0x00, 0x04, 0x82, 0x09,
+    0x00, 0x78, 0x8B, 0x18, 0x00, 0x90, 0x80, 0x03, 0x03, 0xA4, 0x00, 0x80, 0x06, 0x80, 0x32, 0x8B,
+    0x7E, 0x80, 0x2E, 0x08, 0x40, 0xE9, 0x0B, 0x00, 0xF8, 0x5A, 0x00, 0x00, 0x14, 0x8B, 0x18, 0x80,
+    0xCE, 0x05, 0xFA, 0xBF, 0x00, 0x40, 0xFF, 0x6B, 0x8D, 0x16, 0x80, 0x4D, 0x06, 0xFE, 0xFF, 0x07,
+    0x00, 0xE0, 0xFF, 0xAF, 0x8E, 0x18, 0x02, 0x80, 0xFF, 0xFF, 0x80, 0xC4, 0x01, 0xF9, 0xFF, 0x8B,
+    0xFC, 0x81, 0x00, 0x02, 0xFE, 0xFF, 0x6F, 0x80, 0x05, 0x01, 0xFD, 0xFF, 0x8C, 0xB0, 0x04, 0x00,
+    0x00, 0xF8, 0xFF, 0x7F, 0x81, 0x6A, 0x01, 0xFE, 0xFF, 0x8D, 0x18, 0x03, 0xD0, 0xFF, 0xBF, 0x01,
+    0x82, 0x52, 0x80, 0x51, 0x8B, 0x00, 0x01, 0xFD, 0xFF, 0x82, 0xC3, 0x00, 0xD0, 0x83, 0x06, 0x88,
+    0x00, 0x00, 0xE0, 0x84, 0x5E, 0x00, 0xF8, 0x8D, 0x7F, 0x00, 0x40, 0x85, 0x91, 0x00, 0xFE, 0x8D,
+    0x32, 0x08, 0xF4, 0xFF, 0x01, 0x00, 0x50, 0x55, 0x05, 0x00, 0xD0, 0x81, 0x85, 0x8B, 0x32, 0x04,
+    0x07, 0x00, 0xA4, 0xAA, 0xAA, 0x80, 0x4C, 0x00, 0x07, 0x8D, 0x32, 0x80, 0xC9, 0x00, 0xFE, 0x80,
+    0x1D, 0x00, 0x40, 0x8F, 0x32, 0x00, 0x81, 0x82, 0xAE, 0x01, 0x40, 0xE0, 0x8D, 0xE5, 0x09, 0xF4,
+    0x1B, 0x1E, 0x00, 0xF0, 0xBF, 0x00, 0x00, 0x19, 0xBD, 0x8C, 0x18, 0x0B, 0x80, 0xBF, 0xF0, 0x02,
+    0x00, 0xFD, 0x07, 0x00, 0xE0, 0xC2, 0x0B, 0x05, 0x8B, 0x19, 0x05, 0xF8, 0x47, 0xBF, 0x00, 0x80,
+    0x2F, 0x80, 0x64, 0x01, 0xB8, 0x61, 0x8C, 0x65, 0x0A, 0x6F, 0xF8, 0x1F, 0x00, 0xF4, 0x01, 0x00,
+    0xF9, 0x47, 0x1F, 0x1E, 0x8C, 0x65, 0x0A, 0x82, 0xFF, 0x06, 0x00, 0x19, 0x00, 0xE4, 0xBF, 0xF0,
+    0xD1, 0x06, 0x8B, 0x32, 0x0B, 0x1F, 0xFD, 0xBF, 0x01, 0x40, 0x00, 0x90, 0xFF, 0x0B, 0x2E, 0xBD,
+    0x01, 0x8B, 0x32, 0x03, 0xE1, 0xFF, 0xBF, 0x01, 0x80, 0xB4, 0x02, 0xFF, 0xE0, 0x92, 0x80, 0xD5,
+    0x88, 0x00, 0x0C, 0x45, 0x1B, 0xFE, 0xFF, 0xBF, 0x05, 0x94, 0xFE, 0xFF, 0x1F, 0x2D, 0xF8, 0x1B,
+    0x89, 0x18, 0x03, 0x74, 0xB4, 0xE0, 0xFF, 0x83, 0x00, 0x03, 0xD1, 0x86, 0xFF, 0x07, 0x88, 0x18,
+    0x03, 0xD0, 0x47, 0x4B, 0xFE, 0x83, 0x18, 0x02, 0x2F, 0x7D, 0xF8, 0x80, 0x88, 0x86, 0x00, 0x03,
+    0x90, 0x7F, 0xB4, 0xF4, 0x84, 0x32, 0x01, 0xD2, 0x47, 0x81, 0x6E, 0x86, 0x18, 0x02, 0xFF, 0x87,
+    0x47, 0x84, 0x18, 0x02, 0x3F, 0xB8, 0xF4, 0x80, 0x6E, 0x85, 0x18, 0x04, 0x95, 0xFF, 0x3F, 0x78,
+    0xF8, 0x84, 0x19, 0x01, 0x83, 0x4B, 0x80, 0x04, 0x01, 0x56, 0x15, 0x81, 0x16, 0x06, 0x50, 0x55,
+    0xEA, 0xFF, 0xFF, 0x82, 0x86, 0x84, 0x18, 0x00, 0x7F, 0x82, 0x88, 0x01, 0xAF, 0x6A, 0x81, 0x48,
+    0x00, 0xFA, 0x80, 0x09, 0x80, 0xA8, 0x84, 0x19, 0x01, 0x0B, 0x19, 0x82, 0x88, 0x80, 0xD0, 0x00,
+    0x40, 0x83, 0xA8, 0x00, 0xD1, 0x84, 0x18, 0x01, 0xFF, 0x01, 0x83, 0xBB, 0x80, 0xD0, 0x00, 0xFD,
+    0x82, 0x28, 0x00, 0x0A, 0x84, 0xB1, 0x02, 0xFF, 0xBF, 0x41, 0x83, 0x07, 0x02, 0x02, 0x00, 0xE4,
+    0x82, 0x0E, 0x00, 0x10, 0x85, 0xB1, 0x01, 0xFF, 0xBF, 0x84, 0x6D, 0x01, 0x00, 0x80, 0x82, 0x07,
+    0x01, 0x1F, 0xD0, 0x86, 0x18, 0x01, 0x56, 0xF9, 0x84, 0x4C, 0x83, 0x07, 0x00, 0x9B, 0x85, 0x18,
+    0x02, 0x5A, 0x00, 0x00, 0x83, 0x3D, 0x01, 0x01, 0x90, 0x82, 0x06, 0x02, 0xAB, 0x5A, 0x55, 0x80,
+    0x00, 0x06, 0xA9, 0xAA, 0xAA, 0x01, 0x40, 0x55, 0x05, 0x81, 0x77, 0x03, 0xAA, 0x15, 0x00, 0x94,
+    0x80, 0xB1, 0x01, 0xBF, 0x56, 0x85, 0xEF, 0x04, 0x00, 0x95, 0xFA, 0xFF, 0x81, 0x80, 0xCA, 0x81,
+    0xE5, 0x0A, 0x40, 0xA5, 0xFA, 0xBF, 0x05, 0x50, 0x55, 0xAA, 0xAA, 0xAA, 0x16, 0x80, 0xF1, 0x0B,
+    0xE9, 0xFF, 0xBF, 0x2A, 0xA4, 0x56, 0x05, 0x00, 0x54, 0x65, 0x00, 0x59, 0x80, 0x3E, 0x01, 0x06,
+    0xA5, 0x81, 0x37, 0x10, 0x5A, 0x01, 0x40, 0xA5, 0xFE, 0xFF, 0x5A, 0x15, 0x00, 0x01, 0x00, 0x55,
+    0xAA, 0xFE, 0x07, 0xE0, 0xAF, 0x80, 0x48, 0x00, 0xE8, 0x80, 0x57, 0x01, 0x6B, 0x05, 0x81, 0x48,
+    0x00, 0xBF, 0x81, 0x45, 0x01, 0x95, 0xEA, 0x80, 0x27, 0x04, 0x00, 0xFE, 0xFF, 0xAF, 0x1A, 0x80,
+    0xF1, 0x01, 0xAF, 0x05, 0x82, 0x6F, 0x04, 0x6F, 0x01, 0x00, 0x54, 0xAA, 0x82, 0xF0, 0x00, 0x0B,
+    0x80, 0x14, 0x01, 0xFF, 0x82, 0x81, 0xBA, 0x00, 0x50, 0x80, 0x17, 0x80, 0x06, 0x00, 0x94, 0x82,
+    0x16, 0x83, 0x32, 0x06, 0xFF, 0x1F, 0xFD, 0xBF, 0x05, 0x00, 0xE9, 0x81, 0x0E, 0x01, 0x06, 0x40,
+    0x84, 0x17, 0x84, 0x32, 0x02, 0xE1, 0xBF, 0x01, 0x83, 0x29, 0x00, 0x06, 0x83, 0xD9, 0x83, 0x32,
+    0x80, 0xD2, 0x03, 0x1F, 0xFE, 0x01, 0xE5, 0x82, 0x0C, 0x01, 0x06, 0xA4, 0x86, 0x18, 0x02, 0xFF,
+    0x0B, 0xD0, 0x80, 0x04, 0x02, 0xD1, 0x0B, 0xF9, 0x82, 0x18, 0x00, 0x05, 0x82, 0x1F, 0x88, 0x32,
+    0x02, 0x2F, 0x7C, 0xF4, 0x8E, 0x18, 0x01, 0xFF, 0x07, 0x81, 0x57, 0x00, 0x42, 0x80, 0x99, 0x81,
+    0x18, 0x82, 0x82, 0x84, 0x00, 0x02, 0x7F, 0x00, 0xF8, 0x80, 0x12, 0x00, 0x10, 0x82, 0x4B, 0x8A,
+    0x18, 0x80, 0xA3, 0x80, 0x04, 0x00, 0x1F, 0x81, 0x6A, 0x01, 0xFF, 0x06, 0x81, 0xA3, 0x86, 0x00,
+    0x01, 0x2F, 0x00, 0x81, 0x60, 0x00, 0x47, 0x81, 0xAF, 0x02, 0x06, 0x00, 0xE4, 0x89, 0x19, 0x00,
+    0x01, 0x81, 0xE5, 0x83, 0x3C, 0x01, 0x90, 0x05, 0x87, 0xC9, 0x03, 0xFF, 0xFF, 0x1B, 0x00, 0x82,
+    0x47, 0x81, 0xBB, 0x04, 0x90, 0xFF, 0x16, 0x40, 0xFA, 0x88, 0x7E, 0x00, 0x00, 0x82, 0x7A, 0x80,
+    0x22, 0x05, 0x94, 0xFF, 0xFF, 0x5B, 0x00, 0xA5, 0x86, 0x19, 0x01, 0x02, 0x00, 0x81, 0x7F, 0x81,
+    0x18, 0x00, 0xD4, 0x80, 0x04, 0x02, 0x6F, 0x01, 0x94, 0x85, 0x34, 0x02, 0x1B, 0x00, 0x00, 0x83,
+    0x8E, 0x00, 0x1B, 0x82, 0x61, 0x03, 0xBF, 0x16, 0x40, 0xA5, 0x83, 0x75, 0x02, 0x6F, 0x00, 0x00,
+    0x81, 0xCC, 0x85, 0x18, 0x05, 0xFF, 0xFF, 0x6A, 0x01, 0x50, 0xA9, 0x81, 0x1A, 0x81, 0x18, 0x82,
+    0x99, 0x85, 0x18, 0x08, 0xFF, 0xAF, 0x16, 0x00, 0x50, 0x95, 0xAA, 0xAA, 0x56, 0x81, 0x18, 0x00,
+    0x40, 0x80, 0x19, 0x86, 0x18, 0x03, 0xFF, 0xFF, 0xAB, 0x05, 0x81, 0x14, 0x82, 0x00, 0x02, 0x40,
+    0xFA, 0xBF, 0x8A, 0xC5, 0x01, 0xAF, 0x55, 0x86, 0x1A, 0x01, 0x00, 0x00, 0x89, 0x18, 0x81, 0x86,
+    0x86, 0x34, 0x00, 0xE5, 0x8B, 0x18, 0x80, 0xC8, 0x84, 0x30, 0x83, 0xA5, 0x87, 0x00, 0x00, 0x07,
+    0x85, 0x32, 0x00, 0xF9, 0x8C, 0x18, 0x00, 0x1F, 0x86, 0x4B, 0x8C, 0x18, 0x00, 0x7F, 0x86, 0x7D,
+    0x00, 0xD0, 0x8C, 0x19, 0x00, 0x01, 0x86, 0x19, 0x00, 0xF8, 0x8B, 0x18, 0x00, 0x0B, 0x87, 0xB1,
+    0x8B, 0x7F, 0x00, 0x2F, 0x87, 0x18, 0x8B, 0x4C, 0x00, 0xBF, 0x87, 0x4B, 0x01, 0x00, 0xF4, 0x8A,
+    0x19, 0x00, 0x06, 0x88, 0xFE, 0x00, 0xFD, 0x92, 0xB0, 0x80, 0x00, 0x00, 0x80, 0x8A, 0x4B, 0x88,
+    0x18, 0x01, 0x00, 0xE4, 0x89, 0x19, 0x00, 0x02, 0x89, 0x19, 0x89, 0x4C, 0x89, 0x4B, 0x8A, 0x4C,
+    0x8A, 0x4B, 0x01, 0x00, 0xE0, 0x88, 0x19, 0x00, 0x07, 0x8A, 0x19, 0x88, 0x4C, 0x8A, 0x4B, 0x89,
+    0x4C, 0x8B, 0x4B, 0x89, 0x4C, 0x8B, 0x4B, 0x88, 0x4C, 0x00, 0x2F, 0x8B, 0x18, 0x88, 0x4C, 0x00,
+    0x01, 0x95, 0x4C, 0x00, 0x0B, 0x8B, 0x18, 0x87, 0x4C, 0x00, 0x7F, 0x8C, 0x18, 0x87, 0x4C, 0x00,
+    0x02, 0x8C, 0x19, 0x00, 0xF4, 0x93, 0xCA, 0x80, 0x00, 0x00, 0xFE, 0x93, 0xCA, 0x02, 0x00, 0x00,
+    0x90, 0x94, 0xCA, 0x87, 0x4C, 0x8C, 0xCA, 0x02, 0x00, 0x00, 0x40, 0x85, 0x4C, 0x8D, 0x7E, 0x01,
+    0x00, 0xD0, 0x95, 0x7E, 0x01, 0x00, 0xF8, 0x94, 0x7E, 0x86, 0xCC, 0x8E, 0x7E, 0x85, 0x7F, 0x00,
+    0x3F, 0x8E, 0x18, 0x85, 0xCC, 0x8E, 0x7E, 0x85, 0x7F, 0x8F, 0x7E, 0x01, 0x00, 0xFC, 0x94, 0x7E,
+    0x01, 0x00, 0x40, 0x95, 0x7E, 0x84, 0x7F, 0x00, 0x7F, 0x8F, 0x18, 0x84, 0x7F, 0x8F, 0x7E, 0x01,
+    0x00, 0xE0, 0x82, 0x18, 0x00, 0x2F, 0x90, 0x32, 0x00, 0xFD, 0x82, 0x19, 0x00, 0x01, 0x8F, 0x18,
+    0x83, 0xB2, 0x00, 0x1B, 0x90, 0x32, 0x00, 0xF8, 0x94, 0xB1, 0x01, 0x00, 0x80, 0x95, 0xB1, 0x83,
+    0x32, 0x91, 0xB1, 0x83, 0xE5, 0x90, 0xB1, 0x83, 0xE5, 0x91, 0xB1, 0x83, 0x32, 0x90, 0xB1, 0x83,
+    0x65, 0x91, 0xB1, 0x82, 0x98, 0x91, 0xB1, 0x83, 0x32, 0x91, 0xB1, 0x82, 0x32, 0x00, 0x6F, 0x96,
+    0x32, 0x91, 0xB1, 0x82, 0x32, 0x91, 0xB1, 0x01, 0x00, 0xFC, 0x95, 0xB1, 0x00, 0xD0, 0x81, 0x18,
+    0x00, 0x0B, 0x91, 0x32, 0x00, 0xFD, 0x80, 0x18, 0x00, 0x7F, 0x91, 0x18, 0x82, 0x32, 0x91, 0x7E,
+    0x82, 0x32, 0x00, 0x1F, 0x91, 0x18, 0x00, 0xE0, 0x81, 0x32, 0x91, 0x18, 0x01, 0x00, 0xFE, 0x95,
+    0x7E, 0x00, 0xF0, 0x95, 0x7E, 0x00, 0x00, 0x96, 0x7E, 0x00, 0xF4, 0x95, 0x7E, 0x00, 0x40, 0x80,
+    0x18, 0x00, 0xBF, 0x92, 0x4B, 0x00, 0xF8, 0x80, 0x19, 0x00, 0x07, 0x91, 0x18, 0x00, 0x80, 0x95,
+    0x4B, 0x01, 0x00, 0xFC, 0x80, 0x4B, 0x00, 0x01, 0x91, 0x18, 0x00, 0xD0, 0x95, 0x4B, 0x04, 0x00,
+    0xFD, 0xFF, 0xFF, 0x2F, 0x92, 0x18, 0x00, 0xE0, 0x95, 0x4B, 0x81, 0xE4, 0x93, 0x4B, 0x80, 0xE4,
+    0x93, 0x4B, 0x80, 0xE4, 0x93, 0xE3, 0x81, 0xE4, 0x93, 0x4B, 0x80, 0xB1, 0x93, 0xE3, 0x80, 0xB1,
+    0x94, 0x4B, 0x80, 0xB1, 0x00, 0x02, 0x93, 0x7E, 0x02, 0xFE, 0xFF, 0x0B, 0x93, 0x32, 0x02, 0xF4,
+    0xFF, 0x6F, 0x93, 0x18, 0x00, 0x80, 0x95, 0xFC, 0x80, 0x7E, 0x00, 0x06, 0x95, 0x7E, 0x94, 0x64,
+    0x02, 0x40, 0xFE, 0x2F, 0x93, 0x18, 0x01, 0x00, 0xF8, 0x94, 0xC9, 0x01, 0x00, 0x90, 0x95, 0x7D,
+    0x01, 0x00, 0xFE, 0x94, 0x7D, 0x02, 0x00, 0xF4, 0x1B, 0x94, 0x18, 0x00, 0x80, 0x95, 0x18, 0x01,
+    0x00, 0x2E, 0x95, 0x18, 0x00, 0x24, 0x95, 0x18, 0x00, 0x40, 0x95, 0x18, 0xFF, 0x00, 0xC3, 0x00,
+    0x02, 0x40, 0x55, 0x01, 0x81, 0x06, 0x03, 0xA9, 0x01, 0x50, 0x1A, 0x8C, 0x19, 0x02, 0xFD, 0xBF,
+    0x16, 0x80, 0x05, 0x04, 0xF9, 0xBF, 0x40, 0xFF, 0x1B, 0x8B, 0x18, 0x02, 0xD0, 0xAA, 0xFA, 0x80,
+    0x11, 0x05, 0xE0, 0x56, 0x1E, 0xB9, 0xE5, 0x06, 0x8B, 0x19, 0x0A, 0x1D, 0x40, 0xE5, 0x0B, 0x00,
+    0x40, 0x1B, 0xD0, 0xE6, 0x02, 0x78, 0x8C, 0x32, 0x01, 0x01, 0x00, 0x80, 0x2B, 0x05, 0x74, 0x00,
+    0x78, 0x1E, 0x40, 0x0B, 0x8C, 0x32, 0x09, 0x00, 0x00, 0xB9, 0x00, 0x40, 0x07, 0x80, 0xA7, 0x01,
+    0xB4, 0x8E, 0x32, 0x05, 0x40, 0x2E, 0x00, 0xB4, 0x00, 0x6D, 0x91, 0x32, 0x07, 0x90, 0x07, 0x40,
+    0x2E, 0xE4, 0xD2, 0x07, 0x7D, 0x8E, 0x32, 0x80, 0x30, 0x04, 0x90, 0xFF, 0x0B, 0xF8, 0xFF, 0x82,
+    0xD4, 0x89, 0x32, 0x07, 0x01, 0x00, 0x1E, 0x00, 0xA4, 0x1A, 0x00, 0xA9, 0x8C, 0xB1, 0x05, 0xD0,
+    0x01, 0xA0, 0x01, 0xD0, 0x03, 0x8C, 0xF9, 0x84, 0x32, 0x01, 0x6E, 0x00, 0x8C, 0xC5, 0x85, 0x32,
+    0x01, 0xE0, 0x0B, 0x8D, 0x92, 0x85, 0x32, 0x10, 0xFE, 0x01, 0xE0, 0x01, 0x55, 0x55, 0x41, 0x55,
+    0x15, 0x40, 0x06, 0x90, 0x5A, 0x00, 0x00, 0x16, 0x50, 0x80, 0x04, 0x83, 0x32, 0x11, 0x2E, 0x00,
+    0x2E, 0xE0, 0xFF, 0x2F, 0xF9, 0xFF, 0x06, 0xF8, 0x86, 0xFF, 0x1B, 0x00, 0xF8, 0x46, 0xFE, 0x1B,
+    0x84, 0x32, 0x12, 0xDE, 0x07, 0xD0, 0x02, 0xAE, 0xEA, 0xD2, 0xAA, 0x7E, 0xE0, 0xBA, 0x7E, 0xE5,
+    0x07, 0xE0, 0xBB, 0xBE, 0xE5, 0x07, 0x84, 0x32, 0x11, 0x79, 0x00, 0x3C, 0xE0, 0x01, 0x2D, 0x1D,
+    0x80, 0x87, 0x4F, 0xBE, 0x01, 0xB4, 0x41, 0x1F, 0xFE, 0x01, 0xF4, 0x82, 0xD5, 0x14, 0x1D, 0x00,
+    0x5E, 0x0B, 0x80, 0x07, 0x1E, 0xD0, 0xD2, 0x01, 0x78, 0x3E, 0x90, 0x06, 0x00, 0x1E, 0x7D, 0x80,
+    0x07, 0x00, 0x2D, 0x84, 0x32, 0x02, 0xB5, 0x00, 0xB4, 0x82, 0x32, 0x05, 0xFB, 0x01, 0x14, 0x00,
+    0xD0, 0xF6, 0x80, 0x04, 0x00, 0x90, 0x82, 0xDB, 0x02, 0x1D, 0x00, 0x1E, 0x80, 0xB2, 0x81, 0x32,
+    0x06, 0xB8, 0x0B, 0x00, 0x14, 0x00, 0xA9, 0x1F, 0x80, 0x04, 0x82, 0xDB, 0x80, 0x32, 0x02, 0xB1,
+    0x01, 0xB0, 0x82, 0x32, 0x07, 0xE7, 0x01, 0x90, 0x06, 0x80, 0xE7, 0x02, 0x90, 0x80, 0x5B, 0x84,
+    0x32, 0x02, 0x1A, 0x00, 0x1F, 0x82, 0x65, 0x02, 0x2D, 0x40, 0xFB, 0x81, 0x04, 0x01, 0xEE, 0x01,
+    0x85, 0x32, 0x00, 0xE1, 0x81, 0x02, 0x80, 0x32, 0x08, 0xD7, 0x02, 0x74, 0x1E, 0x80, 0xC7, 0x03,
+    0xB4, 0x2D, 0x86, 0x32, 0x00, 0x1E, 0x80, 0x02, 0x83, 0x32, 0x06, 0xE7, 0x01, 0x78, 0x3C, 0x40,
+    0xDB, 0x02, 0xB8, 0x32, 0x03, 0xD1, 0x01, 0xD0, 0xE2, 0x93, 0x32, 0x02, 0x1D, 0x00, 0x2D, 0xFF,
+    0x32, 0x93, 0x32, 0x00, 0x1D, 0x95, 0x32, 0xAE, 0xFE, 0x00, 0xE1, 0xB1, 0x32, 0x00, 0xF0, 0x94,
+    0x32, 0x02, 0x1A, 0x00, 0x0B, 0x93, 0x32, 0x03, 0xA1, 0x01, 0xB4, 0xE0, 0x93, 0x32, 0x01, 0x0B,
+    0x40, 0x94, 0x32, 0x02, 0xB5, 0x00, 0x78, 0x93, 0x32, 0x03, 0x5E, 0x0B, 0x80, 0x07, 0x93, 0x32,
+    0x02, 0x79, 0x00, 0x3C, 0x93, 0x32, 0x03, 0xDE, 0x02, 0xD0, 0x02, 0x93, 0x32, 0x02, 0x2E, 0x00,
+    0x1E, 0x93, 0x32, 0x03, 0xFE, 0x01, 0xE0, 0x00, 0x93, 0x32, 0x02, 0x07, 0x40, 0x0B, 0x94, 0xCB,
+    0x01, 0x00, 0x78, 0x93, 0x32, 0x03, 0x60, 0x00, 0xD0, 0x02, 0x93, 0x32, 0x00, 0x00, 0x80, 0x34,
+    0x92, 0x32, 0x03, 0x00, 0x00, 0xB4, 0x00, 0x94, 0x32, 0x01, 0xD0, 0x07, 0x94, 0x32, 0x01, 0x40,
+    0x1F, 0x95, 0x32, 0x00, 0x7D, 0x80, 0x67, 0x91, 0x32, 0x02, 0x40, 0xF9, 0x01, 0x92, 0x32, 0x14,
+    0x6D, 0x95, 0xFA, 0x06, 0x00, 0x40, 0x1A, 0xD0, 0xD2, 0x56, 0x79, 0x6D, 0x95, 0xE7, 0x56, 0x79,
+    0x7C, 0x95, 0xDB, 0x56, 0x79, 0x82, 0x32, 0x13, 0xFF, 0xBF, 0x06, 0x00, 0x00, 0xB8, 0x00, 0x2D,
+    0xFD, 0xFF, 0xD7, 0xFF, 0x7F, 0xFE, 0xFF, 0xC7, 0xFF, 0xBF, 0xFD, 0xFF, 0x82, 0x32, 0x0D, 0x55,
+    0x55, 0x05, 0x00, 0x00, 0xE4, 0x07, 0xD0, 0x52, 0x55, 0x15, 0x54, 0x55, 0x51, 0x81, 0x04, 0x02,
+    0x45, 0x55, 0x15, 0x81, 0x18, 0x82, 0x00, 0x03, 0x40, 0x1B, 0x00, 0x2D, 0x86, 0x0C, 0x8A, 0x00,
+    0x81, 0xE6, 0x92, 0x18, 0x03, 0x40, 0x0B, 0x40, 0x0B, 0x95, 0x32, 0x80, 0xCF, 0x93, 0x32, 0x00,
+    0xF5, 0x93, 0x4B, 0x02, 0x00, 0xB4, 0xE5, 0x82, 0xA4, 0x90, 0x32, 0x01, 0xFF, 0x1B, 0x93, 0x18,
+    0x02, 0x00, 0xA4, 0x16, 0x94, 0x18, 0xC3, 0x00,
+};
+// clang-format on
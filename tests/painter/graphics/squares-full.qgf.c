@@ -0,0 +1,226 @@
+// Copyright 2023 QMK -- generated source code only, image retains original copyright
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// This file was generated by the QGF encoder used by `qmk painter-convert-graphics -f pal16 -d`, from the same animation
+// as squares.qgf.c, without delta frames
+
+#include <qp.h>
+
+const uint32_t gfx_squares_full_length = 3392;
+
+// clang-format off
+const uint8_t gfx_squares_full[3392] = {
+    0x00, 0xFF, 0x12, 0x00, 0x00, 0x51, 0x47, 0x46, 0x01, 0x40, 0x0D, 0x00, 0x00, 0xBF, 0xF2, 0xFF,
+    0xFF, 0x30, 0x00, 0x20, 0x00, 0x04, 0x00, 0x01, 0xFE, 0x10, 0x00, 0x00, 0x2C, 0x00, 0x00, 0x00,
+    0x71, 0x03, 0x00, 0x00, 0xB6, 0x06, 0x00, 0x00, 0xFB, 0x09, 0x00, 0x00, 0x02, 0xFD, 0x06, 0x00,
+    0x00, 0x06, 0x00, 0x00, 0xFF, 0xE8, 0x03, 0x03, 0xFC, 0x30, 0x00, 0x00, 0x55, 0xFF, 0xFF, 0x00,
+    0x00, 0x50, 0x00, 0xFF, 0xFF, 0xAA, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0xFA, 0x00, 0x03,
+    0x00, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x33, 0x22, 0x22, 0x22, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x13, 0x22, 0x22, 0x22, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x11, 0x22, 0x22, 0x22, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x31, 0x22, 0x22, 0x22, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x33, 0x22, 0x22, 0x22, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x13, 0x22, 0x22, 0x22, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x00, 0x00, 0x00, 0x33, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x00, 0x00, 0x00,
+    0x13, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x00, 0x00, 0x00, 0x11, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x00, 0x00, 0x00,
+    0x31, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x00, 0x00, 0x00, 0x33, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x00, 0x00, 0x00,
+    0x13, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x02, 0xFD, 0x06, 0x00, 0x00, 0x06, 0x00, 0x00, 0xFF, 0xE8, 0x03, 0x03, 0xFC, 0x30, 0x00,
+    0x00, 0x55, 0xFF, 0xFF, 0x00, 0x00, 0x50, 0x00, 0xFF, 0xFF, 0xAA, 0xFF, 0x30, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x05, 0xFA, 0x00, 0x03, 0x00, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x33, 0x11, 0x23, 0x22, 0x22, 0x12, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x13, 0x31,
+    0x23, 0x22, 0x22, 0x32, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x11, 0x33, 0x21, 0x22, 0x22, 0x32, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x31, 0x13,
+    0x21, 0x22, 0x22, 0x12, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x33, 0x11, 0x23, 0x22, 0x22, 0x12, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x13, 0x31,
+    0x23, 0x22, 0x22, 0x32, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x00, 0x00, 0x00, 0x11, 0x33, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x00, 0x00, 0x00, 0x31, 0x13, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x00, 0x00, 0x00, 0x33, 0x11, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x00, 0x00, 0x00, 0x13, 0x31, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x00, 0x00, 0x00, 0x11, 0x33, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x00, 0x00, 0x00, 0x31, 0x13, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x02, 0xFD, 0x06, 0x00, 0x00, 0x06, 0x00, 0x00, 0xFF, 0xE8,
+    0x03, 0x03, 0xFC, 0x30, 0x00, 0x00, 0x55, 0xFF, 0xFF, 0x00, 0x00, 0x50, 0x00, 0xFF, 0xFF, 0xAA,
+    0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0xFA, 0x00, 0x03, 0x00, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x33, 0x11, 0x33, 0x11, 0x22,
+    0x22, 0x22, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x13, 0x31, 0x13, 0x31, 0x22, 0x22, 0x22, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x11, 0x33, 0x11, 0x33, 0x22,
+    0x22, 0x22, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x31, 0x13, 0x31, 0x13, 0x22, 0x22, 0x22, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x33, 0x11, 0x33, 0x11, 0x22,
+    0x22, 0x22, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x13, 0x31, 0x13, 0x31, 0x22, 0x22, 0x22, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x00, 0x00, 0x00,
+    0x33, 0x11, 0x33, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x00, 0x00, 0x00, 0x13, 0x31, 0x13, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x00, 0x00, 0x00,
+    0x11, 0x33, 0x11, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x00, 0x00, 0x00, 0x31, 0x13, 0x31, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x00, 0x00, 0x00,
+    0x33, 0x11, 0x33, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x00, 0x00, 0x00, 0x13, 0x31, 0x13, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x02, 0xFD, 0x06, 0x00, 0x00,
+    0x06, 0x00, 0x00, 0xFF, 0xE8, 0x03, 0x03, 0xFC, 0x30, 0x00, 0x00, 0x55, 0xFF, 0xFF, 0x00, 0x00,
+    0x50, 0x00, 0xFF, 0xFF, 0xAA, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0xFA, 0x00, 0x03, 0x00,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x21, 0x22, 0x22, 0x32, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x13, 0x31, 0x13, 0x31, 0x13, 0x21, 0x22, 0x22,
+    0x12, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x23, 0x22, 0x22, 0x12, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x31, 0x13, 0x31, 0x13, 0x31, 0x23, 0x22, 0x22,
+    0x32, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x21, 0x22, 0x22, 0x32, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x13, 0x31, 0x13, 0x31, 0x13, 0x21, 0x22, 0x22,
+    0x12, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x00, 0x00, 0x00, 0x11, 0x33, 0x11, 0x33, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x00, 0x00, 0x00, 0x31, 0x13, 0x31, 0x13,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x00, 0x00, 0x00, 0x33, 0x11, 0x33, 0x11, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x00, 0x00, 0x00, 0x13, 0x31, 0x13, 0x31,
+    0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33,
+    0x11, 0x00, 0x00, 0x00, 0x11, 0x33, 0x11, 0x33, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13,
+    0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x00, 0x00, 0x00, 0x31, 0x13, 0x31, 0x13,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11,
+    0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x33, 0x11, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+    0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31, 0x13, 0x31,
+};
+// clang-format on
@@ -0,0 +1,79 @@
+// Copyright 2023 QMK -- generated source code only, font retains original copyright
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// This file was generated from keyboards/tzarc/djinn/graphics/thintel15.qff.c, with the pixel data recompressed using QMK LZ
+
+#include <qp.h>
+
+const uint32_t font_thintel15_lz_length = 1054;
+
+// clang-format off
+const uint8_t font_thintel15_lz[1054] = {
+    0x00, 0xFF, 0x14, 0x00, 0x00, 0x51, 0x46, 0x46, 0x01, 0x1E, 0x04, 0x00, 0x00, 0xE1, 0xFB, 0xFF,
+    0xFF, 0x0B, 0x01, 0x00, 0x00, 0x00, 0x00, 0x02, 0xFF, 0x01, 0xFE, 0x1D, 0x01, 0x00, 0x02, 0x00,
+    0x00, 0x02, 0x01, 0x00, 0x04, 0x02, 0x00, 0x86, 0x03, 0x00, 0x06, 0x06, 0x00, 0x88, 0x08, 0x00,
+    0x86, 0x0B, 0x00, 0x02, 0x0E, 0x00, 0x03, 0x0F, 0x00, 0x83, 0x10, 0x00, 0x04, 0x12, 0x00, 0xC6,
+    0x13, 0x00, 0x03, 0x16, 0x00, 0x85, 0x17, 0x00, 0x42, 0x19, 0x00, 0x44, 0x1A, 0x00, 0x05, 0x1C,
+    0x00, 0x04, 0x1E, 0x00, 0xC5, 0x1F, 0x00, 0xC5, 0x21, 0x00, 0xC5, 0x23, 0x00, 0xC5, 0x25, 0x00,
+    0xC5, 0x27, 0x00, 0xC5, 0x29, 0x00, 0xC5, 0x2B, 0x00, 0xC5, 0x2D, 0x00, 0xC2, 0x2F, 0x00, 0xC3,
+    0x30, 0x00, 0x45, 0x32, 0x00, 0x45, 0x34, 0x00, 0x45, 0x36, 0x00, 0x45, 0x38, 0x00, 0x48, 0x3A,
+    0x00, 0x45, 0x3D, 0x00, 0x45, 0x3F, 0x00, 0x45, 0x41, 0x00, 0x45, 0x43, 0x00, 0x44, 0x45, 0x00,
+    0x04, 0x47, 0x00, 0xC5, 0x48, 0x00, 0xC5, 0x4A, 0x00, 0xC4, 0x4C, 0x00, 0x85, 0x4E, 0x00, 0x85,
+    0x50, 0x00, 0x84, 0x52, 0x00, 0x46, 0x54, 0x00, 0xC6, 0x56, 0x00, 0x45, 0x59, 0x00, 0x45, 0x5B,
+    0x00, 0x45, 0x5D, 0x00, 0x45, 0x5F, 0x00, 0x45, 0x61, 0x00, 0x46, 0x63, 0x00, 0xC5, 0x65, 0x00,
+    0xC6, 0x67, 0x00, 0x46, 0x6A, 0x00, 0xC6, 0x6C, 0x00, 0x46, 0x6F, 0x00, 0xC6, 0x71, 0x00, 0x44,
+    0x74, 0x00, 0x04, 0x76, 0x00, 0xC4, 0x77, 0x00, 0x86, 0x79, 0x00, 0x45, 0x7B, 0x00, 0x43, 0x7D,
+    0x00, 0x85, 0x7E, 0x00, 0x85, 0x80, 0x00, 0x84, 0x82, 0x00, 0x45, 0x84, 0x00, 0x45, 0x86, 0x00,
+    0x44, 0x88, 0x00, 0x05, 0x8A, 0x00, 0x05, 0x8C, 0x00, 0x02, 0x8E, 0x00, 0x03, 0x8F, 0x00, 0x85,
+    0x90, 0x00, 0x82, 0x92, 0x00, 0x86, 0x93, 0x00, 0x05, 0x96, 0x00, 0x05, 0x98, 0x00, 0x05, 0x9A,
+    0x00, 0x05, 0x9C, 0x00, 0x04, 0x9E, 0x00, 0xC5, 0x9F, 0x00, 0xC3, 0xA1, 0x00, 0x45, 0xA3, 0x00,
+    0x46, 0xA5, 0x00, 0xC6, 0xA7, 0x00, 0x46, 0xAA, 0x00, 0xC5, 0xAC, 0x00, 0xC4, 0xAE, 0x00, 0x85,
+    0xB0, 0x00, 0x82, 0xB2, 0x00, 0x85, 0xB3, 0x00, 0x85, 0xB5, 0x00, 0x04, 0xFB, 0xDE, 0x02, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x02, 0x54, 0x45, 0x00, 0x02, 0x50, 0x05, 0x00, 0x80, 0x00, 0x08, 0x00,
+    0x45, 0xFD, 0xD2, 0xAF, 0x28, 0x00, 0x00, 0x00, 0x08, 0x84, 0x53, 0x15, 0x0E, 0x55, 0x39, 0x04,
+    0x00, 0x00, 0x0A, 0x00, 0x00, 0x12, 0x15, 0x0A, 0x28, 0x54, 0x24, 0x00, 0x00, 0x00, 0x08, 0x80,
+    0x50, 0x14, 0x52, 0x95, 0x58, 0x00, 0x00, 0x00, 0x02, 0x14, 0x00, 0x00, 0x04, 0x4A, 0x92, 0x24,
+    0x02, 0x00, 0x04, 0x91, 0x24, 0x49, 0x01, 0x00, 0x05, 0x20, 0x27, 0x05, 0x00, 0x00, 0x00, 0x05,
+    0x00, 0x40, 0x10, 0x1F, 0x41, 0x00, 0x80, 0x00, 0x04, 0x00, 0x00, 0x60, 0x0A, 0x00, 0x03, 0x00,
+    0x00, 0xF0, 0x00, 0x80, 0x00, 0x02, 0x00, 0x40, 0x00, 0x05, 0x40, 0x24, 0x22, 0x11, 0x00, 0x00,
+    0x06, 0xC0, 0xA4, 0x94, 0x52, 0x32, 0x00, 0x00, 0x05, 0x20, 0x23, 0x22, 0x72, 0x00, 0x00, 0x06,
+    0xC0, 0x24, 0x44, 0x44, 0x78, 0x00, 0x00, 0x06, 0xC0, 0x24, 0x44, 0x50, 0x32, 0x00, 0x00, 0x06,
+    0x80, 0x29, 0x95, 0x1E, 0x42, 0x00, 0x00, 0x06, 0xE0, 0x85, 0x83, 0x50, 0x32, 0x00, 0x00, 0x06,
+    0xC0, 0xA4, 0x70, 0x52, 0x32, 0x00, 0x00, 0x06, 0xE0, 0x21, 0x42, 0x84, 0x10, 0x00, 0x00, 0x06,
+    0xC0, 0xA4, 0x64, 0x52, 0x32, 0x00, 0x00, 0x06, 0xC0, 0xA4, 0xE4, 0x50, 0x32, 0x00, 0x00, 0x02,
+    0x00, 0x41, 0x00, 0x04, 0x00, 0x30, 0x60, 0x0A, 0x00, 0x06, 0x00, 0x11, 0x11, 0x04, 0x41, 0x00,
+    0x00, 0x06, 0x00, 0x80, 0x07, 0x1E, 0x00, 0x00, 0x00, 0x06, 0x20, 0x08, 0x82, 0x88, 0x08, 0x00,
+    0x00, 0x06, 0xC0, 0x24, 0x64, 0x04, 0x10, 0x00, 0x00, 0x0A, 0x00, 0x1C, 0x22, 0x59, 0x55, 0x2D,
+    0x02, 0x1C, 0x00, 0x00, 0x00, 0x06, 0xC0, 0xA4, 0xF4, 0x52, 0x4A, 0x00, 0x00, 0x06, 0xE0, 0xA4,
+    0x74, 0x52, 0x3A, 0x00, 0x00, 0x06, 0xC0, 0xA4, 0x10, 0x42, 0x32, 0x00, 0x00, 0x06, 0xE0, 0xA4,
+    0x94, 0x52, 0x3A, 0x00, 0x00, 0x05, 0x70, 0x11, 0x17, 0x71, 0x00, 0x00, 0x05, 0x70, 0x11, 0x17,
+    0x11, 0x00, 0x00, 0x06, 0xC0, 0xA4, 0xD0, 0x52, 0x32, 0x00, 0x00, 0x06, 0x20, 0xA5, 0xF4, 0x52,
+    0x4A, 0x00, 0x00, 0x05, 0x70, 0x22, 0x22, 0x72, 0x00, 0x00, 0x06, 0xC0, 0x21, 0x84, 0x50, 0x32,
+    0x00, 0x00, 0x06, 0x20, 0xA5, 0x32, 0x4A, 0x4A, 0x00, 0x00, 0x05, 0x10, 0x11, 0x11, 0x71, 0x00,
+    0x00, 0x08, 0x40, 0xB4, 0x55, 0x51, 0x14, 0x45, 0x00, 0x00, 0x00, 0x08, 0x40, 0x34, 0x55, 0x59,
+    0x14, 0x45, 0x00, 0x00, 0x00, 0x06, 0xC0, 0xA4, 0x94, 0x52, 0x32, 0x00, 0x00, 0x06, 0xE0, 0xA4,
+    0x74, 0x42, 0x08, 0x00, 0x00, 0x06, 0xC0, 0xA4, 0x94, 0x52, 0x51, 0x00, 0x00, 0x06, 0xE0, 0xA4,
+    0x74, 0x52, 0x4A, 0x00, 0x00, 0x06, 0xC0, 0xA4, 0x60, 0x50, 0x32, 0x00, 0x00, 0x08, 0xC0, 0x47,
+    0x10, 0x04, 0x41, 0x10, 0x00, 0x00, 0x00, 0x06, 0x20, 0xA5, 0x94, 0x52, 0x32, 0x00, 0x00, 0x08,
+    0x40, 0x14, 0x45, 0x51, 0xA4, 0x10, 0x00, 0x00, 0x00, 0x08, 0x40, 0x14, 0x45, 0x51, 0xB5, 0x45,
+    0x00, 0x00, 0x00, 0x08, 0x40, 0x14, 0x29, 0x84, 0x12, 0x45, 0x00, 0x00, 0x00, 0x08, 0x40, 0x14,
+    0x45, 0x0E, 0x41, 0x10, 0x00, 0x00, 0x00, 0x08, 0xC0, 0x07, 0x21, 0x84, 0x10, 0x7C, 0x00, 0x00,
+    0x00, 0x05, 0x17, 0x11, 0x11, 0x11, 0x07, 0x00, 0x05, 0x10, 0x21, 0x22, 0x44, 0x00, 0x00, 0x05,
+    0x47, 0x44, 0x44, 0x44, 0x07, 0x00, 0x03, 0x84, 0x12, 0x01, 0x00, 0x82, 0x00, 0x00, 0x00, 0x80,
+    0x00, 0x02, 0x78, 0x00, 0x00, 0x01, 0x11, 0x00, 0x80, 0x00, 0x06, 0x00, 0x00, 0x93, 0x5C, 0x72,
+    0x00, 0x00, 0x06, 0x20, 0x84, 0x93, 0x52, 0x3A, 0x00, 0x00, 0x05, 0x00, 0x60, 0x11, 0x61, 0x00,
+    0x00, 0x06, 0x00, 0x21, 0x97, 0x52, 0x72, 0x00, 0x00, 0x06, 0x00, 0x00, 0x93, 0x5E, 0x70, 0x00,
+    0x00, 0x05, 0x60, 0x11, 0x13, 0x11, 0x00, 0x00, 0x06, 0x00, 0x00, 0x97, 0x52, 0x72, 0x28, 0x19,
+    0x06, 0x20, 0x84, 0x93, 0x52, 0x4A, 0x00, 0x00, 0x02, 0x10, 0x55, 0x00, 0x04, 0x80, 0x20, 0x49,
+    0x0A, 0x00, 0x06, 0x20, 0x84, 0x94, 0x4E, 0x4A, 0x00, 0x00, 0x02, 0x54, 0x55, 0x00, 0x08, 0x00,
+    0x00, 0x2C, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x06, 0x00, 0x80, 0x93, 0x52, 0x4A, 0x00, 0x00,
+    0x06, 0x00, 0x00, 0x93, 0x52, 0x32, 0x00, 0x00, 0x06, 0x00, 0x80, 0x93, 0x52, 0x3A, 0x21, 0x00,
+    0x06, 0x00, 0x00, 0x97, 0x52, 0x72, 0x08, 0x01, 0x05, 0x00, 0x50, 0x13, 0x11, 0x00, 0x00, 0x06,
+    0x00, 0x00, 0x17, 0x0C, 0x3A, 0x00, 0x00, 0x04, 0x48, 0x96, 0x44, 0x00, 0x00, 0x06, 0x00, 0x80,
+    0x94, 0x52, 0x72, 0x00, 0x00, 0x08, 0x00, 0x00, 0x44, 0x51, 0xA4, 0x10, 0x00, 0x00, 0x00, 0x08,
+    0x00, 0x00, 0x44, 0x51, 0x54, 0x6D, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x44, 0x0A, 0xA1, 0x44,
+    0x00, 0x00, 0x00, 0x06, 0x00, 0x80, 0x94, 0x52, 0x72, 0x28, 0x19, 0x05, 0x00, 0x70, 0x24, 0x71,
+    0x00, 0x00, 0x06, 0x4C, 0x08, 0x11, 0x84, 0x10, 0x0C, 0x00, 0x02, 0x55, 0x55, 0x01, 0x06, 0x83,
+    0x10, 0x82, 0x08, 0x21, 0x03, 0x00, 0x06, 0x00, 0x00, 0xB0, 0x1A, 0x00, 0x00, 0x00,
+};
+// clang-format on
@@ -0,0 +1,19 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+QUANTUM_PAINTER_ENABLE = yes
+QUANTUM_PAINTER_DRIVERS = virtual_display palette_surface
+
+# External flash is emulated in RAM by the test
+OPT_DEFS += -DFLASH_ENABLE
+COMMON_VPATH += $(DRIVER_PATH)/flash
+
+# Stock assets rendered by the benchmark
+SRC += \
+    keyboards/tzarc/djinn/graphics/djinn.qgf.c \
+    keyboards/tzarc/djinn/graphics/lock-caps-ON.qgf.c \
+    keyboards/tzarc/djinn/graphics/thintel15.qff.c \
+    tests/painter/graphics/djinn-lz.qgf.c \
+    tests/painter/graphics/thintel15-lz.qff.c \
+    tests/painter/graphics/squares.qgf.c \
+    tests/painter/graphics/squares-full.qgf.c
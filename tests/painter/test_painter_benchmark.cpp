@@ -0,0 +1,624 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "qp.h"
+#include "flash_spi.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+void qp_internal_task(void);
+
+extern const uint32_t gfx_djinn_length;
+extern const uint32_t font_thintel15_length;
+extern const uint8_t gfx_djinn[];
+extern const uint8_t gfx_lock_caps_ON[];
+extern const uint8_t font_thintel15[];
+extern const uint8_t gfx_djinn_lz[];
+extern const uint8_t font_thintel15_lz[];
+extern const uint8_t gfx_squares[];
+extern const uint8_t gfx_squares_full[];
+}
+
+namespace {
+
+const uint16_t panel_width  = 240;
+const uint16_t panel_height = 320;
+
+uint8_t buffers[3][VIRTUAL_DISPLAY_BUFFER_SIZE(panel_width, panel_height)];
+
+painter_device_t display_for(qp_virtual_display_format_t format) {
+    static painter_device_t displays[3] = {nullptr};
+    if (!displays[format]) {
+        displays[format] = qp_virtual_display_make_device(panel_width, panel_height, format, buffers[format]);
+    }
+    return displays[format];
+}
+
+// FNV-1a over the panel contents, used for golden image comparisons
+uint32_t panel_hash(painter_device_t device) {
+    uint32_t hash = 2166136261u;
+    for (uint16_t y = 0; y < panel_height; y++) {
+        for (uint16_t x = 0; x < panel_width; x++) {
+            RGB pixel = qp_virtual_display_get_pixel(device, x, y);
+            for (uint8_t component : {pixel.r, pixel.g, pixel.b}) {
+                hash = (hash ^ component) * 16777619u;
+            }
+        }
+    }
+    return hash;
+}
+
+void put_block(std::vector<uint8_t> &qgf, uint8_t type_id, const std::vector<uint8_t> &blob) {
+    qgf.insert(qgf.end(), {type_id, (uint8_t)~type_id, (uint8_t)blob.size(), (uint8_t)(blob.size() >> 8), (uint8_t)(blob.size() >> 16)});
+    qgf.insert(qgf.end(), blob.begin(), blob.end());
+}
+
+void put_u16(std::vector<uint8_t> &data, uint16_t value) {
+    data.insert(data.end(), {(uint8_t)value, (uint8_t)(value >> 8)});
+}
+
+void put_u32(std::vector<uint8_t> &data, uint32_t value) {
+    put_u16(data, value);
+    put_u16(data, value >> 16);
+}
+
+/* Builds an uncompressed QGF animation of a 4x4 square moving diagonally
+ * across a 16x16 image, with a different palette for every frame. */
+std::vector<uint8_t> make_animation(uint16_t frame_count, uint16_t delay) {
+    const uint16_t       size        = 16;
+    const uint32_t       frame_bytes = 11 + 17 + 5 + size * size / 4;
+    const uint32_t       header      = 23 + 5 + frame_count * 4;
+    const uint32_t       total       = header + frame_count * frame_bytes;
+    std::vector<uint8_t> qgf;
+
+    std::vector<uint8_t> descriptor = {0x51, 0x47, 0x46, 0x01};
+    put_u32(descriptor, total);
+    put_u32(descriptor, ~total);
+    put_u16(descriptor, size);
+    put_u16(descriptor, size);
+    put_u16(descriptor, frame_count);
+    put_block(qgf, 0x00, descriptor);
+
+    std::vector<uint8_t> offsets;
+    for (uint16_t frame = 0; frame < frame_count; frame++) {
+        put_u32(offsets, header + frame * frame_bytes);
+    }
+    put_block(qgf, 0x01, offsets);
+
+    for (uint16_t frame = 0; frame < frame_count; frame++) {
+        std::vector<uint8_t> info = {0x05, 0x00, 0x00, 0x00};
+        put_u16(info, delay);
+        put_block(qgf, 0x02, info);
+        put_block(qgf, 0x03, {0, 0, 0, (uint8_t)(frame * 64), 255, 255, 0, 0, 255, 85, 255, 128});
+
+        std::vector<uint8_t> pixels(size * size / 4, 0);
+        for (uint16_t i = 0; i < size * size; i++) {
+            uint16_t x = i % size, y = i / size, pos = frame * (size - 4) / frame_count;
+            uint8_t  index = (x >= pos && x < pos + 4 && y >= pos && y < pos + 4) ? 1 : ((x + y) % 8 == 0 ? 2 : 0);
+            pixels[i / 4] |= index << ((i % 4) * 2);
+        }
+        put_block(qgf, 0x05, pixels);
+    }
+    return qgf;
+}
+
+// The animation tick remembers when it last ran, while every test starts the timer from zero again
+void restart_time(void) {
+    static uint32_t epoch = 0;
+    epoch += 60000;
+    set_time(epoch);
+}
+
+// External flash, emulated in RAM
+std::vector<uint8_t> flash;
+uint32_t             flash_reads = 0;
+
+} // namespace
+
+extern "C" flash_status_t flash_read_block(uint32_t addr, void *buf, size_t len) {
+    if (addr + len > flash.size()) {
+        return FLASH_STATUS_BAD_ADDRESS;
+    }
+    std::copy(flash.begin() + addr, flash.begin() + addr + len, (uint8_t *)buf);
+    flash_reads++;
+    return FLASH_STATUS_SUCCESS;
+}
+
+class PainterBenchmark : public TestFixture, public testing::WithParamInterface<qp_virtual_display_format_t> {
+   protected:
+    painter_device_t display;
+
+    void SetUp() override {
+        display = display_for(GetParam());
+        ASSERT_NE(display, nullptr);
+        ASSERT_TRUE(qp_init(display, QP_ROTATION_0));
+        qp_virtual_display_reset_stats(display);
+    }
+
+    void TearDown() override {
+        // Frames can be inspected by pointing QP_BENCHMARK_OUTPUT at a directory
+        const char *output = std::getenv("QP_BENCHMARK_OUTPUT");
+        if (output) {
+            const testing::TestInfo *info = testing::UnitTest::GetInstance()->current_test_info();
+            std::string              name = std::string(info->test_suite_name()) + "." + info->name();
+            for (char &c : name) {
+                c = (c == '/') ? '_' : c;
+            }
+            qp_virtual_display_save_ppm(display, (std::string(output) + "/" + name + ".ppm").c_str());
+        }
+    }
+
+    template <typename F>
+    void measure(unsigned iterations, F render) {
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned i = 0; i < iterations; i++) {
+            render();
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+        qp_virtual_display_stats_t stats;
+        ASSERT_TRUE(qp_virtual_display_get_stats(display, &stats));
+        RecordProperty("iterations", iterations);
+        RecordProperty("render_us", elapsed.count());
+        RecordProperty("comms_bytes", stats.comms_bytes / iterations);
+        RecordProperty("viewports", stats.viewports / iterations);
+        RecordProperty("pixels", stats.pixels / iterations);
+    }
+
+    /* Compares the panel against the golden hashes for the RGB565, RGB888 and
+     * mono panels. Check the frames written out with QP_BENCHMARK_OUTPUT
+     * before updating them. */
+    void expect_golden(const uint32_t (&golden)[3]) {
+        uint32_t hash = panel_hash(display);
+        RecordProperty("hash", hash);
+        EXPECT_EQ(hash, golden[GetParam()]);
+    }
+
+    // Number of pixels on the panel that aren't black
+    uint32_t lit_pixels(void) {
+        uint32_t count = 0;
+        for (uint16_t y = 0; y < panel_height; y++) {
+            for (uint16_t x = 0; x < panel_width; x++) {
+                RGB pixel = qp_virtual_display_get_pixel(display, x, y);
+                count += (pixel.r | pixel.g | pixel.b) ? 1 : 0;
+            }
+        }
+        return count;
+    }
+};
+
+TEST_P(PainterBenchmark, FullScreenFill) {
+    measure(10, [this] { EXPECT_TRUE(qp_rect(display, 0, 0, panel_width - 1, panel_height - 1, 0, 255, 255, true)); });
+
+    qp_virtual_display_stats_t stats;
+    qp_virtual_display_get_stats(display, &stats);
+    EXPECT_EQ(stats.viewports, 10);
+    EXPECT_EQ(stats.pixels, 10 * panel_width * panel_height);
+    // Three commands plus eight address bytes, then the pixels
+    uint32_t pixel_bytes = (panel_width * panel_height * ((painter_driver_t *)display)->native_bits_per_pixel + 7) / 8;
+    EXPECT_EQ(stats.comms_bytes, 10 * (11 + pixel_bytes));
+    EXPECT_EQ(stats.commands, 10 * 3);
+
+    RGB pixel = qp_virtual_display_get_pixel(display, panel_width - 1, panel_height - 1);
+    EXPECT_EQ(pixel.r, 255);
+    // Red is bright enough to light up a monochrome panel
+    EXPECT_EQ(pixel.b, GetParam() == QP_VIRTUAL_DISPLAY_MONO ? 255 : 0);
+}
+
+TEST_P(PainterBenchmark, Primitives) {
+    measure(10, [this] {
+        qp_rect(display, 0, 0, panel_width - 1, panel_height - 1, 0, 0, 0, true);
+        qp_rect(display, 10, 10, 100, 60, 85, 255, 255, false);
+        qp_line(display, 0, 0, panel_width - 1, panel_height - 1, 170, 255, 255);
+        qp_circle(display, 120, 200, 50, 43, 255, 255, true);
+        qp_ellipse(display, 120, 100, 60, 20, 213, 255, 255, false);
+    });
+    expect_golden({0x3C9AB43F, 0x01430F3C, 0x647BC2D6});
+}
+
+TEST_P(PainterBenchmark, LineSpans) {
+    qp_virtual_display_stats_t stats;
+    auto                       draw = [&](uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+        qp_virtual_display_reset_stats(display);
+        EXPECT_TRUE(qp_line(display, x0, y0, x1, y1, 170, 255, 255));
+        qp_virtual_display_get_stats(display, &stats);
+    };
+
+    // Horizontal and vertical lines are a single run
+    draw(10, 20, 209, 20);
+    EXPECT_EQ(stats.viewports, 1);
+    EXPECT_EQ(stats.pixels, 200);
+    draw(20, 10, 20, 309);
+    EXPECT_EQ(stats.viewports, 1);
+    EXPECT_EQ(stats.pixels, 300);
+
+    // Shallow lines are sent as one run per row, steep lines as one run per column
+    draw(10, 40, 199, 45);
+    EXPECT_EQ(stats.viewports, 6);
+    EXPECT_EQ(stats.pixels, 190);
+    draw(13, 250, 10, 50);
+    EXPECT_EQ(stats.viewports, 4);
+    EXPECT_EQ(stats.pixels, 201);
+
+    // Diagonal lines have no neighbouring pixels to merge
+    draw(0, 0, 99, 99);
+    EXPECT_EQ(stats.viewports, 100);
+    EXPECT_EQ(stats.pixels, 100);
+}
+
+TEST_P(PainterBenchmark, CircleSpans) {
+    qp_virtual_display_stats_t stats;
+
+    // Filled circles are sent as one run per row
+    EXPECT_TRUE(qp_circle(display, 120, 160, 50, 43, 255, 255, true));
+    qp_virtual_display_get_stats(display, &stats);
+    EXPECT_EQ(stats.viewports, 101);
+    EXPECT_EQ(stats.pixels, lit_pixels());
+
+    // Outlines are sent as horizontal runs near the top and bottom, vertical runs near the sides
+    qp_rect(display, 0, 0, panel_width - 1, panel_height - 1, 0, 0, 0, true);
+    qp_virtual_display_reset_stats(display);
+    EXPECT_TRUE(qp_circle(display, 120, 160, 59, 43, 255, 255, false));
+    qp_virtual_display_get_stats(display, &stats);
+    EXPECT_EQ(stats.viewports, 152);
+    // The eight pixels where neighbouring octants meet are sent twice
+    EXPECT_EQ(lit_pixels(), 332);
+    EXPECT_EQ(stats.pixels, 332 + 8);
+}
+
+TEST_P(PainterBenchmark, EllipseSpans) {
+    qp_virtual_display_stats_t stats;
+
+    // Filled ellipses are sent as one run per row
+    EXPECT_TRUE(qp_ellipse(display, 120, 160, 60, 20, 213, 255, 255, true));
+    qp_virtual_display_get_stats(display, &stats);
+    EXPECT_EQ(stats.viewports, 41);
+    EXPECT_EQ(stats.pixels, lit_pixels());
+
+    qp_rect(display, 0, 0, panel_width - 1, panel_height - 1, 0, 0, 0, true);
+    qp_virtual_display_reset_stats(display);
+    EXPECT_TRUE(qp_ellipse(display, 120, 160, 60, 20, 213, 255, 255, false));
+    qp_virtual_display_get_stats(display, &stats);
+    EXPECT_EQ(stats.viewports, 72);
+    EXPECT_EQ(stats.pixels, lit_pixels());
+}
+
+TEST_P(PainterBenchmark, AntialiasedPrimitives) {
+    measure(10, [this] {
+        qp_rect(display, 0, 0, panel_width - 1, panel_height - 1, 0, 0, 0, true);
+        qp_line_aa(display, 10, 10, 200, 60, 0, 0, 255, 0, 0, 0);
+        qp_line_aa(display, 60, 300, 30, 80, 85, 255, 255, 0, 0, 0);
+        qp_circle_aa(display, 120, 200, 50, 43, 255, 255, 0, 0, 0);
+        qp_circle_aa(display, 150, 120, 7, 170, 255, 255, 0, 0, 0);
+        // Clipped by the panel edges
+        qp_line_aa(display, 180, 100, 300, 140, 213, 255, 255, 0, 0, 0);
+        qp_circle_aa(display, 230, 10, 30, 0, 255, 255, 0, 0, 0);
+        qp_circle_aa(display, 0, panel_height - 1, 20, 128, 255, 255, 0, 0, 0);
+    });
+    expect_golden({0x08846462, 0x32A8ED2A, 0x3F0EDB00});
+}
+
+TEST_P(PainterBenchmark, AntialiasedDegenerate) {
+    // A zero length line and a circle of radius 0 are a single pixel
+    EXPECT_TRUE(qp_line_aa(display, 50, 60, 50, 60, 0, 0, 255, 0, 0, 0));
+    EXPECT_EQ(lit_pixels(), 1);
+    EXPECT_EQ(qp_virtual_display_get_pixel(display, 50, 60).r, 255);
+
+    qp_rect(display, 0, 0, panel_width - 1, panel_height - 1, 0, 0, 0, true);
+    qp_virtual_display_reset_stats(display);
+    EXPECT_TRUE(qp_circle_aa(display, 100, 150, 0, 0, 0, 255, 0, 0, 0));
+    EXPECT_EQ(lit_pixels(), 1);
+    EXPECT_EQ(qp_virtual_display_get_pixel(display, 100, 150).r, 255);
+    // Nothing is sent off the panel either, which would go unnoticed on the panel itself
+    qp_virtual_display_stats_t stats;
+    qp_virtual_display_get_stats(display, &stats);
+    EXPECT_LE(stats.pixels, 8);
+
+    // Anything past the panel edges is dropped, without failing the draw
+    qp_rect(display, 0, 0, panel_width - 1, panel_height - 1, 0, 0, 0, true);
+    EXPECT_TRUE(qp_circle_aa(display, 0, 0, 10, 0, 0, 255, 0, 0, 0));
+    EXPECT_TRUE(qp_line_aa(display, panel_width - 5, 0, panel_width + 20, 10, 0, 0, 255, 0, 0, 0));
+    expect_golden({0xFFCDE3CB, 0xDB63C133, 0xEAC7B493});
+}
+
+TEST_P(PainterBenchmark, StockFont) {
+    painter_font_handle_t font = qp_load_font_mem(font_thintel15);
+    ASSERT_NE(font, nullptr);
+
+    const char *lines[] = {"The quick brown fox", "jumps over the lazy dog", "0123456789 !?#$%&*()", "THE QUICK BROWN FOX"};
+    measure(10, [&] {
+        for (uint8_t i = 0; i < 4; i++) {
+            EXPECT_GT(qp_drawtext_recolor(display, 4, 4 + i * font->line_height, font, lines[i], 0, 0, 255, 0, 0, 0), 0);
+        }
+    });
+    expect_golden({0x36909C91, 0x36909C91, 0x36909C91});
+    EXPECT_TRUE(qp_close_font(font));
+}
+
+TEST_P(PainterBenchmark, StockImages) {
+    painter_image_handle_t logo = qp_load_image_mem(gfx_djinn);
+    painter_image_handle_t lock = qp_load_image_mem(gfx_lock_caps_ON);
+    ASSERT_NE(logo, nullptr);
+    ASSERT_NE(lock, nullptr);
+
+    measure(10, [&] {
+        EXPECT_TRUE(qp_drawimage(display, 0, 0, logo));
+        EXPECT_TRUE(qp_drawimage_recolor(display, 0, panel_height - lock->height, lock, 85, 255, 255, 0, 0, 0));
+    });
+    expect_golden({0xE675CCDA, 0x35D805A6, 0x084519E2});
+    EXPECT_TRUE(qp_close_image(logo));
+    EXPECT_TRUE(qp_close_image(lock));
+}
+
+TEST_P(PainterBenchmark, LzImage) {
+    // The same image as StockImages, with its pixel data recompressed using QMK LZ
+    painter_image_handle_t logo = qp_load_image_mem(gfx_djinn_lz);
+    ASSERT_NE(logo, nullptr);
+
+    measure(10, [&] { EXPECT_TRUE(qp_drawimage(display, 0, 0, logo)); });
+    uint32_t lz_hash = panel_hash(display);
+    EXPECT_TRUE(qp_close_image(logo));
+
+    logo = qp_load_image_mem(gfx_djinn);
+    ASSERT_NE(logo, nullptr);
+    EXPECT_TRUE(qp_drawimage(display, 0, 0, logo));
+    EXPECT_EQ(lz_hash, panel_hash(display));
+    EXPECT_TRUE(qp_close_image(logo));
+}
+
+TEST_P(PainterBenchmark, LzFont) {
+    // The same font as StockFont, with every glyph compressed separately using QMK LZ
+    painter_font_handle_t font = qp_load_font_mem(font_thintel15_lz);
+    ASSERT_NE(font, nullptr);
+
+    measure(10, [&] { EXPECT_GT(qp_drawtext_recolor(display, 4, 4, font, "The quick brown fox", 0, 0, 255, 0, 0, 0), 0); });
+    uint32_t lz_hash = panel_hash(display);
+    EXPECT_TRUE(qp_close_font(font));
+
+    font = qp_load_font_mem(font_thintel15);
+    ASSERT_NE(font, nullptr);
+    EXPECT_GT(qp_drawtext_recolor(display, 4, 4, font, "The quick brown fox", 0, 0, 255, 0, 0, 0), 0);
+    EXPECT_EQ(lz_hash, panel_hash(display));
+    EXPECT_TRUE(qp_close_font(font));
+}
+
+TEST_P(PainterBenchmark, FlashBundle) {
+    // A bundle of the stock image and font, placed after some unrelated data in flash
+    const uint32_t               bundle_address = 4096;
+    std::vector<uint8_t>         bundle;
+    std::vector<const uint8_t *> assets        = {gfx_djinn, font_thintel15};
+    std::vector<uint32_t>        asset_lengths = {gfx_djinn_length, font_thintel15_length};
+
+    std::vector<uint8_t> descriptor = {0x51, 0x50, 0x42, 0x01};
+    uint32_t             offset     = 5 + 14 + 5 + 8 * assets.size();
+    uint32_t             total      = offset + asset_lengths[0] + asset_lengths[1];
+    put_u32(descriptor, total);
+    put_u32(descriptor, ~total);
+    put_u16(descriptor, assets.size());
+    put_block(bundle, 0x00, descriptor);
+
+    std::vector<uint8_t> table;
+    for (uint32_t length : asset_lengths) {
+        put_u32(table, offset);
+        put_u32(table, length);
+        offset += length;
+    }
+    put_block(bundle, 0x01, table);
+    for (size_t i = 0; i < assets.size(); i++) {
+        bundle.insert(bundle.end(), assets[i], assets[i] + asset_lengths[i]);
+    }
+
+    flash.assign(bundle_address, 0xFF);
+    flash.insert(flash.end(), bundle.begin(), bundle.end());
+
+    uint32_t image_address, font_address, missing_address;
+    ASSERT_TRUE(qp_find_bundle_asset_flash(bundle_address, 0, &image_address));
+    ASSERT_TRUE(qp_find_bundle_asset_flash(bundle_address, 1, &font_address));
+    EXPECT_FALSE(qp_find_bundle_asset_flash(bundle_address, 2, &missing_address));
+    EXPECT_FALSE(qp_find_bundle_asset_flash(0, 0, &missing_address));
+
+    painter_image_handle_t logo = qp_load_image_flash(image_address);
+    painter_font_handle_t  font = qp_load_font_flash(font_address);
+    ASSERT_NE(logo, nullptr);
+    ASSERT_NE(font, nullptr);
+
+    flash_reads = 0;
+    measure(10, [&] {
+        EXPECT_TRUE(qp_drawimage(display, 0, 0, logo));
+        EXPECT_GT(qp_drawtext(display, 4, panel_height - font->line_height, font, "The quick brown fox"), 0);
+    });
+    uint32_t flash_hash = panel_hash(display);
+    RecordProperty("flash_reads", flash_reads / 10);
+
+    // The image data is read ahead in blocks rather than a byte at a time
+    EXPECT_LT(flash_reads, 10 * gfx_djinn_length / 32);
+    EXPECT_TRUE(qp_close_image(logo));
+    EXPECT_TRUE(qp_close_font(font));
+
+    // Drawing from flash matches drawing from memory
+    logo = qp_load_image_mem(gfx_djinn);
+    font = qp_load_font_mem(font_thintel15);
+    EXPECT_TRUE(qp_drawimage(display, 0, 0, logo));
+    EXPECT_GT(qp_drawtext(display, 4, panel_height - font->line_height, font, "The quick brown fox"), 0);
+    EXPECT_EQ(flash_hash, panel_hash(display));
+    EXPECT_TRUE(qp_close_image(logo));
+    EXPECT_TRUE(qp_close_font(font));
+}
+
+TEST_P(PainterBenchmark, Animation) {
+    restart_time();
+
+    std::vector<uint8_t>   qgf   = make_animation(4, 100);
+    painter_image_handle_t image = qp_load_image_mem(qgf.data());
+    ASSERT_NE(image, nullptr);
+    EXPECT_EQ(image->frame_count, 4);
+
+    deferred_token token = qp_animate(display, 16, 16, image);
+    ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+
+    // Every frame has the square in a different place, so every frame changes the panel
+    std::vector<uint32_t> hashes = {panel_hash(display)};
+    for (uint8_t frame = 1; frame < 4; frame++) {
+        advance_time(100);
+        qp_internal_task();
+        hashes.push_back(panel_hash(display));
+        EXPECT_NE(hashes[frame], hashes[frame - 1]);
+    }
+
+    // Then it loops back to the first frame
+    advance_time(100);
+    qp_internal_task();
+    EXPECT_EQ(panel_hash(display), hashes[0]);
+
+    qp_stop_animation(token);
+    EXPECT_TRUE(qp_close_image(image));
+}
+
+TEST_P(PainterBenchmark, DeltaAnimation) {
+    // Plays back an animation, returning the panel after each frame and the number of pixels sent for frames 1-3
+    auto play = [&](const uint8_t *qgf, uint32_t *pixels) {
+        restart_time();
+        painter_image_handle_t image = qp_load_image_mem(qgf);
+        EXPECT_NE(image, nullptr);
+
+        deferred_token token = qp_animate(display, 16, 16, image);
+        EXPECT_NE(token, INVALID_DEFERRED_TOKEN);
+        std::vector<uint32_t> hashes = {panel_hash(display)};
+
+        qp_virtual_display_reset_stats(display);
+        for (uint8_t frame = 1; frame < 4; frame++) {
+            advance_time(1000);
+            qp_internal_task();
+            hashes.push_back(panel_hash(display));
+        }
+
+        qp_virtual_display_stats_t stats;
+        EXPECT_TRUE(qp_virtual_display_get_stats(display, &stats));
+        *pixels = stats.pixels;
+        qp_stop_animation(token);
+        EXPECT_TRUE(qp_close_image(image));
+        return hashes;
+    };
+
+    // The same two moving squares, encoded with and without delta frames
+    uint32_t full_pixels, delta_pixels;
+    auto     full  = play(gfx_squares_full, &full_pixels);
+    auto     delta = play(gfx_squares, &delta_pixels);
+    EXPECT_EQ(delta, full);
+
+    // The squares are in opposite corners, so each delta frame only sends the areas around them
+    RecordProperty("full_pixels", full_pixels);
+    RecordProperty("delta_pixels", delta_pixels);
+    EXPECT_LT(delta_pixels * 4, full_pixels);
+}
+
+TEST_P(PainterBenchmark, PaletteCache) {
+    painter_font_handle_t font = qp_load_font_mem(font_thintel15);
+    ASSERT_NE(font, nullptr);
+
+    // A status line alternating between two colors every frame
+    auto draw_status = [&](uint8_t hue) { EXPECT_GT(qp_drawtext_recolor(display, 4, 4, font, "CAPS LOCK", hue, 255, 255, 0, 0, 0), 0); };
+    draw_status(0);
+    uint32_t red_hash = panel_hash(display);
+    draw_status(85);
+
+    // Both palettes are already converted, so redrawing does no color conversion at all
+    qp_virtual_display_reset_stats(display);
+    measure(10, [&] {
+        draw_status(0);
+        draw_status(85);
+    });
+    qp_virtual_display_stats_t stats;
+    qp_virtual_display_get_stats(display, &stats);
+    EXPECT_EQ(stats.conversions, 0);
+    draw_status(0);
+    EXPECT_EQ(panel_hash(display), red_hash);
+
+    // Drawing with more colors than the cache holds evicts the least recently used palette
+    for (uint8_t i = 0; i < QUANTUM_PAINTER_PALETTE_CACHE_SIZE; i++) {
+        draw_status(100 + i);
+    }
+    qp_virtual_display_reset_stats(display);
+    draw_status(85);
+    qp_virtual_display_get_stats(display, &stats);
+    EXPECT_GT(stats.conversions, 0);
+    EXPECT_TRUE(qp_close_font(font));
+}
+
+TEST_P(PainterBenchmark, PaletteSurface) {
+    // The colors of the Primitives scene, so that the surface holds it exactly
+    static const HSV palette[16] = {{0, 0, 0}, {85, 255, 255}, {170, 255, 255}, {43, 255, 255}, {213, 255, 255}};
+    static uint8_t   palette_buffer[PALETTE_SURFACE_BUFFER_SIZE(panel_width, panel_height, 4)];
+    static uint8_t   mono_buffer[PALETTE_SURFACE_BUFFER_SIZE(panel_width, panel_height, 1)];
+    static painter_device_t surface = qp_palette_make_surface(panel_width, panel_height, 4, palette, palette_buffer);
+    static painter_device_t mono    = qp_mono_make_surface(panel_width, panel_height, mono_buffer);
+    ASSERT_NE(surface, nullptr);
+    ASSERT_NE(mono, nullptr);
+    EXPECT_EQ(qp_palette_make_surface(panel_width, panel_height, 3, palette, palette_buffer), nullptr);
+
+    auto draw_scene = [](painter_device_t device) {
+        qp_rect(device, 10, 10, 100, 60, 85, 255, 255, false);
+        qp_line(device, 0, 0, panel_width - 1, panel_height - 1, 170, 255, 255);
+        qp_circle(device, 120, 200, 50, 43, 255, 255, true);
+        qp_ellipse(device, 120, 100, 60, 20, 213, 255, 255, false);
+    };
+
+    // Converting to the panel's format only when drawing the surface gives the same result as drawing directly
+    ASSERT_TRUE(qp_init(surface, QP_ROTATION_0));
+    measure(10, [&] {
+        draw_scene(surface);
+        EXPECT_TRUE(qp_palette_surface_draw(surface, display, 0, 0));
+    });
+    expect_golden({0x3C9AB43F, 0x01430F3C, 0x647BC2D6});
+
+    // Only the area drawn to since the last transfer is sent
+    qp_virtual_display_reset_stats(display);
+    EXPECT_TRUE(qp_palette_surface_draw(surface, display, 0, 0));
+    EXPECT_TRUE(qp_rect(surface, 20, 30, 23, 31, 170, 255, 255, true));
+    EXPECT_TRUE(qp_palette_surface_draw(surface, display, 0, 0));
+    qp_virtual_display_stats_t stats;
+    qp_virtual_display_get_stats(display, &stats);
+    EXPECT_EQ(stats.viewports, 1);
+    EXPECT_EQ(stats.pixels, 4 * 2);
+
+    // Mono surfaces threshold on value, like mono panels
+    ASSERT_TRUE(qp_init(mono, QP_ROTATION_0));
+    draw_scene(mono);
+    EXPECT_TRUE(qp_palette_surface_draw(mono, display, 0, 0));
+    RGB pixel = qp_virtual_display_get_pixel(display, 120, 200);
+    EXPECT_EQ(pixel.r, 255);
+    EXPECT_EQ(pixel.g, 255);
+    EXPECT_EQ(pixel.b, 255);
+    if (GetParam() == QP_VIRTUAL_DISPLAY_MONO) {
+        EXPECT_EQ(panel_hash(display), 0x647BC2D6);
+    }
+}
+
+TEST_P(PainterBenchmark, RotatedPanel) {
+    ASSERT_TRUE(qp_init(display, QP_ROTATION_90));
+    uint16_t width, height;
+    qp_get_geometry(display, &width, &height, NULL, NULL, NULL);
+    EXPECT_EQ(width, panel_height);
+    EXPECT_EQ(height, panel_width);
+
+    // The top left corner of a panel rotated by 90 degrees is the panel's top right corner
+    EXPECT_TRUE(qp_setpixel(display, 0, 0, 0, 0, 255));
+    EXPECT_EQ(qp_virtual_display_get_pixel(display, panel_width - 1, 0).g, 255);
+    EXPECT_EQ(qp_virtual_display_get_pixel(display, 0, 0).g, 0);
+}
+
+std::string format_name(const testing::TestParamInfo<qp_virtual_display_format_t> &info) {
+    const char *names[] = {"Rgb565", "Rgb888", "Mono"};
+    return names[info.param];
+}
+
+INSTANTIATE_TEST_CASE_P(Formats, PainterBenchmark, testing::Values(QP_VIRTUAL_DISPLAY_RGB565, QP_VIRTUAL_DISPLAY_RGB888, QP_VIRTUAL_DISPLAY_MONO), format_name);
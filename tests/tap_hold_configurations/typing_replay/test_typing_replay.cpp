@@ -0,0 +1,218 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::Invoke;
+
+namespace {
+
+// Opening of "Alice's Adventures in Wonderland" by Lewis Carroll, public domain.
+const char *corpus =
+    "alice was beginning to get very tired of sitting by her sister on the bank, and of having nothing to do. "
+    "once or twice she had peeped into the book her sister was reading, but it had no pictures or conversations in it, "
+    "and what is the use of a book, thought alice, without pictures or conversations. "
+    "so she was considering in her own mind, as well as she could, for the hot day made her feel very sleepy and stupid, "
+    "whether the pleasure of making a daisy chain would be worth the trouble of getting up and picking the daisies, "
+    "when suddenly a white rabbit with pink eyes ran close by her.";
+
+struct ReplayEvent {
+    uint32_t time;
+    size_t   key;
+    bool     pressed;
+};
+
+char keycode_to_char(uint8_t keycode) {
+    if (keycode >= KC_A && keycode <= KC_Z) {
+        return 'a' + (keycode - KC_A);
+    }
+    switch (keycode) {
+        case KC_SPACE:
+            return ' ';
+        case KC_COMMA:
+            return ',';
+        case KC_DOT:
+            return '.';
+        default:
+            return '?';
+    }
+}
+
+} // namespace
+
+class TypingReplay : public TestFixture {
+   protected:
+    std::vector<KeymapKey>  keys;
+    std::map<char, size_t>  key_for_char;
+    std::string             typed;
+    unsigned                modded_presses = 0;
+    report_keyboard_t       last_report    = {};
+
+    void SetUp() override {
+        // Home row mods on a QWERTY layout
+        const uint16_t layout[3][10] = {
+            {KC_Q, KC_W, KC_E, KC_R, KC_T, KC_Y, KC_U, KC_I, KC_O, KC_P},
+            {LGUI_T(KC_A), LALT_T(KC_S), LCTL_T(KC_D), LSFT_T(KC_F), KC_G, KC_H, RSFT_T(KC_J), RCTL_T(KC_K), LALT_T(KC_L), RGUI_T(KC_SCLN)},
+            {KC_Z, KC_X, KC_C, KC_V, KC_B, KC_N, KC_M, KC_COMM, KC_DOT, KC_SLSH},
+        };
+        for (uint8_t row = 0; row < 3; row++) {
+            for (uint8_t col = 0; col < 10; col++) {
+                key_for_char[keycode_to_char(QK_MODS_GET_BASIC_KEYCODE(layout[row][col]))] = keys.size();
+                keys.push_back(KeymapKey(0, col, row, layout[row][col]));
+            }
+        }
+        key_for_char[' '] = keys.size();
+        keys.push_back(KeymapKey(0, 0, 3, KC_SPACE));
+
+        for (auto &key : keys) {
+            add_key(key);
+        }
+    }
+
+    void record_report(const report_keyboard_t &report) {
+        for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+            if (report.keys[i] == KC_NO || std::find(std::begin(last_report.keys), std::end(last_report.keys), report.keys[i]) != std::end(last_report.keys)) {
+                continue;
+            }
+            typed += keycode_to_char(report.keys[i]);
+            if (report.mods) {
+                modded_presses++;
+            }
+        }
+        last_report = report;
+    }
+
+    /* Builds the key events of typing `text` at `wpm` words per minute, each
+     * key being held for longer than the interval between two keys, so that
+     * consecutive keys roll over. The jitter is deterministic. */
+    std::vector<ReplayEvent> build_events(const std::string &text, unsigned wpm) {
+        const uint32_t           interval = 60000 / (wpm * 5);
+        const uint32_t           dwell    = interval * 3 / 2;
+        std::vector<ReplayEvent> events;
+        std::map<size_t, size_t> last_release;
+        uint32_t                 seed = 1;
+        uint32_t                 time = 100;
+
+        for (char c : text) {
+            seed             = seed * 1103515245 + 12345;
+            uint32_t jitter  = (seed >> 16) % (interval / 2);
+            size_t   key     = key_for_char.at(c);
+            uint32_t press   = time + jitter;
+            uint32_t release = press + dwell - jitter / 2;
+
+            // A key has to be released before it can be pressed again
+            auto previous = last_release.find(key);
+            if (previous != last_release.end() && events[previous->second].time >= press) {
+                events[previous->second].time = press - 1;
+            }
+            events.push_back({press, key, true});
+            last_release[key] = events.size();
+            events.push_back({release, key, false});
+            time += interval;
+        }
+
+        std::stable_sort(events.begin(), events.end(), [](const ReplayEvent &a, const ReplayEvent &b) { return a.time < b.time; });
+        return events;
+    }
+
+    void replay(const std::vector<ReplayEvent> &events) {
+        uint32_t now = 0;
+        for (const auto &event : events) {
+            if (event.time > now) {
+                idle_for(event.time - now);
+                now = event.time;
+            }
+            if (event.pressed) {
+                keys[event.key].press();
+            } else {
+                keys[event.key].release();
+            }
+        }
+        idle_for(TAPPING_TERM * 2);
+    }
+};
+
+TEST_F(TypingReplay, RollingHomeRowModsAt200Wpm) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([this](report_keyboard_t &report) { record_report(report); }));
+
+    auto events = build_events(corpus, 200);
+    auto start  = std::chrono::steady_clock::now();
+    replay(events);
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    RecordProperty("key_events", events.size());
+    RecordProperty("replay_us", elapsed.count());
+    EXPECT_EQ(typed, corpus);
+    EXPECT_EQ(modded_presses, 0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TypingReplay, FullWaitingBufferSettlesHold) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([this](report_keyboard_t &report) { record_report(report); }));
+
+    auto &shift = keys[key_for_char.at('f')];
+    shift.press();
+    run_one_scan_loop();
+
+    // More events than the waiting buffer can hold, within the tapping term
+    for (char c : std::string("qwerty")) {
+        keys[key_for_char.at(c)].press();
+        run_one_scan_loop();
+        keys[key_for_char.at(c)].release();
+        run_one_scan_loop();
+    }
+    EXPECT_EQ(typed, "qwerty");
+    EXPECT_EQ(modded_presses, 6);
+
+    idle_for(TAPPING_TERM);
+    shift.release();
+    run_one_scan_loop();
+    EXPECT_EQ(last_report.mods, 0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TypingReplay, ShiftedBurstOverflowsWaitingBuffer) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([this](report_keyboard_t &report) { record_report(report); }));
+
+    // A word typed in a 400 WPM burst while holding the shift home row mod,
+    // which is released again before TAPPING_TERM expires
+    auto           events = build_events("alice", 400);
+    const size_t   shift  = key_for_char.at('f');
+    const uint32_t press  = 50;
+    uint32_t       last   = 0;
+    for (const auto &event : events) {
+        if (event.pressed) {
+            last = std::max(last, event.time);
+        }
+    }
+    const uint32_t release = last + 5;
+    ASSERT_LT(release - press, TAPPING_TERM);
+
+    // Only a full waiting buffer can decide the hold before the release
+    size_t waiting = std::count_if(events.begin(), events.end(), [&](const ReplayEvent &event) { return event.time < release; });
+    ASSERT_GE(waiting, WAITING_BUFFER_SIZE);
+
+    events.insert(events.begin(), {press, shift, true});
+    events.insert(std::upper_bound(events.begin(), events.end(), release, [](uint32_t time, const ReplayEvent &event) { return time < event.time; }), {release, shift, false});
+    replay(events);
+
+    EXPECT_EQ(typed, "alice");
+    EXPECT_EQ(modded_presses, 5);
+    EXPECT_EQ(last_report.mods, 0);
+    VERIFY_AND_CLEAR(driver);
+}
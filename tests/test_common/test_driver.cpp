@@ -62,6 +62,15 @@ void expect_unicode_code_point(TestDriver& driver, uint32_t code_point) {
     testing::InSequence seq;
     EXPECT_REPORT(driver, (KC_LCTL, KC_LSFT, KC_U));
 
+    // Digits with ascending keycodes are sent in the same report
+    std::vector<uint8_t> group;
+    auto                 expect_group = [&]() {
+        if (!group.empty()) {
+            EXPECT_CALL(driver, send_keyboard_mock(testing::MakeMatcher(new KeyboardReportMatcher(group))));
+            group.clear();
+        }
+    };
+
     bool print_zero = false;
     for (int i = 7; i >= 0; --i) {
         if (i <= 3) {
@@ -70,10 +79,15 @@ void expect_unicode_code_point(TestDriver& driver, uint32_t code_point) {
 
         const uint8_t digit = (code_point >> (i * 4)) & 0xf;
         if (digit || print_zero) {
-            EXPECT_REPORT(driver, (hex_digit_to_keycode(digit)));
+            const uint8_t keycode = hex_digit_to_keycode(digit);
+            if (!group.empty() && (keycode <= group.back() || group.size() == KEYBOARD_REPORT_KEYS)) {
+                expect_group();
+            }
+            group.push_back(keycode);
             print_zero = true;
         }
     }
+    expect_group();
 
     EXPECT_REPORT(driver, (KC_SPC));
 }
@@ -70,9 +70,11 @@ class TestDriver {
  *
  *   EXPECT_UNICODE(driver, 0x2013);
  *
- * expects the sequence of keys:
+ * expects the sequence of reports:
  *
- *   "Ctrl+Shift+U, 2, 0, 1, 3, space".
+ *   "Ctrl+Shift+U, (2, 0), (1, 3), space".
+ *
+ * as hex digits with ascending keycodes are sent in the same report.
  */
 #define EXPECT_UNICODE(driver, code_point) internal::expect_unicode_code_point((driver), (code_point))
 
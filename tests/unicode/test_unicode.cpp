@@ -0,0 +1,148 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "unicode.h"
+
+using testing::_;
+using testing::Invoke;
+
+namespace {
+
+char keycode_to_char(uint8_t keycode) {
+    if (keycode >= KC_A && keycode <= KC_Z) {
+        return 'a' + (keycode - KC_A);
+    }
+    if (keycode >= KC_1 && keycode <= KC_0) {
+        return '0' + (keycode - KC_1 + 1) % 10;
+    }
+    if (keycode >= KC_KP_1 && keycode <= KC_KP_0) {
+        return '0' + (keycode - KC_KP_1 + 1) % 10;
+    }
+    switch (keycode) {
+        case KC_SPACE:
+            return ' ';
+        case KC_ENTER:
+            return '\n';
+        case KC_KP_PLUS:
+            return '+';
+        case KC_NUM_LOCK:
+            return '#';
+        default:
+            return '?';
+    }
+}
+
+} // namespace
+
+class Unicode : public TestFixture {
+   protected:
+    std::string       typed;
+    unsigned          reports     = 0;
+    unsigned          mod_presses = 0;
+    report_keyboard_t last_report = {};
+
+    /* Decodes the keys pressed by each report, in the order hosts handle
+     * them: ascending keycodes. Keys pressed with modifiers are uppercase. */
+    void record_report(const report_keyboard_t &report) {
+        std::vector<uint8_t> pressed;
+        for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+            if (report.keys[i] != KC_NO && std::find(std::begin(last_report.keys), std::end(last_report.keys), report.keys[i]) == std::end(last_report.keys)) {
+                pressed.push_back(report.keys[i]);
+            }
+        }
+        std::sort(pressed.begin(), pressed.end());
+        for (uint8_t keycode : pressed) {
+            char c = keycode_to_char(keycode);
+            typed += report.mods ? toupper(c) : c;
+        }
+        if (report.mods & ~last_report.mods) {
+            mod_presses++;
+        }
+        reports++;
+        last_report = report;
+    }
+
+    void SetUp() override {
+        set_unicode_input_mode(UNICODE_MODE_LINUX);
+    }
+};
+
+TEST_F(Unicode, LinuxCodePoint) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(testing::AnyOf(KeyboardReport(), KeyboardReport(KC_LCTL, KC_LSFT)))).Times(testing::AnyNumber());
+    EXPECT_UNICODE(driver, 0x1F600);
+    register_unicode(0x1F600);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Unicode, LinuxStringStartsEachCodePoint) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([this](report_keyboard_t &report) { record_report(report); }));
+
+    send_unicode_string("éà");
+    EXPECT_EQ(typed, "U00e9 U00e0 ");
+    EXPECT_EQ(mod_presses, 2);
+    EXPECT_EQ(last_report, report_keyboard_t{});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Unicode, MacosStringSharesInputStart) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([this](report_keyboard_t &report) { record_report(report); }));
+
+    set_unicode_input_mode(UNICODE_MODE_MACOS);
+    send_unicode_string("é😀à");
+    EXPECT_EQ(typed, "00E9D83DDE0000E0");
+    EXPECT_EQ(mod_presses, 1);
+    EXPECT_EQ(last_report, report_keyboard_t{});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Unicode, WincomposeKeepsLeadingZero) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([this](report_keyboard_t &report) { record_report(report); }));
+
+    set_unicode_input_mode(UNICODE_MODE_WINCOMPOSE);
+    send_unicode_string("😀");
+    EXPECT_EQ(typed, "u1f600\n");
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Unicode, WindowsUsesKeypad) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([this](report_keyboard_t &report) { record_report(report); }));
+
+    set_unicode_input_mode(UNICODE_MODE_WINDOWS);
+    send_unicode_string("€");
+    EXPECT_EQ(typed, "#+20AC#");
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Unicode, EmojiSnippetReportCount) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([this](report_keyboard_t &report) { record_report(report); }));
+
+    std::string snippet;
+    std::string expected;
+    for (int i = 0; i < 40; i++) {
+        snippet += "😀";
+        expected += "D83DDE00";
+    }
+
+    set_unicode_input_mode(UNICODE_MODE_MACOS);
+    send_unicode_string(snippet.c_str());
+    EXPECT_EQ(typed, expected);
+    EXPECT_EQ(mod_presses, 1);
+    // Tapping each digit on its own takes two reports per digit
+    RecordProperty("reports", reports);
+    EXPECT_LT(reports, expected.size() * 2);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,130 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+using ::testing::_;
+using ::testing::AnyNumber;
+
+class WpmStats : public TestFixture {
+   public:
+    void SetUp() override {
+        wpm_stats_reset();
+    }
+
+    // Taps `key` and idles so that the next press lands `interval` ms later.
+    void TypeKey(KeymapKey key, unsigned interval) {
+        key.press();
+        run_one_scan_loop();
+        key.release();
+        idle_for(interval - 1);
+    }
+
+    void TypeKeys(KeymapKey key, unsigned count, unsigned interval) {
+        for (unsigned i = 0; i < count; i++) {
+            TypeKey(key, interval);
+        }
+    }
+};
+
+TEST_F(WpmStats, SteadyTyping) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    // 120 ms between keystrokes is 100 WPM with five character words.
+    TypeKeys(key_a, 20, 120);
+
+    wpm_stats_t stats = get_wpm_stats();
+    EXPECT_EQ(stats.samples, 19);
+    EXPECT_EQ(stats.wpm, 100);
+    EXPECT_EQ(stats.burst_wpm, 100);
+    EXPECT_EQ(stats.peak_wpm, 100);
+    EXPECT_EQ(stats.interval_p50, 120);
+    EXPECT_EQ(stats.interval_p90, 120);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(WpmStats, BurstTracksRecentKeystrokes) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    TypeKeys(key_a, 24, 200);
+    wpm_stats_t stats = get_wpm_stats();
+    EXPECT_EQ(stats.wpm, 60);
+    EXPECT_EQ(stats.burst_wpm, 60);
+
+    TypeKeys(key_a, WPM_STATS_BURST_SIZE + 1, 100);
+    stats = get_wpm_stats();
+    EXPECT_EQ(stats.samples, WPM_STATS_WINDOW_SIZE);
+    EXPECT_EQ(stats.burst_wpm, 120);
+    EXPECT_EQ(stats.peak_wpm, 120);
+    EXPECT_GT(stats.wpm, 60);
+    EXPECT_LT(stats.wpm, stats.burst_wpm);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(WpmStats, IntervalPercentiles) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    TypeKeys(key_a, 9, 100);
+    TypeKey(key_a, 300);
+    TypeKey(key_a, 100);
+
+    // Nine 100 ms intervals followed by one 300 ms interval, reported as the
+    // centre of their histogram buckets.
+    EXPECT_EQ(get_wpm_stats().samples, 10);
+    EXPECT_EQ(wpm_stats_interval_percentile(50), 104);
+    EXPECT_EQ(wpm_stats_interval_percentile(90), 104);
+    EXPECT_EQ(wpm_stats_interval_percentile(100), 296);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(WpmStats, IdleEndsSession) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    TypeKeys(key_a, 20, 120);
+    idle_for(WPM_STATS_IDLE_TIMEOUT);
+
+    wpm_stats_t stats = get_wpm_stats();
+    EXPECT_EQ(stats.samples, 0);
+    EXPECT_EQ(stats.wpm, 0);
+    EXPECT_EQ(stats.burst_wpm, 0);
+    EXPECT_EQ(stats.peak_wpm, 100);
+    EXPECT_EQ(stats.interval_p50, 120);
+
+    // The first keystroke after the pause starts a new window.
+    TypeKey(key_a, 120);
+    EXPECT_EQ(get_wpm_stats().samples, 0);
+    TypeKey(key_a, 120);
+    EXPECT_EQ(get_wpm_stats().samples, 1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(WpmStats, IgnoresNonTypingKeys) {
+    TestDriver driver;
+    auto       key_left = KeymapKey(0, 0, 0, KC_LEFT);
+
+    set_keymap({key_left});
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    TypeKeys(key_left, 10, 100);
+
+    EXPECT_EQ(get_wpm_stats().samples, 0);
+    EXPECT_EQ(get_wpm_stats().wpm, 0);
+    VERIFY_AND_CLEAR(driver);
+}
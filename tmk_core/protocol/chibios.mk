@@ -9,6 +9,10 @@ SRC += $(CHIBIOS_DIR)/usb_driver.c
 SRC += $(CHIBIOS_DIR)/usb_util.c
 SRC += $(LIBSRC)
 
+ifeq ($(strip $(USB_SOF_SYNC_ENABLE)), yes)
+    OPT_DEFS += -DUSB_SOF_SYNC_ENABLE
+endif
+
 VPATH += $(TMK_PATH)/$(PROTOCOL_DIR)
 VPATH += $(TMK_PATH)/$(CHIBIOS_DIR)
 VPATH += $(TMK_PATH)/$(CHIBIOS_DIR)/lufa_utils
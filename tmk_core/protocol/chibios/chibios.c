@@ -200,9 +200,16 @@ void protocol_pre_task(void) {
 #    endif /* MOUSEKEY_ENABLE */
     }
 #endif
+
+#ifdef USB_SOF_SYNC_ENABLE
+    usb_sof_sync_task();
+#endif
 }
 
 void protocol_post_task(void) {
+#ifdef USB_SOF_SYNC_ENABLE
+    usb_sof_sync_loop_end();
+#endif
 #ifdef CONSOLE_ENABLE
     console_task();
 #endif
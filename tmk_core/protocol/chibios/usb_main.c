@@ -129,16 +129,304 @@ static const USBDescriptor *usb_get_descriptor_cb(USBDriver *usbp, uint8_t dtype
         return &desc;
 }
 
-/*
- * USB notification callback that does nothing.  Needed to work around bugs in
- * some USB LLDs that fail to resume the waiting thread when the notification
- * callback pointer is NULL.
+/* ---------------------------------------------------------
+ *                Report IN double buffering
+ * ---------------------------------------------------------
  */
-static void dummy_usb_cb(USBDriver *usbp, usbep_t ep) {
-    (void)usbp;
-    (void)ep;
+
+/* Every report IN endpoint owns the buffer of the transfer in flight, plus a
+ * small queue of pending reports. send_report() never waits for the endpoint:
+ * reports are queued while a transfer is in flight, and the transfer complete
+ * callback starts the next one from interrupt context. */
+#ifndef USB_REPORT_QUEUE_SIZE
+#    define USB_REPORT_QUEUE_SIZE 4
+#endif
+
+typedef union {
+    report_keyboard_t keyboard;
+#ifdef MOUSE_ENABLE
+    report_mouse_t mouse;
+#endif
+#ifdef EXTRAKEY_ENABLE
+    report_extra_t extra;
+#endif
+#ifdef PROGRAMMABLE_BUTTON_ENABLE
+    report_programmable_button_t programmable_button;
+#endif
+#ifdef JOYSTICK_ENABLE
+    report_joystick_t joystick;
+#endif
+#ifdef DIGITIZER_ENABLE
+    report_digitizer_t digitizer;
+#endif
+} usb_report_t;
+
+typedef struct {
+    uint8_t size;
+    uint8_t data[sizeof(usb_report_t)];
+} usb_report_slot_t;
+
+typedef struct {
+    usb_report_slot_t in_flight;
+    usb_report_slot_t pending[USB_REPORT_QUEUE_SIZE];
+    uint8_t           head;
+    uint8_t           count;
+} usb_report_queue_t;
+
+#ifndef KEYBOARD_SHARED_EP
+static usb_report_queue_t kbd_report_queue;
+#endif
+#if defined(MOUSE_ENABLE) && !defined(MOUSE_SHARED_EP)
+static usb_report_queue_t mouse_report_queue;
+#endif
+#ifdef SHARED_EP_ENABLE
+static usb_report_queue_t shared_report_queue;
+#endif
+#if defined(JOYSTICK_ENABLE) && !defined(JOYSTICK_SHARED_EP)
+static usb_report_queue_t joystick_report_queue;
+#endif
+#if defined(DIGITIZER_ENABLE) && !defined(DIGITIZER_SHARED_EP)
+static usb_report_queue_t digitizer_report_queue;
+#endif
+
+static usb_report_queue_t *const report_queues[USB_MAX_ENDPOINTS + 1] = {
+#ifndef KEYBOARD_SHARED_EP
+    [KEYBOARD_IN_EPNUM] = &kbd_report_queue,
+#endif
+#if defined(MOUSE_ENABLE) && !defined(MOUSE_SHARED_EP)
+    [MOUSE_IN_EPNUM] = &mouse_report_queue,
+#endif
+#ifdef SHARED_EP_ENABLE
+    [SHARED_IN_EPNUM] = &shared_report_queue,
+#endif
+#if defined(JOYSTICK_ENABLE) && !defined(JOYSTICK_SHARED_EP)
+    [JOYSTICK_IN_EPNUM] = &joystick_report_queue,
+#endif
+#if defined(DIGITIZER_ENABLE) && !defined(DIGITIZER_SHARED_EP)
+    [DIGITIZER_IN_EPNUM] = &digitizer_report_queue,
+#endif
+};
+
+/* Drops the reports still waiting for the host, eg. on reset. */
+static void report_queues_clear_i(void) {
+    for (uint8_t i = 0; i <= USB_MAX_ENDPOINTS; i++) {
+        if (report_queues[i] != NULL) {
+            report_queues[i]->head  = 0;
+            report_queues[i]->count = 0;
+        }
+    }
+}
+
+/* Starts the transfer of the oldest pending report, if any.
+ * Must be called from a locked state with the endpoint idle. */
+static void report_queue_transmit_next_i(USBDriver *usbp, usbep_t ep) {
+    usb_report_queue_t *queue = report_queues[ep];
+
+    if (queue == NULL || queue->count == 0) {
+        return;
+    }
+
+    queue->in_flight = queue->pending[queue->head];
+    queue->head      = (queue->head + 1) % USB_REPORT_QUEUE_SIZE;
+    queue->count--;
+    usbStartTransmitI(usbp, ep, queue->in_flight.data, queue->in_flight.size);
+}
+
+#ifdef USB_SOF_SYNC_ENABLE
+static void sof_sync_in_complete_i(usbep_t ep);
+#endif
+
+/* Queues a copy of a report, and starts its transfer if the endpoint is idle.
+ * Must be called from a locked state. */
+static void report_queue_push_i(USBDriver *usbp, usbep_t ep, const void *report, size_t size) {
+    usb_report_queue_t *queue = report_queues[ep];
+    uint8_t             slot;
+
+    if (queue->count < USB_REPORT_QUEUE_SIZE) {
+        slot = (queue->head + queue->count) % USB_REPORT_QUEUE_SIZE;
+        queue->count++;
+    } else {
+        /* The host is not polling fast enough, the newest report replaces the last one queued */
+        slot = (queue->head + USB_REPORT_QUEUE_SIZE - 1) % USB_REPORT_QUEUE_SIZE;
+    }
+    queue->pending[slot].size = size;
+    memcpy(queue->pending[slot].data, report, size);
+
+    if (!usbGetTransmitStatusI(usbp, ep)) {
+        report_queue_transmit_next_i(usbp, ep);
+    }
+}
+
+/* IN notification callback of the report endpoints, swaps in the next report */
+static void report_in_cb(USBDriver *usbp, usbep_t ep) {
+    osalSysLockFromISR();
+#ifdef USB_SOF_SYNC_ENABLE
+    sof_sync_in_complete_i(ep);
+#endif
+    if (usbGetDriverStateI(usbp) == USB_ACTIVE && !usbGetTransmitStatusI(usbp, ep)) {
+        report_queue_transmit_next_i(usbp, ep);
+    }
+    osalSysUnlockFromISR();
 }
 
+#ifdef USB_SOF_SYNC_ENABLE
+/* ---------------------------------------------------------
+ *               Start of frame synchronization
+ * ---------------------------------------------------------
+ */
+
+/* The scan loop is started once per frame, timed so that the keyboard report
+ * is queued USB_SOF_SYNC_MARGIN_US before the next start of frame, and picked
+ * up by the first IN token of that frame. */
+
+enum {
+    SOF_SYNC_EDGE_IDLE,
+    SOF_SYNC_EDGE_SCANNED,
+    SOF_SYNC_EDGE_QUEUED,
+};
+
+static struct {
+    systime_t sof_time;
+    systime_t loop_start;
+    uint16_t  loop_us;
+    uint8_t   edge_state;
+    usbep_t   edge_ep;
+    uint8_t   edge_transfers;
+    systime_t edge_time;
+    uint32_t  samples;
+    uint32_t  total_us;
+    uint16_t  max_us;
+} sof_sync;
+
+static void sof_sync_sof_i(void) {
+    sof_sync.sof_time = chVTGetSystemTimeX();
+}
+
+static void sof_sync_in_complete_i(usbep_t ep) {
+    if (sof_sync.edge_state != SOF_SYNC_EDGE_QUEUED || ep != sof_sync.edge_ep) {
+        return;
+    }
+    if (sof_sync.edge_transfers > 1) {
+        sof_sync.edge_transfers--;
+        return;
+    }
+
+    uint32_t delay_us = TIME_I2US(chTimeDiffX(sof_sync.edge_time, chVTGetSystemTimeX()));
+    if (sof_sync.total_us > UINT32_MAX - delay_us) {
+        sof_sync.samples  = 0;
+        sof_sync.total_us = 0;
+    }
+    sof_sync.samples++;
+    sof_sync.total_us += delay_us;
+    if (delay_us > sof_sync.max_us) {
+        sof_sync.max_us = delay_us < UINT16_MAX ? delay_us : UINT16_MAX;
+    }
+    sof_sync.edge_state = SOF_SYNC_EDGE_IDLE;
+}
+
+/* Remembers how many transfers have to complete before the report carrying
+ * the last matrix change has been read by the host. */
+static void sof_sync_report_queued(usbep_t ep) {
+    osalSysLock();
+    if (sof_sync.edge_state == SOF_SYNC_EDGE_SCANNED) {
+        uint8_t transfers = report_queues[ep]->count + (usbGetTransmitStatusI(&USB_DRIVER, ep) ? 1 : 0);
+        if (transfers == 0) {
+            /* Disconnected, or already completed */
+            sof_sync.edge_state = SOF_SYNC_EDGE_IDLE;
+        } else {
+            sof_sync.edge_state     = SOF_SYNC_EDGE_QUEUED;
+            sof_sync.edge_ep        = ep;
+            sof_sync.edge_transfers = transfers;
+        }
+    }
+    osalSysUnlock();
+}
+
+void usb_sof_sync_matrix_changed(void) {
+    osalSysLock();
+    if (sof_sync.edge_state == SOF_SYNC_EDGE_IDLE) {
+        sof_sync.edge_state = SOF_SYNC_EDGE_SCANNED;
+        sof_sync.edge_time  = chVTGetSystemTimeX();
+    }
+    osalSysUnlock();
+}
+
+void usb_sof_sync_task(void) {
+    if (USB_DRIVER.state != USB_ACTIVE) {
+        return;
+    }
+
+    osalSysLock();
+    uint32_t since_sof_us = TIME_I2US(chTimeDiffX(sof_sync.sof_time, chVTGetSystemTimeX()));
+    osalSysUnlock();
+
+    /* Frames are not running, eg. the host is about to suspend */
+    if (since_sof_us > 2 * USB_SOF_SYNC_FRAME_US) {
+        sof_sync.loop_start = chVTGetSystemTimeX();
+        return;
+    }
+
+    uint32_t lead_us  = sof_sync.loop_us + USB_SOF_SYNC_MARGIN_US;
+    uint32_t start_us = lead_us < USB_SOF_SYNC_FRAME_US ? USB_SOF_SYNC_FRAME_US - lead_us : 0;
+    uint32_t wait_us;
+
+    since_sof_us %= USB_SOF_SYNC_FRAME_US;
+    if (since_sof_us <= start_us) {
+        wait_us = start_us - since_sof_us;
+    } else {
+        /* Too late for this frame, the report would miss its IN token anyway */
+        wait_us = USB_SOF_SYNC_FRAME_US - since_sof_us + start_us;
+    }
+    if (wait_us > 0) {
+        chThdSleepMicroseconds(wait_us);
+    }
+
+    sof_sync.loop_start = chVTGetSystemTimeX();
+}
+
+void usb_sof_sync_loop_end(void) {
+    /* The change did not produce a keyboard report, eg. a layer key */
+    osalSysLock();
+    if (sof_sync.edge_state == SOF_SYNC_EDGE_SCANNED) {
+        sof_sync.edge_state = SOF_SYNC_EDGE_IDLE;
+    }
+    osalSysUnlock();
+
+    uint32_t loop_us = TIME_I2US(chTimeDiffX(sof_sync.loop_start, chVTGetSystemTimeX()));
+    if (loop_us > UINT16_MAX) {
+        return;
+    }
+
+    /* Follow slower scans immediately, faster ones gradually */
+    if (loop_us > sof_sync.loop_us) {
+        sof_sync.loop_us = loop_us;
+    } else {
+        sof_sync.loop_us -= (sof_sync.loop_us - loop_us) / 16;
+    }
+}
+
+usb_sof_sync_stats_t usb_sof_sync_get_stats(void) {
+    usb_sof_sync_stats_t stats;
+
+    osalSysLock();
+    stats.samples    = sof_sync.samples;
+    stats.average_us = sof_sync.samples ? sof_sync.total_us / sof_sync.samples : 0;
+    stats.max_us     = sof_sync.max_us;
+    stats.loop_us    = sof_sync.loop_us;
+    osalSysUnlock();
+
+    return stats;
+}
+
+void usb_sof_sync_reset_stats(void) {
+    osalSysLock();
+    sof_sync.samples  = 0;
+    sof_sync.total_us = 0;
+    sof_sync.max_us   = 0;
+    osalSysUnlock();
+}
+#endif
+
 #ifndef KEYBOARD_SHARED_EP
 /* keyboard endpoint state structure */
 static USBInEndpointState kbd_ep_state;
@@ -146,7 +434,7 @@ static USBInEndpointState kbd_ep_state;
 static const USBEndpointConfig kbd_ep_config = {
     USB_EP_MODE_TYPE_INTR,  /* Interrupt EP */
     NULL,                   /* SETUP packet notification callback */
-    dummy_usb_cb,           /* IN notification callback */
+    report_in_cb,           /* IN notification callback */
     NULL,                   /* OUT notification callback */
     KEYBOARD_EPSIZE,        /* IN maximum packet size */
     0,                      /* OUT maximum packet size */
@@ -164,7 +452,7 @@ static USBInEndpointState mouse_ep_state;
 static const USBEndpointConfig mouse_ep_config = {
     USB_EP_MODE_TYPE_INTR,  /* Interrupt EP */
     NULL,                   /* SETUP packet notification callback */
-    dummy_usb_cb,           /* IN notification callback */
+    report_in_cb,           /* IN notification callback */
     NULL,                   /* OUT notification callback */
     MOUSE_EPSIZE,           /* IN maximum packet size */
     0,                      /* OUT maximum packet size */
@@ -182,7 +470,7 @@ static USBInEndpointState shared_ep_state;
 static const USBEndpointConfig shared_ep_config = {
     USB_EP_MODE_TYPE_INTR,  /* Interrupt EP */
     NULL,                   /* SETUP packet notification callback */
-    dummy_usb_cb,           /* IN notification callback */
+    report_in_cb,           /* IN notification callback */
     NULL,                   /* OUT notification callback */
     SHARED_EPSIZE,          /* IN maximum packet size */
     0,                      /* OUT maximum packet size */
@@ -200,7 +488,7 @@ static USBInEndpointState joystick_ep_state;
 static const USBEndpointConfig joystick_ep_config = {
     USB_EP_MODE_TYPE_INTR,  /* Interrupt EP */
     NULL,                   /* SETUP packet notification callback */
-    dummy_usb_cb,           /* IN notification callback */
+    report_in_cb,           /* IN notification callback */
     NULL,                   /* OUT notification callback */
     JOYSTICK_EPSIZE,        /* IN maximum packet size */
     0,                      /* OUT maximum packet size */
@@ -218,7 +506,7 @@ static USBInEndpointState digitizer_ep_state;
 static const USBEndpointConfig digitizer_ep_config = {
     USB_EP_MODE_TYPE_INTR,  /* Interrupt EP */
     NULL,                   /* SETUP packet notification callback */
-    dummy_usb_cb,           /* IN notification callback */
+    report_in_cb,           /* IN notification callback */
     NULL,                   /* OUT notification callback */
     DIGITIZER_EPSIZE,       /* IN maximum packet size */
     0,                      /* OUT maximum packet size */
@@ -506,6 +794,8 @@ static void usb_event_cb(USBDriver *usbp, usbevent_t event) {
 
         case USB_EVENT_CONFIGURED:
             osalSysLockFromISR();
+            /* Reports queued for the previous configuration are stale. */
+            report_queues_clear_i();
             /* Enable the endpoints specified into the configuration. */
 #ifndef KEYBOARD_SHARED_EP
             usbInitEndpointI(usbp, KEYBOARD_IN_EPNUM, &kbd_ep_config);
@@ -748,6 +1038,9 @@ static bool usb_request_hook_cb(USBDriver *usbp) {
 /* Start-of-frame callback */
 static void usb_sof_cb(USBDriver *usbp) {
     osalSysLockFromISR();
+#ifdef USB_SOF_SYNC_ENABLE
+    sof_sync_sof_i();
+#endif
     for (int i = 0; i < NUM_USB_DRIVERS; i++) {
         qmkusbSOFHookI(&drivers.array[i].driver);
     }
@@ -842,8 +1135,9 @@ static void keyboard_idle_timer_cb(struct ch_virtual_timer *timer, void *arg) {
     if (keyboard_idle && keyboard_protocol) {
 #endif /* NKRO_ENABLE */
         /* TODO: are we sure we want the KBD_ENDPOINT? */
-        if (!usbGetTransmitStatusI(usbp, KEYBOARD_IN_EPNUM)) {
-            usbStartTransmitI(usbp, KEYBOARD_IN_EPNUM, (uint8_t *)&keyboard_report_sent, KEYBOARD_EPSIZE);
+        /* Only repeat the last report on an idle endpoint, queued reports are newer and go out anyway */
+        if (!usbGetTransmitStatusI(usbp, KEYBOARD_IN_EPNUM) && report_queues[KEYBOARD_IN_EPNUM]->count == 0) {
+            report_queue_push_i(usbp, KEYBOARD_IN_EPNUM, &keyboard_report_sent, KEYBOARD_EPSIZE);
         }
         /* rearm the timer */
         chVTSetI(&keyboard_idle_timer, 4 * TIME_MS2I(keyboard_idle), keyboard_idle_timer_cb, (void *)usbp);
@@ -866,17 +1160,7 @@ void send_report(uint8_t endpoint, void *report, size_t size) {
         return;
     }
 
-    if (usbGetTransmitStatusI(&USB_DRIVER, endpoint)) {
-        /* Need to either suspend, or loop and call unlock/lock during
-         * every iteration - otherwise the system will remain locked,
-         * no interrupts served, so USB not going through as well.
-         * Note: for suspend, need USB_USE_WAIT == TRUE in halconf.h */
-        if (osalThreadSuspendTimeoutS(&(&USB_DRIVER)->epc[endpoint]->in_state->thread, TIME_MS2I(10)) == MSG_TIMEOUT) {
-            osalSysUnlock();
-            return;
-        }
-    }
-    usbStartTransmitI(&USB_DRIVER, endpoint, report, size);
+    report_queue_push_i(&USB_DRIVER, endpoint, report, size);
     osalSysUnlock();
 }
 
@@ -900,6 +1184,10 @@ void send_keyboard(report_keyboard_t *report) {
         send_report(ep, report, size);
     }
 
+#ifdef USB_SOF_SYNC_ENABLE
+    sof_sync_report_queued(ep);
+#endif
+
     keyboard_report_sent = *report;
 }
 
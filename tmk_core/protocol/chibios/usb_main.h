@@ -61,3 +61,44 @@ int8_t sendchar(uint8_t c);
 void console_flush_output(void);
 
 #endif /* CONSOLE_ENABLE */
+
+/* ---------------------------------
+ * Start of frame synchronized scans
+ * ---------------------------------
+ */
+
+#ifdef USB_SOF_SYNC_ENABLE
+
+/* Length of a USB frame, 125 for high speed microframes */
+#    ifndef USB_SOF_SYNC_FRAME_US
+#        define USB_SOF_SYNC_FRAME_US 1000
+#    endif
+
+/* Time left between queueing the report and the next start of frame */
+#    ifndef USB_SOF_SYNC_MARGIN_US
+#        define USB_SOF_SYNC_MARGIN_US 100
+#    endif
+
+typedef struct {
+    uint32_t samples;    /* Matrix changes delivered to the host */
+    uint16_t average_us; /* Average time from matrix change to IN token */
+    uint16_t max_us;     /* Longest time from matrix change to IN token */
+    uint16_t loop_us;    /* Estimated time from scan start to report */
+} usb_sof_sync_stats_t;
+
+/* Waits until the scan has to start to make the next frame */
+void usb_sof_sync_task(void);
+
+/* Marks the end of the part of the loop producing the reports */
+void usb_sof_sync_loop_end(void);
+
+/* Records the time of a debounced matrix change */
+void usb_sof_sync_matrix_changed(void);
+
+/* Matrix change to IN token statistics */
+usb_sof_sync_stats_t usb_sof_sync_get_stats(void);
+
+/* Restarts the statistics */
+void usb_sof_sync_reset_stats(void);
+
+#endif /* USB_SOF_SYNC_ENABLE */